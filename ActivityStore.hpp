@@ -0,0 +1,300 @@
+#ifndef ACTIVITYSTORE_HPP__
+#define ACTIVITYSTORE_HPP__
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QSet>
+
+// A map of activity, by call or by offset, that can be kept to a bounded
+// size, and that keeps track of the keys whose values have changed, so
+// that a display of the activity can be refreshed for only what's changed
+// since it last was.
+//
+// The map itself is private; lookups are read-only, and every write goes
+// through one of the mutators here, each of which notes the keys that it
+// changes. Replacing or clearing the map wholesale changes every key.
+//
+// Alongside the map, a time-ordered index of when each key was last active
+// lets the oldest be found and evicted without a scan of the map, so that
+// a station left running for weeks holds what's recent rather than all
+// it's ever heard. The index is lazy; each write notes the key as of its
+// stamp, without first finding and removing its previous note. Notes that
+// are out of date are discarded as eviction comes to them, and the index
+// is rebuilt from the map whenever it grows to twice the size of the map,
+// or whenever the map is replaced wholesale. Keys whose activity has no
+// valid timestamp are never noted, and thus never evicted.
+
+template <typename Key,
+          typename Value>
+class ActivityStore
+{
+public:
+
+  using Map            = QMap<Key, Value>;
+  using const_iterator = typename Map::const_iterator;
+  using Stamp          = std::function<QDateTime(Value const &)>;
+
+  // Retention limits; zero for either means no limit.
+
+  struct Limits
+  {
+    qsizetype entries = 0;    // most keys retained
+    qint64    seconds = 0;    // longest time a key is retained while idle
+  };
+
+  // Constructor; the stamp function supplies the time of the most recent
+  // activity in a value.
+
+  explicit ActivityStore(Stamp stamp)
+    : m_stamp(std::move(stamp))
+  {}
+
+  // Read-only access, as for a QMap.
+
+  Map const & map()                         const { return m_map;                  }
+  qsizetype   size()                        const { return m_map.size();           }
+  bool        isEmpty()                     const { return m_map.isEmpty();        }
+  bool        contains(Key const & key)     const { return m_map.contains(key);    }
+  QList<Key>  keys()                        const { return m_map.keys();           }
+  QList<Value> values()                     const { return m_map.values();         }
+  auto        asKeyValueRange()             const { return m_map.asKeyValueRange(); }
+
+  Value
+  value(Key   const & key,
+        Value const & defaultValue = Value()) const
+  {
+    return m_map.value(key, defaultValue);
+  }
+
+  const_iterator begin()                      const { return m_map.cbegin();         }
+  const_iterator end()                        const { return m_map.cend();           }
+  const_iterator cbegin()                     const { return m_map.cbegin();         }
+  const_iterator cend()                       const { return m_map.cend();           }
+  const_iterator constFind(Key const & key)   const { return m_map.constFind(key);   }
+  const_iterator lowerBound(Key const & key)  const { return m_map.lowerBound(key);  }
+
+  // Set the value of a key.
+
+  void
+  set(Key const & key,
+      Value       value)
+  {
+    auto const it = m_map.insert(key, std::move(value));
+    m_changed.insert(key);
+    note(key, it.value());
+  }
+
+  // Update the value of a key in place, through a function called with a
+  // reference to it; a key that's not present is added, with a default
+  // value, first.
+
+  template <typename Update>
+  void
+  update(Key const & key,
+         Update   && change)
+  {
+    auto & value = m_map[key];
+    change(value);
+    m_changed.insert(key);
+    note(key, value);
+  }
+
+  // Update every value in place; that changes every key.
+
+  template <typename Update>
+  void
+  updateAll(Update && change)
+  {
+    for (auto & value : m_map) change(value);
+    m_replaced = true;
+    reindex();
+  }
+
+  // Remove a key, or take its value out, if it's present; the index will
+  // discard its note when eviction comes to it.
+
+  void
+  remove(Key const & key)
+  {
+    if (m_map.remove(key)) m_changed.insert(key);
+  }
+
+  Value
+  take(Key const & key)
+  {
+    m_changed.insert(key);
+    return m_map.take(key);
+  }
+
+  // Replace the map as a whole, e.g., on a change of band, or clear it.
+
+  void
+  replace(Map map)
+  {
+    m_map      = std::move(map);
+    m_replaced = true;
+    reindex();
+  }
+
+  void
+  clear()
+  {
+    m_map.clear();
+    m_index.clear();
+    m_replaced = true;
+  }
+
+  // Note that something outside the map that a display of the key depends
+  // on has changed.
+
+  void touch(Key const & key) { m_changed.insert(key); }
+
+  // Take the keys that have changed since they were last taken. Returns
+  // false if the map has since been replaced or cleared wholesale, i.e.,
+  // if every key has changed; the keys taken are then beside the point.
+
+  bool
+  takeChanged(QSet<Key> & keys)
+  {
+    keys = std::exchange(m_changed, {});
+    return !std::exchange(m_replaced, false);
+  }
+
+  // Accessors and manipulators for the retention limits.
+
+  Limits limits()                    const { return m_limits;   }
+  void   setLimits(Limits const limits)    { m_limits = limits; }
+
+  // Evict the least recently active keys, oldest first, for as long as
+  // we're over the entry limit, and then those that have been idle for
+  // longer than the age limit as of the time provided. Keys for which
+  // the keep predicate, called with the key and value, returns true are
+  // retained regardless. Returns the keys evicted, which are changed.
+
+  template <typename Keep>
+  QList<Key>
+  evict(QDateTime const & now,
+        Keep           && keep)
+  {
+    auto const horizon = m_limits.seconds
+                       ? now.toMSecsSinceEpoch() - m_limits.seconds * 1000
+                       : std::numeric_limits<qint64>::min();
+
+    QList<Key>                          evicted;
+    std::vector<std::pair<qint64, Key>> kept;
+
+    while (!m_index.empty())
+    {
+      auto const oldest = m_index.begin();
+      auto const over   = m_limits.entries && m_map.size() > m_limits.entries;
+
+      if (!over && oldest->first >= horizon) break;
+
+      auto const [when, key] = *oldest;
+      m_index.erase(oldest);
+
+      // A key that's since been removed has nothing to evict; a key that's
+      // since been active, or whose stamp has otherwise changed, is noted
+      // again as of its stamp, if it's got one.
+
+      auto const it = m_map.constFind(key);
+
+      if (it == m_map.cend()) continue;
+
+      if (auto const stamp = m_stamp(it.value()); !stamp.isValid() ||
+                                                   stamp.toMSecsSinceEpoch() != when)
+      {
+        if (stamp.isValid()) m_index.emplace(stamp.toMSecsSinceEpoch(), key);
+        continue;
+      }
+
+      if (keep(key, it.value()))
+      {
+        kept.emplace_back(when, key);
+        continue;
+      }
+
+      m_map.remove(key);
+      m_changed.insert(key);
+      evicted.append(key);
+    }
+
+    for (auto const & note : kept) m_index.insert(note);
+
+    return evicted;
+  }
+
+  // Approximate memory in use, in bytes; that of the map and index nodes,
+  // plus, if a function to determine it is supplied, that held by each of
+  // the values, e.g., the contents of strings and lists.
+
+  std::size_t
+  memory(std::function<std::size_t(Value const &)> const & held = {}) const
+  {
+    constexpr std::size_t NODE = 4 * sizeof(void *);
+
+    std::size_t bytes = static_cast<std::size_t>(m_map.size()) * (NODE + sizeof(Key) + sizeof(Value))
+                      + m_index.size()                         * (NODE + sizeof(qint64) + sizeof(Key));
+
+    if (held)
+    {
+      for (auto const & value : m_map) bytes += held(value);
+    }
+
+    return bytes;
+  }
+
+private:
+
+  // Notes allowed over the size of the map before we'll consider the
+  // index to be bloated; saves rebuilding a small one over and over.
+
+  static constexpr std::size_t SLACK = 64;
+
+  // Note that the key has been active as of the stamp of its value.
+
+  void
+  note(Key   const & key,
+       Value const & value)
+  {
+    auto const when = m_stamp(value);
+
+    if (!when.isValid()) return;
+
+    m_index.emplace(when.toMSecsSinceEpoch(), key);
+
+    if (m_index.size() > 2 * static_cast<std::size_t>(m_map.size()) + SLACK) reindex();
+  }
+
+  // Rebuild the index from the map.
+
+  void
+  reindex()
+  {
+    m_index.clear();
+
+    for (auto it = m_map.cbegin(); it != m_map.cend(); ++it)
+    {
+      if (auto const stamp = m_stamp(it.value()); stamp.isValid())
+      {
+        m_index.emplace(stamp.toMSecsSinceEpoch(), it.key());
+      }
+    }
+  }
+
+  Map                         m_map;
+  QSet<Key>                   m_changed;
+  bool                        m_replaced = true;
+  Stamp                       m_stamp;
+  Limits                      m_limits;
+  std::multimap<qint64, Key>  m_index;
+};
+
+#endif
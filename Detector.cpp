@@ -56,7 +56,7 @@ Detector::Detector(unsigned  frameRate,
   : AudioDevice (parent)
   , m_frameRate (frameRate)
   , m_period    (periodLengthInSeconds)
-  , m_filter    (LOWPASS)
+  , m_filter    (LOWPASS, MaxBufferSize)
 {
   clear();
 }
@@ -109,19 +109,11 @@ Detector::resetBufferPosition()
 
   qCDebug(detector_js8) << "advancing detector buffer from" << prevKin << "to" << dec_data.params.kin << "delta" << delta;
 
-  // rotate buffer moving the contents that were at prevKin to the new kin position
-  if (delta < 0)
-  {
-    std::rotate(std::begin(dec_data.d2),
-                std::begin(dec_data.d2) - delta,
-                std::end  (dec_data.d2));
-  }
-  else
-  {
-    std::rotate(std::rbegin(dec_data.d2),
-                std::rbegin(dec_data.d2) + delta,
-                std::rend  (dec_data.d2));
-  }
+  // The contents that were at prevKin must now be found at the new kin
+  // position; rather than rotating the whole buffer, which is a sizable
+  // memory move to make on the audio thread, move the ring's origin.
+
+  dec_data.params.koff = js8_ring_index(-delta, dec_data.params.koff);
 }
 
 void
@@ -181,10 +173,16 @@ Detector::writeData(char const * const data,
       if (dec_data.params.kin >= 0 &&
           dec_data.params.kin < static_cast<int>(JS8_NTMAX * 12000 - m_samplesPerFFT))
       {
-        for (std::size_t i = 0; i < m_samplesPerFFT; ++i)
-        {
-          dec_data.d2[dec_data.params.kin++] = m_filter.downSample(&m_buffer[i * Filter::NDOWN]);
-        }
+        // Downsample straight into the ring, in two parts if the block
+        // runs off the end of it.
+
+        auto const at    = js8_ring_index(dec_data.params.kin, dec_data.params.koff);
+        auto const first = qMin(m_samplesPerFFT, static_cast<std::size_t>(JS8_RX_SAMPLE_SIZE - at));
+
+        m_filter.downSample(m_buffer.data(),                         first,                   dec_data.d2 + at);
+        m_filter.downSample(m_buffer.data() + first * Filter::NDOWN, m_samplesPerFFT - first, dec_data.d2);
+
+        dec_data.params.kin += m_samplesPerFFT;
       }
       Q_EMIT framesWritten (dec_data.params.kin);
       m_bufferPos = 0;
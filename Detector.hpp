@@ -14,7 +14,7 @@ class Detector : public AudioDevice
   Q_OBJECT;
 
   // We downsample the input data from 48kHz to 12kHz through this
-  // lowpass FIR filter.
+  // lowpass FIR filter, a block at a time.
 
   class Filter final
   {
@@ -22,47 +22,91 @@ class Detector : public AudioDevice
 
     // Amount we're going to downsample; a factor of 4, i.e., 48kHz to
     // 12kHz, and number of taps in the FIR lowpass filter we're going
-    // to use for the downsample process. These together result in the
-    // amount to shift data in the FIR filter each time we input a new
-    // sample.
+    // to use for the downsample process.
 
     static constexpr std::size_t NDOWN = 48 / 12;
     static constexpr std::size_t NTAPS = 49;
-    static constexpr std::size_t SHIFT = NTAPS - NDOWN;
 
-    // Our FIR is constructed of a pair of Eigen vectors, each NTAPS in
-    // size. Loading in a sample consists of mapping it to a read-only
-    // view of an Eigen vector, NDOWN in size.
+    // The filter is run in polyphase form; each of the NDOWN phases of
+    // the input, i.e., every NDOWN'th sample, gets a subfilter of every
+    // NDOWN'th tap, NPHASE of them, the taps zero-padded at the front to
+    // make them come out even. Every subfilter needs HISTORY samples from
+    // the previous block in front of the current one.
 
-    using Vector =            Eigen::Vector<float, NTAPS>;
-    using Sample = Eigen::Map<Eigen::Vector<short, NDOWN> const>;
+    static constexpr std::size_t NPHASE  = (NTAPS + NDOWN - 1) / NDOWN;
+    static constexpr std::size_t PAD     = NPHASE * NDOWN - NTAPS;
+    static constexpr std::size_t HISTORY = NPHASE - 1;
 
-    // Constructor; we require an array of lowpass FIR coefficients,
-    // equal in size to the number of taps.
+    // Phases are stored one per column, each column a linear run of the
+    // history followed by the current block, so that every tap is one
+    // multiply-add across a contiguous span of the block.
+
+    using Taps   = Eigen::Array<float, NPHASE,         NDOWN>;
+    using Phases = Eigen::Array<float, Eigen::Dynamic, NDOWN>;
+    using Output = Eigen::Array<float, Eigen::Dynamic, 1>;
+    using Sample = short;
 
-    explicit Filter(std::array<Vector::value_type, NTAPS> const & lowpass)
-    : m_w(lowpass.data())
-    , m_t(Vector::Zero())
-    {}
+    // Constructor; we require an array of lowpass FIR coefficients,
+    // equal in size to the number of taps, and the largest number of
+    // output samples we'll be asked for at once.
 
-    // Shift existing data in the lowpass FIR to make room for a new
-    // sample and load it in; downsample through the filter.
+    Filter(std::array<float, NTAPS> const & lowpass,
+           std::size_t                      maxFrames)
+    : m_x(Phases::Zero(HISTORY + maxFrames, NDOWN))
+    , m_y(maxFrames)
+    {
+      for (std::size_t j = 0; j < NPHASE * NDOWN; ++j)
+      {
+        m_h(j / NDOWN, j % NDOWN) = j < PAD ? 0.0f : lowpass[j - PAD];
+      }
+    }
 
-    auto
-    downSample(Sample::value_type const * const data)
+    // Downsample frames of NDOWN input samples each, producing one output
+    // sample per frame. Filter state carries over between calls, so that
+    // a block can be split across calls at any frame, e.g., to write into
+    // both ends of a ring buffer. Results are those of the direct form of
+    // the filter, aside from float rounding in the sums, which can move
+    // an output by 1 at the most.
+
+    void
+    downSample(Sample const * const data,
+               std::size_t    const frames,
+               Sample       * const out)
     {
-      m_t.head(SHIFT) = m_t.segment(NDOWN, SHIFT);
-      m_t.tail(NDOWN) = Sample(data).cast<Vector::value_type>();
+      using Input = Eigen::Map<Eigen::Array<Sample, Eigen::Dynamic, 1> const, 0, Eigen::InnerStride<NDOWN>>;
+
+      for (std::size_t p = 0; p < NDOWN; ++p)
+      {
+        m_x.col(p).segment(HISTORY, frames) = Input(data + p, frames).cast<float>();
+      }
+
+      auto y = m_y.head(frames);
+
+      y.setZero();
+
+      for (std::size_t p = 0; p < NDOWN; ++p)
+      {
+        for (std::size_t k = 0; k < NPHASE; ++k)
+        {
+          y += m_h(k, p) * m_x.col(p).segment(k, frames);
+        }
+      }
+
+      Eigen::Map<Eigen::Array<Sample, Eigen::Dynamic, 1>>(out, frames) = y.round().cast<Sample>();
 
-      return static_cast<Sample::value_type>(std::round(m_w.dot(m_t)));
+      for (std::size_t p = 0; p < NDOWN; ++p)
+      {
+        m_x.col(p).head(HISTORY) = m_x.col(p).segment(frames, HISTORY).eval();
+      }
     }
 
   private:
 
     // Data members
 
-    Eigen::Map<Vector const> m_w;
-    Vector                   m_t;
+    Taps   m_h;
+    Phases m_x;
+    Output m_y;
   };
 
   // Size of a maximally-sized buffer.
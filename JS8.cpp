@@ -647,6 +647,142 @@ namespace
 
         using Map = std::unordered_map<Decode, int, Hash>;
     };
+
+    // Input to a decoding pass; the decode parameters, and the windows of
+    // the capture ring that the scheduled submodes will decode, copied out
+    // of the ring as a set of spans. Windows of different submodes overlap
+    // for the most part, so overlapping windows share a span, and the copy
+    // is that of the union of the windows rather than the whole ring.
+
+    class Input
+    {
+    public:
+
+        using Params = decltype(dec_data.params);
+
+        // Window parameters of a submode; its bit in the nsubmodes set,
+        // and its starting position and number of frames. The order here
+        // is the order in which the decoder will run the submodes.
+
+        struct Window
+        {
+            int            mode;
+            int Params::*  kpos;
+            int Params::*  ksz;
+        };
+
+        static constexpr std::array<Window, 5> WINDOWS =
+        {{
+            {1 << 4, &Params::kposI, &Params::kszI},
+            {1 << 3, &Params::kposE, &Params::kszE},
+            {1 << 2, &Params::kposC, &Params::kszC},
+            {1 << 1, &Params::kposB, &Params::kszB},
+            {1 << 0, &Params::kposA, &Params::kszA}
+        }};
+
+    private:
+
+        // A span of frames in the ring, [lo, hi) relative to the period,
+        // copied to samples starting at the index at.
+
+        struct Span
+        {
+            int         lo;
+            int         hi;
+            std::size_t at;
+        };
+
+        std::vector<Span>         m_spans;
+        std::vector<std::int16_t> m_samples;
+
+    public:
+
+        Params params = {};
+
+        // Load the parameters and the windows of the scheduled submodes
+        // from the capture data; the caller must hold the detector lock.
+
+        void
+        load(struct dec_data const & data)
+        {
+            params = data.params;
+
+            std::array<std::pair<int, int>, WINDOWS.size()> wanted;
+            std::size_t                                     count = 0;
+
+            for (auto const & window : WINDOWS)
+            {
+                if ((params.nsubmodes & window.mode) != window.mode) continue;
+
+                auto const lo = std::max(0, params.*window.kpos);
+                auto const sz = std::max(0, params.*window.ksz);
+
+                if (sz) wanted[count++] = {lo, lo + sz};
+            }
+
+            std::sort(wanted.begin(), wanted.begin() + count);
+
+            m_spans.clear();
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (!m_spans.empty() && wanted[i].first <= m_spans.back().hi)
+                {
+                    m_spans.back().hi = std::max(m_spans.back().hi, wanted[i].second);
+                }
+                else
+                {
+                    m_spans.push_back({wanted[i].first, wanted[i].second, 0});
+                }
+            }
+
+            std::size_t size = 0;
+
+            for (auto & span : m_spans)
+            {
+                span.at = size;
+                size   += span.hi - span.lo;
+            }
+
+            m_samples.resize(size);
+
+            // Copy each span out of the ring, in two parts if it wraps.
+
+            for (auto const & span : m_spans)
+            {
+                auto       to   = m_samples.begin() + span.at;
+                auto       from = span.lo;
+                auto const end  = span.hi;
+
+                while (from < end)
+                {
+                    auto const at = js8_ring_index(from % JS8_RX_SAMPLE_SIZE, params.koff);
+                    auto const n  = std::min(end - from, JS8_RX_SAMPLE_SIZE - at);
+
+                    to    = std::copy_n(std::begin(data.d2) + at, n, to);
+                    from += n;
+                }
+            }
+        }
+
+        // Samples for the frames [pos, pos + sz) of the period, if they
+        // were loaded, null otherwise.
+
+        std::int16_t const *
+        window(int const pos,
+               int const sz) const
+        {
+            for (auto const & span : m_spans)
+            {
+                if (pos >= span.lo && pos + sz <= span.hi)
+                {
+                    return m_samples.data() + span.at + (pos - span.lo);
+                }
+            }
+
+            return nullptr;
+        }
+    };
 }
 
 /******************************************************************************/
@@ -2249,10 +2385,10 @@ namespace
         // Decode entry point.
 
         std::size_t
-        operator()(struct dec_data const & data,
-                   int             const   kpos,
-                   int             const   ksz,
-                   JS8::Event::Emitter     emitEvent)
+        operator()(Input       const & data,
+                   int         const   kpos,
+                   int         const   ksz,
+                   JS8::Event::Emitter emitEvent)
         {
             // Copy the relevant frames for decoding
 
@@ -2263,33 +2399,14 @@ namespace
 
             if (data.params.syncStats) emitEvent(JS8::Event::SyncStart{pos, sz});
 
-            auto const ddCopy = [](auto const begin,
-                                   auto const end,
-                                   auto const to)
+            dd.fill(0.0f);
+
+            if (auto const window = data.window(pos, sz))
             {
-                std::transform(begin, end, to, [](auto const value)
+                std::transform(window, window + sz, dd.begin(), [](auto const value)
                 {
                     return static_cast<float>(value);
                 });
-            };
-
-            dd.fill(0.0f);
-
-            if ((JS8_RX_SAMPLE_SIZE - pos) < sz)
-            {
-                // Wrap case; split into two parts.
-
-                int const firstsize  = JS8_RX_SAMPLE_SIZE - pos;
-                int const secondsize = sz - firstsize;
-
-                ddCopy(std::begin(data.d2) + pos, std::begin(data.d2) + pos + firstsize,  dd.begin());
-                ddCopy(std::begin(data.d2),       std::begin(data.d2) +       secondsize, dd.begin() + firstsize);
-            }
-            else
-            {
-                // Non-wrapping case; copy directly.
-
-                ddCopy(std::begin(data.d2) + pos, std::begin(data.d2) + pos + sz, dd.begin());
             }
 
             Decode::Map decodes;
@@ -2412,13 +2529,6 @@ namespace JS8
 
         class Impl
         {
-            // To avoid data races, decode data is referenced here but is
-            // actually located in the Worker that instantiates us, as it
-            // must be possible to copy data for us before we're ready to
-            // process it.
-
-            struct dec_data & m_data;
-
             // Mode-specific decode strategy; we'll instantiate one of
             // these for each of the 5 modes; this class is an aggregate
             // of the 5 modes.
@@ -2431,68 +2541,53 @@ namespace JS8
                     DecodeMode<ModeC>,
                     DecodeMode<ModeE>,
                     DecodeMode<ModeI>
-                >     decode;
-                int   mode;
-                int & kpos;
-                int & ksz;
+                >             decode;
+                Input::Window window;
 
                 template <typename DecodeModeType>
                 DecodeEntry(std::in_place_type_t<DecodeModeType>,
-                            int   mode,
-                            int & kpos,
-                            int & ksz)
+                            Input::Window window)
                     : decode(std::in_place_type<DecodeModeType>)
-                    , mode  (mode)
-                    , kpos  (kpos)
-                    , ksz   (ksz)
+                    , window(window)
                     {}
             };
 
             // Since a strategy can be neither moved nor copied, we must
             // instantiate them in-place. Note that with the advent of the
             // multi-decoder, mode identifiers became a bitset instead of
-            // integral values. The order defined here is the order that
-            // the decode loop will run in; we're matching the Fortran
-            // version here in terms of faster modes first.
+            // integral values. The order, that of the input windows, is
+            // the order that the decode loop will run in; we're matching
+            // the Fortran version here in terms of faster modes first.
 
             template <typename ModeType>
-            DecodeEntry makeDecodeEntry(int   shift,
-                                        int & kpos,
-                                        int & ksz)
+            static DecodeEntry makeDecodeEntry(Input::Window window)
             {
                 return DecodeEntry(std::in_place_type<DecodeMode<ModeType>>,
-                                   1 << shift,
-                                   kpos,
-                                   ksz);
+                                   window);
             }
 
             std::array<DecodeEntry, 5> m_decodes =
             {{
-                makeDecodeEntry<ModeI>(4, m_data.params.kposI, m_data.params.kszI),
-                makeDecodeEntry<ModeE>(3, m_data.params.kposE, m_data.params.kszE),
-                makeDecodeEntry<ModeC>(2, m_data.params.kposC, m_data.params.kszC),
-                makeDecodeEntry<ModeB>(1, m_data.params.kposB, m_data.params.kszB),
-                makeDecodeEntry<ModeA>(0, m_data.params.kposA, m_data.params.kszA)
+                makeDecodeEntry<ModeI>(Input::WINDOWS[0]),
+                makeDecodeEntry<ModeE>(Input::WINDOWS[1]),
+                makeDecodeEntry<ModeC>(Input::WINDOWS[2]),
+                makeDecodeEntry<ModeB>(Input::WINDOWS[3]),
+                makeDecodeEntry<ModeA>(Input::WINDOWS[4])
             }};
 
         public:
 
-            // Constructor
-
-            explicit Impl(struct dec_data & data)
-            : m_data(data)
-            {}
-
-            // Execute a decoding pass, using the supplied event emitter to
-            // emit events as they occur.
+            // Execute a decoding pass over the supplied input, using the
+            // supplied event emitter to emit events as they occur.
 
-            void operator()(Event::Emitter emitEvent)
+            void operator()(Input const &  input,
+                            Event::Emitter emitEvent)
             {
                 // The multi-decoder can provide data for multiple modes at
                 // the same time; specific decodes to be performed for this
                 // pass are in the `nsubmodes` bitset.
 
-                auto const  set = m_data.params.nsubmodes;
+                auto const  set = input.params.nsubmodes;
                 std::size_t sum = 0;
 
                 // Let any interested parties know that we've started a run
@@ -2506,12 +2601,12 @@ namespace JS8
 
                 for (auto & entry : m_decodes)
                 {
-                    if ((set & entry.mode) == entry.mode)
+                    if ((set & entry.window.mode) == entry.window.mode)
                     {
                         std::visit([&](auto && decode) {
-                            sum += decode(m_data,
-                                          entry.kpos,
-                                          entry.ksz,
+                            sum += decode(input,
+                                          input.params.*entry.window.kpos,
+                                          input.params.*entry.window.ksz,
                                           emitEvent);
                         }, entry.decode);
                     }
@@ -2524,11 +2619,14 @@ namespace JS8
             }
         };
 
-        // Data members
+        // Data members; decode input is double-buffered, such that the
+        // owning Decoder loads one while we may yet be decoding the other.
+        // The one to decode next is indicated by m_ready.
 
-        QSemaphore      * m_semaphore;
-        std::atomic<bool> m_quit = false;
-        struct dec_data   m_data;
+        QSemaphore             * m_semaphore;
+        std::atomic<bool>        m_quit  = false;
+        std::array<Input, 2>     m_input;
+        std::atomic<std::size_t> m_ready = 0;
 
     public:
 
@@ -2549,12 +2647,18 @@ namespace JS8
             m_quit = true;
         }
 
-        // Called by the owning Decoder to refresh the copy of the
-        // decode data that the Worker implementation references.
+        // Called by the owning Decoder, with the detector lock held, to
+        // load the input buffer we're not using with the parameters and
+        // the scheduled windows of the capture data. Only one decode is
+        // outstanding at a time, so the other buffer is ours until the
+        // semaphore is released.
 
         void copy()
         {
-            m_data = dec_data;
+            auto const next = 1 - m_ready.load(std::memory_order_relaxed);
+
+            m_input[next].load(dec_data);
+            m_ready.store(next, std::memory_order_release);
         };
 
     signals:
@@ -2579,7 +2683,7 @@ namespace JS8
             // can take a while. We only need the implementation while
             // we're running.
 
-            std::unique_ptr<Impl> impl = std::make_unique<Impl>(m_data);
+            std::unique_ptr<Impl> impl = std::make_unique<Impl>();
 
             // Wait until there's something that requires our attention,
             // which is going to either be needing to quit or needing to
@@ -2591,7 +2695,8 @@ namespace JS8
 
                 if (m_quit) break;
 
-                (*impl)([this](Event::Variant const & event)
+                (*impl)(m_input[m_ready.load(std::memory_order_acquire)],
+                        [this](Event::Variant const & event)
                 {
                     emit decodeEvent(event);
                 });
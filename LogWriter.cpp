@@ -0,0 +1,293 @@
+#include "LogWriter.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <QDate>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#if defined (Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "moc_LogWriter.cpp"
+
+/******************************************************************************/
+// Implementation
+/******************************************************************************/
+
+struct LogWriter::Impl
+{
+  using Clock = std::chrono::steady_clock;
+
+  // Lines written and not yet taken by our thread, and requests to it;
+  // the condition is notified whenever any of them change.
+
+  std::mutex              mutex;
+  std::condition_variable condition;
+  std::deque<QString>     lines;
+  qsizetype               dropped = 0;
+  bool                    erase   = false;
+  bool                    stop    = false;
+
+  // Used only by our thread, once started.
+
+  Options options;
+  QFile   file;
+  QDate   date;
+  bool    failed = false;
+
+  // Report an error, if we haven't already since the last success.
+
+  void
+  fail(LogWriter * const writer,
+       QString     const & message)
+  {
+    if (!std::exchange(failed, true)) emit writer->error(message);
+  }
+
+  // Ensure the file is open for append, rotating it first if it's due.
+  // Returns false, having reported the error, if we can't open it.
+
+  bool
+  open(LogWriter * const writer)
+  {
+    auto const today = QDateTime::currentDateTimeUtc().date();
+
+    if (!file.isOpen())
+    {
+      file.setFileName(options.path);
+      if (QFileInfo const info(options.path); info.exists())
+      {
+        date = info.lastModified().toUTC().date();
+      }
+      else
+      {
+        date = today;
+      }
+    }
+
+    if ((options.maxBytes && QFileInfo(options.path).size() >= options.maxBytes) ||
+        (options.daily    && date != today && QFileInfo::exists(options.path)))
+    {
+      rotate();
+    }
+
+    date = today;
+
+    if (!file.isOpen() && !file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append))
+    {
+      fail(writer, LogWriter::tr("Cannot open \"%1\" for append: %2").arg(file.fileName()).arg(file.errorString()));
+      return false;
+    }
+
+    return true;
+  }
+
+  // Close the file and shift it, along with those rotated earlier, along
+  // by one suffix, discarding the oldest.
+
+  void
+  rotate()
+  {
+    file.close();
+
+    auto const name = [this](int const n) { return QString("%1.%2").arg(options.path).arg(n); };
+
+    QFile::remove(name(options.keep));
+
+    for (int n = options.keep - 1; n >= 1; --n)
+    {
+      QFile::rename(name(n), name(n + 1));
+    }
+
+    if (options.keep > 0) QFile::rename(options.path, name(1));
+    else                  QFile::remove(options.path);
+  }
+
+  // Push what's been written out of our buffer and the system's, to the
+  // disk.
+
+  void
+  sync()
+  {
+    if (!file.isOpen()) return;
+
+    file.flush();
+#if defined (Q_OS_WIN)
+    _commit(file.handle());
+#else
+    ::fsync(file.handle());
+#endif
+  }
+};
+
+LogWriter::LogWriter(QObject * parent)
+  : QObject {parent}
+  , m_impl  {std::make_unique<Impl>()}
+{}
+
+LogWriter::~LogWriter()
+{
+  quit();
+}
+
+void
+LogWriter::start(Options           options,
+                 QThread::Priority const priority)
+{
+  if (m_thread) return;
+
+  m_impl->options = std::move(options);
+  m_impl->stop    = false;
+  m_thread.reset(QThread::create([this]() { run(); }));
+  m_thread->start(priority);
+}
+
+void
+LogWriter::quit()
+{
+  if (!m_thread) return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->stop = true;
+  }
+
+  m_impl->condition.notify_one();
+  m_thread->wait();
+  m_thread.reset();
+}
+
+void
+LogWriter::write(QString line)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+
+    if (m_impl->lines.size() >= static_cast<std::size_t>(m_impl->options.capacity))
+    {
+      ++m_impl->dropped;
+      return;
+    }
+
+    m_impl->lines.push_back(std::move(line));
+  }
+
+  m_impl->condition.notify_one();
+}
+
+void
+LogWriter::erase()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+
+    m_impl->lines.clear();
+    m_impl->dropped = 0;
+    m_impl->erase   = true;
+  }
+
+  m_impl->condition.notify_one();
+}
+
+// Runloop for our thread. Having written a batch, we rest for a while to
+// let the next one gather, unless asked to stop or erase, or the queue is
+// filling up; we then wait for lines to arrive, waking up in time to sync
+// the file if we've written to it since we last did.
+
+void
+LogWriter::run()
+{
+  auto const flush = std::chrono::milliseconds(m_impl->options.flushMs);
+  auto const every = std::chrono::milliseconds(m_impl->options.syncMs);
+  auto       dirty = false;
+  auto       due   = Impl::Clock::now();
+
+  while (true)
+  {
+    std::deque<QString> batch;
+    qsizetype           dropped;
+    bool                erase;
+    bool                stop;
+    {
+      std::unique_lock<std::mutex> lock(m_impl->mutex);
+
+      auto const urgent = [this]()
+      {
+        return m_impl->stop  ||
+               m_impl->erase ||
+               m_impl->lines.size() >= static_cast<std::size_t>(m_impl->options.capacity / 2);
+      };
+
+      auto const ready = [this]()
+      {
+        return m_impl->stop  ||
+               m_impl->erase ||
+              !m_impl->lines.empty();
+      };
+
+      if (dirty)
+      {
+        m_impl->condition.wait_for(lock, flush, urgent);
+        m_impl->condition.wait_until(lock, due, ready);
+      }
+      else
+      {
+        m_impl->condition.wait(lock, ready);
+      }
+
+      batch.swap(m_impl->lines);
+      dropped = std::exchange(m_impl->dropped, 0);
+      erase   = std::exchange(m_impl->erase, false);
+      stop    = m_impl->stop;
+    }
+
+    if (erase)
+    {
+      m_impl->file.close();
+      QFile::remove(m_impl->options.path);
+      dirty = false;
+    }
+
+    if ((!batch.empty() || dropped) && m_impl->open(this))
+    {
+      QByteArray data;
+
+      if (dropped) data += QString("*** %1 lines dropped ***\n").arg(dropped).toUtf8();
+
+      for (auto const & line : batch)
+      {
+        data += line.toUtf8();
+        data += '\n';
+      }
+
+      if (m_impl->file.write(data) == data.size() && m_impl->file.flush())
+      {
+        m_impl->failed = false;
+      }
+      else
+      {
+        m_impl->fail(this, tr("Cannot write to \"%1\": %2").arg(m_impl->file.fileName()).arg(m_impl->file.errorString()));
+      }
+
+      if (!dirty) due = Impl::Clock::now() + every;
+      dirty = true;
+    }
+
+    if (stop || (dirty && Impl::Clock::now() >= due))
+    {
+      m_impl->sync();
+      dirty = false;
+    }
+
+    if (stop) break;
+  }
+
+  m_impl->file.close();
+}
+
+/******************************************************************************/
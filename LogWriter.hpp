@@ -0,0 +1,70 @@
+#ifndef LOGWRITER_HPP__
+#define LOGWRITER_HPP__
+
+#include <memory>
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+// Appends lines to a text log file, e.g., ALL.TXT, on a thread of its own,
+// such that the thread writing the lines never waits on the disk. Lines
+// go into a bounded queue; the thread takes them out in batches, writes
+// each batch with the file held open, and syncs the file to disk now and
+// then rather than after every line. Should lines arrive faster than the
+// disk will take them, those that don't fit in the queue are dropped, and
+// a count of them written in their place.
+//
+// The file can be rotated when it reaches a size, or on a change of UTC
+// date, or both; the current file is renamed with a suffix of .1, any
+// earlier .1 becoming .2, and so on, up to the number of files kept.
+
+class LogWriter : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  struct Options
+  {
+    QString   path;              // file to append to
+    qsizetype capacity = 4096;   // lines queued at most
+    int       flushMs  = 1000;   // longest a line waits to be written
+    int       syncMs   = 10000;  // longest a line waits to reach the disk
+    qint64    maxBytes = 0;      // rotate on reaching this size; 0 for never
+    bool      daily    = false;  // rotate on a change of UTC date
+    int       keep     = 5;      // rotated files kept
+  };
+
+  // Constructor and destructor; the latter quits if we're running.
+
+  explicit LogWriter(QObject * parent = nullptr);
+
+  ~LogWriter();
+
+  // Manipulators; quit() writes anything queued before returning. Lines
+  // are supplied without a line ending. Erasing the file discards any
+  // lines queued, and the file is created anew by the next line written.
+
+  void start(Options, QThread::Priority);
+  void quit();
+  void write(QString);
+  void erase();
+
+signals:
+
+  // Emitted on our thread when the file can't be opened or written, once
+  // until it next succeeds.
+
+  void error(QString const & message);
+
+private:
+
+  struct Impl;
+
+  void run();
+
+  std::unique_ptr<Impl>    m_impl;
+  std::unique_ptr<QThread> m_thread;
+};
+
+#endif
@@ -0,0 +1,411 @@
+#include "Spectrum.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <mutex>
+#include <QDebug>
+#include <QSemaphore>
+#include <fftw3.h>
+#include "moc_Spectrum.cpp"
+
+/******************************************************************************/
+// Local Utilities
+/******************************************************************************/
+
+namespace
+{
+  // Smoothing widths for the linear average, indexed by smoothing setting.
+
+  constexpr std::array NCH = {1, 2, 4, 9, 18, 36, 72};
+
+  // Emulation of the Fortran 'flat1' subroutine.
+
+  void
+  flat1(float const * const savg,
+        int           const iz,
+        int           const nsmo,
+        float       * const slin)
+  {
+    constexpr int x_size = 8192;
+    constexpr int nstep  = 20;
+    constexpr int nh     = nstep / 2;
+
+    // Define bounds for smoothing
+    int const ia =      nsmo / 2 + 1;
+    int const ib = iz - nsmo / 2 - 1;
+
+    std::vector<float> x(x_size, 0.0f);
+
+    // Smooth savg using median percentiles
+
+    auto const rank = std::clamp(static_cast<int>(std::round(0.5f * nsmo)), 0, nsmo - 1);
+
+    for (int i = ia; i <= ib; i += nstep)
+    {
+      auto const data = &savg[i - nsmo / 2];
+      auto       temp = std::vector<float>(data, data + nsmo);
+
+      std::nth_element(temp.begin(),
+                       temp.begin() + rank,
+                       temp.end());
+
+      x[i] = temp[rank];
+
+      std::fill(x.begin() + (i - nh),
+                x.begin() + (i + nh), x[i]);
+    }
+
+    // Extend smoothed values to boundaries
+    std::fill(x.begin(),          x.begin() + ia, x[ia]);
+    std::fill(x.begin() + ib + 1, x.begin() + iz, x[ib]);
+
+    // Compute scaling factor
+    float x0 = 0.001f * *std::max_element(x.begin() +      iz  / 10,
+                                          x.begin() + (9 * iz) / 10);
+
+    // Normalize savg to compute slin
+    for (int i = 0; i < iz; ++i) slin[i] = savg[i] / (x[i] + x0);
+  }
+
+  // Emulation of the Fortran 'smo' subroutine. However, doesn't copy the data
+  // back from b to a; rather, a is input and, b is output. Since we invariably
+  // call this twice, we can just swap the order of the arrays to achieve the
+  // same result without the extra two copy operations.
+
+  void
+  smo(float const * const a,
+      float       * const b,
+      int           const npts,
+      int           const nadd)
+  {
+    auto const nh = nadd / 2;
+
+    // Smooth the array
+    for (int i = nh; i < npts - nh; ++i)
+    {
+      float sum = 0.0f;
+      for (int j = -nh; j <= nh; ++j)
+      {
+        sum += a[i + j];
+      }
+      b[i] = sum;
+    }
+
+    // Set edges to zero
+    for (int i = 0;         i < nh;   ++i) b[i] = 0.0f; // Zero out leading edge
+    for (int i = npts - nh; i < npts; ++i) b[i] = 0.0f; // Zero out trailing edge
+  }
+}
+
+/******************************************************************************/
+// Frame Slot
+/******************************************************************************/
+
+// Single producer, single consumer handoff of frames; a triple buffer. The
+// producer fills the back frame while the consumer reads the front one, and
+// either exchanges theirs with the middle frame in one atomic operation, a
+// flag in the middle index noting that it holds a frame not yet taken. A
+// frame published before the last one was taken simply replaces it.
+
+class Spectrum::Slot
+{
+  static constexpr int INDEX = 0x3;
+  static constexpr int FRESH = 0x4;
+
+  std::array<Frame, 3> m_frames = {};
+  std::atomic<int>     m_middle = 1;
+  int                  m_back   = 0;
+  int                  m_front  = 2;
+
+public:
+
+  Frame & back() { return m_frames[m_back]; }
+
+  void
+  publish()
+  {
+    m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX;
+  }
+
+  Frame const *
+  take()
+  {
+    if (!(m_middle.load(std::memory_order_acquire) & FRESH)) return nullptr;
+
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+
+    return &m_frames[m_front];
+  }
+};
+
+/******************************************************************************/
+// Implementation
+/******************************************************************************/
+
+struct Spectrum::Impl
+{
+  // Blocks that can wait to be processed, and the block data buffers in
+  // the pool; enough for each of those, the one we're processing, and the
+  // one being filled for posting.
+
+  static constexpr std::size_t DEPTH = 4;
+  static constexpr std::size_t POOL  = DEPTH + 2;
+
+  Impl()
+  {
+    spare.reserve(POOL);
+    for (std::size_t i = 0; i < POOL; ++i) spare.emplace_back(NFFT);
+  }
+
+  // Blocks posted and not yet processed, in a ring, oldest at the head; the
+  // semaphore counts them, and is also released once more to wake us up to
+  // quit. Data buffers not in use wait in the spare list.
+
+  QSemaphore                      semaphore;
+  std::mutex                      mutex;
+  std::array<Block, DEPTH>        blocks;
+  std::size_t                     head  = 0;
+  std::size_t                     size  = 0;
+  std::vector<std::vector<float>> spare;
+  bool                            stop  = false;
+
+  // Return a data buffer to the pool, if it's not already full; called
+  // with the mutex held.
+
+  void
+  recycle(std::vector<float> && data)
+  {
+    if (spare.size() < POOL) spare.push_back(std::move(data));
+  }
+
+  // Finished frames, on their way out.
+
+  Slot slot;
+
+  // Running averages, used only by our thread.
+
+  WF::SPlot                    ssum = {};
+  struct specData              spec = {};
+  std::array<float, JS8_NSMAX> temp = {};
+
+  // Process a block of audio into the back frame of the slot, given the
+  // FFT plan and its buffer, which the block's data is copied into.
+
+  void
+  process(Block         const & block,
+          fftwf_plan    const   plan,
+          float         * const real,
+          fftwf_complex * const data)
+  {
+    if (block.reset) ssum.fill(0.0f);
+
+    std::copy(block.data.begin(), block.data.end(), real);
+
+    fftwf_execute(plan);
+
+    auto const iz    = std::min(JS8_NSMAX, static_cast<int>(5000.0f / BIN_WIDTH));
+    auto const cx    = reinterpret_cast<std::complex<float> *>(data);
+    auto const fac   = std::pow(1.0f / NFFT, 2.0f);
+    auto     & frame = slot.back();
+
+    for (int i = 0; i < iz; ++i)
+    {
+      auto const sx = fac * std::norm(cx[i]);
+      ssum[i]      += sx;
+      frame.s[i]    = 1000.0f * block.gain * sx;
+    }
+
+    // Update average spectra.
+
+    for (int i = 0; i < iz; ++i) spec.savg[i] = ssum[i] / block.count;
+
+    if (block.count % 10 == 0)
+    {
+      auto const mode4 = NCH[std::clamp(block.smoothing, 0, static_cast<int>(NCH.size()) - 1)];
+      auto const nsmo  = 4 * std::min(10 * mode4, 150);
+
+      flat1(spec.savg, iz, nsmo, spec.slin);
+
+      if (mode4 >= 2)
+      {
+        smo(spec.slin,   temp.data(), iz, mode4);
+        smo(temp.data(), spec.slin,   iz, mode4);
+      }
+
+      std::fill(std::begin(spec.slin), std::begin(spec.slin) + 250, 0.0f);
+
+      auto const ia    = static_cast<int>( 500.0 / BIN_WIDTH);
+      auto const ib    = static_cast<int>(2700.0 / BIN_WIDTH);
+      auto const smin  = *std::min_element(std::begin(spec.slin) + ia, std::begin(spec.slin) + ib);
+      auto const smax  = *std::max_element(std::begin(spec.slin),      std::begin(spec.slin) + iz);
+      auto const scale = (smax > smin) ? 50.0f / (smax - smin) : 0.0f;
+
+      for (auto & val : spec.slin) val = std::max(0.0f, scale * (val - smin));
+    }
+
+    frame.spec = spec;
+
+    slot.publish();
+  }
+};
+
+Spectrum::Spectrum(QObject * parent)
+  : QObject {parent}
+  , m_impl  {std::make_unique<Impl>()}
+{}
+
+Spectrum::~Spectrum()
+{
+  quit();
+}
+
+void
+Spectrum::start(QThread::Priority const priority)
+{
+  if (m_thread) return;
+
+  m_impl->stop = false;
+  m_thread.reset(QThread::create([this]() { run(); }));
+  m_thread->start(priority);
+}
+
+void
+Spectrum::quit()
+{
+  if (!m_thread) return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->stop = true;
+  }
+
+  m_impl->semaphore.release();
+  m_thread->wait();
+  m_thread.reset();
+}
+
+Spectrum::Block
+Spectrum::block()
+{
+  Block block;
+  {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+
+    if (!m_impl->spare.empty())
+    {
+      block.data = std::move(m_impl->spare.back());
+      m_impl->spare.pop_back();
+    }
+  }
+
+  block.data.resize(NFFT);
+
+  return block;
+}
+
+// If the thread has fallen so far behind that the ring is full, the oldest
+// block waiting is dropped in favour of this one; the semaphore already
+// counts a block in its place. Should the block dropped have started a new
+// average, the one now oldest starts it instead.
+
+void
+Spectrum::post(Block block)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+
+    if (m_impl->size == Impl::DEPTH)
+    {
+      auto & oldest = m_impl->blocks[m_impl->head];
+      auto   reset  = oldest.reset;
+
+      m_impl->recycle(std::move(oldest.data));
+      m_impl->head = (m_impl->head + 1) % Impl::DEPTH;
+      m_impl->size--;
+
+      (m_impl->size ? m_impl->blocks[m_impl->head] : block).reset |= reset;
+
+      m_impl->blocks[(m_impl->head + m_impl->size++) % Impl::DEPTH] = std::move(block);
+
+      return;
+    }
+
+    m_impl->blocks[(m_impl->head + m_impl->size++) % Impl::DEPTH] = std::move(block);
+  }
+
+  m_impl->semaphore.release();
+}
+
+Spectrum::Frame const *
+Spectrum::take()
+{
+  return m_impl->slot.take();
+}
+
+// Runloop for our thread. The FFT plan and its buffer belong to us for as
+// long as we run; we create them here rather than on the main thread, and
+// in doing so, the FFTW library requires that all calls but for the plan
+// execution, i.e., fftwf_execute(), be serialized.
+//
+// Providing room for an extra complex value, i.e., a pair of floats, real
+// and imaginary parts, allows us to use the same buffer for the FFT input
+// and output. While the memory for the FFT can come from anywhere, if we
+// ask the library for it, it'll guarantee that it's aligned for the use of
+// SIMD instructions, which will in turn allow it to use them.
+
+void
+Spectrum::run()
+{
+  fftwf_complex * data;
+  float         * real;
+  fftwf_plan      plan;
+  {
+    std::lock_guard<std::mutex> lock(fftw_mutex);
+
+    data = fftwf_alloc_complex(NFFT / 2 + 1);
+    real = reinterpret_cast<float *>(data);
+    plan = data ? fftwf_plan_dft_r2c_1d(NFFT, real, data, FFTW_ESTIMATE_PATIENT)
+                : nullptr;
+  }
+
+  if (!plan)
+  {
+    qCritical() << "Spectrum: failed to create FFT plan";
+  }
+  else
+  {
+    while (true)
+    {
+      m_impl->semaphore.acquire();
+
+      Block block;
+      {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+
+        if (m_impl->stop) break;
+
+        block = std::move(m_impl->blocks[m_impl->head]);
+        m_impl->head = (m_impl->head + 1) % Impl::DEPTH;
+        m_impl->size--;
+      }
+
+      m_impl->process(block, plan, real, data);
+
+      {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        m_impl->recycle(std::move(block.data));
+      }
+
+      emit frameReady();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(fftw_mutex);
+
+  if (plan) fftwf_destroy_plan(plan);
+  if (data) fftwf_free(data);
+}
+
+/******************************************************************************/
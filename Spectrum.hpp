@@ -0,0 +1,86 @@
+#ifndef SPECTRUM_HPP__
+#define SPECTRUM_HPP__
+
+#include <memory>
+#include <vector>
+#include <QObject>
+#include <QThread>
+#include "commons.h"
+#include "WF.hpp"
+
+// Computes the symbol spectra behind the waterfall and the cumulative and
+// linear average spectrum displays, on a thread of its own. The thread
+// owns the FFT plan and buffers for as long as it runs, along with the
+// running averages; blocks of audio go in through post(), and finished
+// frames come back out through take(), via a lock-free slot in which the
+// newest frame replaces any that weren't taken in time. Blocks come from a
+// small pool, and only a few can wait on the thread; should it fall that
+// far behind, the oldest waiting is dropped.
+
+class Spectrum : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  // Size of the FFT, i.e., the number of samples in a block, and the
+  // resulting bin width, at the 12kHz sample rate.
+
+  static constexpr int   NFFT      = 16384;
+  static constexpr float BIN_WIDTH = 12000.0f / NFFT;
+
+  // A block of audio; one arrives every half symbol.
+
+  struct Block
+  {
+    std::vector<float> data;              // NFFT samples, scaled
+    float              gain      = 1.0f;  // applied to the waterfall spectrum
+    int                count     = 1;     // blocks averaged, including this one
+    int                smoothing = 0;     // linear average smoothing setting
+    bool               reset     = false; // start a new average with this one
+  };
+
+  // A finished frame; the spectrum for the waterfall and the averages.
+
+  struct Frame
+  {
+    WF::SPlot       s    = {};
+    struct specData spec = {};
+  };
+
+  // Constructor and destructor; the latter quits if we're running.
+
+  explicit Spectrum(QObject * parent = nullptr);
+
+  ~Spectrum();
+
+  // Manipulators; the thread that calls post() must be the one to call
+  // block() and take(). The block returned by block() has its data sized
+  // to NFFT, in a buffer from the pool, to which post() returns it. The
+  // frame returned by take() remains valid until the next call; if no new
+  // frame has been finished since then, returns null.
+
+  void          start(QThread::Priority);
+  void          quit();
+  Block         block();
+  void          post(Block);
+  Frame const * take();
+
+signals:
+
+  // Emitted on our thread each time a frame is finished.
+
+  void frameReady();
+
+private:
+
+  class Slot;
+  struct Impl;
+
+  void run();
+
+  std::unique_ptr<Impl>    m_impl;
+  std::unique_ptr<QThread> m_thread;
+};
+
+#endif
@@ -0,0 +1,216 @@
+#include "TableRows.hpp"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <QHash>
+#include <QTableWidget>
+#include <QTableWidgetItem>
+
+/******************************************************************************/
+// Local Routines
+/******************************************************************************/
+
+namespace
+{
+  // Key of a row, either in the table or to be placed in it.
+
+  QString
+  keyOf(QTableWidget const * const table,
+        int                  const row)
+  {
+    auto const item = table->item(row, 0);
+    return item ? item->data(Qt::UserRole).toString() : QString();
+  }
+
+  QString
+  keyOf(TableRows::Row const & row)
+  {
+    return row.cells.isEmpty() ? QString() : row.cells.first().data.toString();
+  }
+
+  // Take the items of a row out of the table, removing the row.
+
+  QList<QTableWidgetItem *>
+  takeRow(QTableWidget * const table,
+          int            const row)
+  {
+    QList<QTableWidgetItem *> items;
+
+    for (int col = 0; col < table->columnCount(); ++col)
+    {
+      items.append(table->takeItem(row, col));
+    }
+
+    table->removeRow(row);
+
+    return items;
+  }
+
+  // Insert a row, putting the items of a row taken earlier into it.
+
+  void
+  putRow(QTableWidget                    * const table,
+         int                               const row,
+         QList<QTableWidgetItem *> const &       items)
+  {
+    table->insertRow(row);
+
+    for (int col = 0; col < items.size(); ++col)
+    {
+      if (items[col]) table->setItem(row, col, items[col]);
+    }
+  }
+
+  // Given the wanted positions of the rows in the table, determine which
+  // of them can stay where they are; that's the longest run of rows that
+  // are already in order, i.e., the longest increasing subsequence of the
+  // positions. The rest have to move.
+
+  std::vector<bool>
+  rowsInOrder(std::vector<int> const & positions)
+  {
+    std::vector<int> tails;    // index of the last row of the best run of each length
+    std::vector<int> previous(positions.size(), -1);
+
+    for (int i = 0; i < static_cast<int>(positions.size()); ++i)
+    {
+      auto const it = std::lower_bound(tails.begin(), tails.end(), positions[i], [&](int const tail,
+                                                                                     int const position)
+      {
+        return positions[tail] < position;
+      });
+
+      if (it != tails.begin()) previous[i] = *std::prev(it);
+      if (it == tails.end())   tails.push_back(i);
+      else                     *it = i;
+    }
+
+    std::vector<bool> keep(positions.size(), false);
+
+    for (int i = tails.empty() ? -1 : tails.back(); i != -1; i = previous[i])
+    {
+      keep[i] = true;
+    }
+
+    return keep;
+  }
+
+  // Bring the items of a row up to date. Setting a role to the value it
+  // already has doesn't signal a change, so there's no need to check.
+
+  void
+  updateRow(QTableWidget         * const table,
+            int                    const row,
+            TableRows::Row const &       data)
+  {
+    auto const cols = std::min(static_cast<int>(data.cells.size()), table->columnCount());
+
+    for (int col = 0; col < cols; ++col)
+    {
+      auto const & cell = data.cells[col];
+      auto         item = table->item(row, col);
+
+      if (!item)
+      {
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+      }
+
+      item->setText(cell.text);
+      item->setToolTip(cell.toolTip);
+      item->setData(Qt::UserRole, cell.data);
+      item->setTextAlignment(cell.alignment);
+      item->setBackground(data.background);
+      item->setFont(data.font);
+
+      if (item->isSelected() != data.selected) item->setSelected(data.selected);
+    }
+  }
+}
+
+/******************************************************************************/
+// Implementation
+/******************************************************************************/
+
+namespace TableRows
+{
+  void
+  update(QTableWidget     * const table,
+         QList<Row> const &       rows)
+  {
+    QHash<QString, int> wanted;
+
+    for (int row = 0; row < rows.size(); ++row) wanted.insert(keyOf(rows[row]), row);
+
+    // Remove rows that are no longer wanted, from the bottom up so that
+    // the rows yet to be considered stay where they are.
+
+    for (int row = table->rowCount() - 1; row >= 0; --row)
+    {
+      if (!wanted.contains(keyOf(table, row))) table->removeRow(row);
+    }
+
+    // Take out the rows that are out of order, keeping their items to put
+    // back in the right place. What remains is in order, so that each row
+    // wanted is either in place, or one to put back, or new. A row that's
+    // changed position in the ordering is thus moved once, and the rest
+    // of the table stays put.
+
+    std::vector<int> positions;
+
+    for (int row = 0; row < table->rowCount(); ++row)
+    {
+      positions.push_back(wanted.value(keyOf(table, row)));
+    }
+
+    auto const                                 keep = rowsInOrder(positions);
+    QHash<QString, QList<QTableWidgetItem *>>  taken;
+
+    for (int row = table->rowCount() - 1; row >= 0; --row)
+    {
+      if (keep[row]) continue;
+
+      if (auto const key = keyOf(table, row); !taken.contains(key))
+      {
+        taken.insert(key, takeRow(table, row));
+      }
+      else
+      {
+        table->removeRow(row);
+      }
+    }
+
+    for (int row = 0; row < rows.size(); ++row)
+    {
+      auto const & data  = rows[row];
+      auto const   key   = keyOf(data);
+      auto const   place = row >= table->rowCount() || keyOf(table, row) != key;
+
+      if (place)
+      {
+        if (auto const it = taken.find(key); it != taken.end())
+        {
+          putRow(table, row, it.value());
+          taken.erase(it);
+        }
+        else
+        {
+          table->insertRow(row);
+        }
+
+        if (data.span > 1) table->setSpan(row, data.cells.size() - 1, 1, data.span);
+      }
+
+      // A row that's been put back has lost its selection along the way,
+      // so it's brought up to date even if it hasn't changed.
+
+      if (place || data.changed) updateRow(table, row, data);
+    }
+
+    // Anything left over is a duplicate of a key placed above.
+
+    for (auto const & items : taken) qDeleteAll(items);
+
+    table->setRowCount(rows.size());
+  }
+}
@@ -0,0 +1,204 @@
+#ifndef TABLEROWS_HPP__
+#define TABLEROWS_HPP__
+
+#include <algorithm>
+#include <QBrush>
+#include <QDateTime>
+#include <QFont>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+#include <Qt>
+
+class QTableWidget;
+
+// Incremental update of a table widget's rows. Rather than clearing the
+// table and creating every item anew on each refresh, the desired rows are
+// described by value and reconciled with those already present; rows are
+// matched by key, and only rows that have appeared, disappeared or moved
+// are inserted, removed, or taken and put back. Items are updated in
+// place, which is a no-op for any role whose value hasn't changed, so the
+// view sees changes, not the whole table.
+
+namespace TableRows
+{
+  struct Cell
+  {
+    QString       text;
+    QString       toolTip;
+    QVariant      data;                                  // Qt::UserRole
+    Qt::Alignment alignment = Qt::AlignLeft | Qt::AlignVCenter;
+  };
+
+  struct Row
+  {
+    QList<Cell> cells;            // from the first column on
+    int         span     = 1;     // columns spanned by the last cell
+    QBrush      background;
+    QFont       font;
+    bool        selected = false;
+    bool        changed  = true;  // false if as last supplied for the table
+  };
+
+  // Make the table's rows those supplied, in order. A row's key is the
+  // user data of its first cell, as a string, both in the rows supplied
+  // and in the table; rows with the same key must have the same span.
+  // The items of a row that hasn't changed are left alone if it's still
+  // in place.
+
+  void update(QTableWidget     * table,
+              QList<Row> const & rows);
+
+  // The rows of a table as last built for each key, along with the order
+  // of the keys, kept from one refresh to the next so that a refresh need
+  // build only the rows of keys that have changed since, and place only
+  // them in order. A row is built anew, too, once it expires, i.e., when
+  // its content changes with the passage of time alone, as an age does,
+  // and every row is whenever the context, i.e., whatever all of the rows
+  // depend on, such as settings and the sort order, changes.
+
+  template <typename Key>
+  class Cache
+  {
+  public:
+
+    struct Entry
+    {
+      Row       row;              // no cells if the key isn't shown
+      QDateTime expires;          // when the row changes with time alone
+      bool      counted = true;   // whether the key counts toward a total
+
+      // Have the row expire at the time provided, if that's sooner than
+      // it would otherwise; an invalid time is no time at all.
+
+      void
+      expireBy(QDateTime const & when)
+      {
+        if (when.isValid() && (!expires.isValid() || when < expires)) expires = when;
+      }
+    };
+
+    // Forget all rows, e.g., when something they depend on has changed
+    // that isn't part of the context, so that the next refresh builds
+    // them anew.
+
+    void clear() { m_stale = true; }
+
+    // Bring the rows up to date and return those that are shown, in order.
+    // The keys changed since the last refresh are those supplied, unless
+    // all of them have; the selected key changing changes both it and
+    // the key previously selected. Keys supplies all the keys, build the
+    // entry for one, or nothing if it's gone, and before orders two.
+
+    template <typename Keys,
+              typename Build,
+              typename Before>
+    QList<Row>
+    refresh(QString   const & context,
+            Key       const & selected,
+            QDateTime const & now,
+            bool              all,
+            QSet<Key>         changed,
+            Keys           && keys,
+            Build          && build,
+            Before         && before)
+    {
+      all = all || m_stale || context != m_context;
+
+      if (selected != m_selected)
+      {
+        changed.insert(m_selected);
+        changed.insert(selected);
+      }
+
+      m_stale    = false;
+      m_context  = context;
+      m_selected = selected;
+
+      if (all)
+      {
+        m_entries.clear();
+        m_order.clear();
+
+        for (auto const & key : keys())
+        {
+          if (auto entry = build(key))
+          {
+            m_entries.insert(key, std::move(*entry));
+            m_order.append(key);
+          }
+        }
+
+        std::sort(m_order.begin(), m_order.end(), before);
+      }
+      else
+      {
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+        {
+          if (it->expires.isValid() && it->expires <= now) changed.insert(it.key());
+        }
+
+        // Take the keys that have changed out of the order, and put those
+        // that are still around back in where they now belong.
+
+        if (!changed.isEmpty())
+        {
+          m_order.removeIf([&changed](Key const & key)
+          {
+            return changed.contains(key);
+          });
+
+          for (auto const & key : changed)
+          {
+            if (auto entry = build(key))
+            {
+              m_entries.insert(key, std::move(*entry));
+              m_order.insert(std::lower_bound(m_order.cbegin(),
+                                              m_order.cend(), key, before) - m_order.cbegin(), key);
+            }
+            else
+            {
+              m_entries.remove(key);
+            }
+          }
+        }
+      }
+
+      QList<Row> rows;
+
+      for (auto const & key : m_order)
+      {
+        if (auto const & entry = m_entries.constFind(key).value(); !entry.row.cells.isEmpty())
+        {
+          rows.append(entry.row);
+          rows.last().changed = all || changed.contains(key);
+        }
+      }
+
+      return rows;
+    }
+
+    // Number of keys that count toward a total, whether shown or not.
+
+    qsizetype
+    counted() const
+    {
+      return std::count_if(m_entries.cbegin(), m_entries.cend(), [](Entry const & entry)
+      {
+        return entry.counted;
+      });
+    }
+
+  private:
+
+    bool              m_stale = true;
+    QString           m_context;
+    Key               m_selected {};
+    QHash<Key, Entry> m_entries;
+    QList<Key>        m_order;
+  };
+}
+
+#endif
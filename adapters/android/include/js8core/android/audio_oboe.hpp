@@ -37,13 +37,6 @@ private:
   AudioInputHandler on_frames_;
   AudioErrorHandler on_error_;
   std::mutex mutex_;
-
-  // Resampling state (device may force 48kHz; engine expects 12kHz)
-  int actual_sample_rate_ = 0;
-  int decimation_factor_ = 1;
-  std::vector<float> fir_taps_;
-  std::vector<int16_t> fir_buffer_;
-  int fir_pos_ = 0;
 };
 
 // Oboe-based audio output implementation for Android
@@ -4,15 +4,19 @@
 #include <algorithm>
 #include <cmath>
 #include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include "js8core/decoder_state.hpp"
 #include "js8core/engine.hpp"
 #include "js8core/protocol/varicode.hpp"
-#include "js8core/dsp/resampler.hpp"
+#include "js8core/trace.hpp"
 #include "js8core/android/audio_oboe.hpp"
 #include "js8core/android/logger_android.hpp"
 #include "js8core/android/network_android.hpp"
@@ -24,10 +28,15 @@
 extern "C" {
 JNIEXPORT jlong JNICALL Java_com_js8call_core_JS8Engine_00024Companion_nativeCreate(JNIEnv*, jobject, jobject, jint, jint);
 JNIEXPORT jboolean JNICALL Java_com_js8call_core_JS8Engine_nativeStart(JNIEnv*, jobject, jlong);
+JNIEXPORT jobject JNICALL Java_com_js8call_core_JS8Engine_nativeGetDecodeBatchBuffer(JNIEnv*, jobject, jlong);
+JNIEXPORT jobject JNICALL Java_com_js8call_core_JS8Engine_nativeGetSpectrumBuffer(JNIEnv*, jobject, jlong);
 JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeStop(JNIEnv*, jobject, jlong);
 JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeDestroy(JNIEnv*, jobject, jlong);
 JNIEXPORT jboolean JNICALL Java_com_js8call_core_JS8Engine_nativeSubmitAudio(JNIEnv*, jobject, jlong, jshortArray, jint, jlong);
 JNIEXPORT jboolean JNICALL Java_com_js8call_core_JS8Engine_nativeSubmitAudioRaw(JNIEnv*, jobject, jlong, jshortArray, jint, jint, jlong);
+JNIEXPORT jint JNICALL Java_com_js8call_core_JS8Engine_nativeAttachCaptureRing(JNIEnv*, jobject, jlong, jobject);
+JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeDetachCaptureRing(JNIEnv*, jobject, jlong);
+JNIEXPORT jint JNICALL Java_com_js8call_core_JS8Engine_nativeSubmitCaptureRing(JNIEnv*, jobject, jlong, jint, jint, jint, jint, jlong);
 JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeSetFrequency(JNIEnv*, jobject, jlong, jlong);
 JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeSetSubmodes(JNIEnv*, jobject, jlong, jint);
 JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeSetOutputDevice(JNIEnv*, jobject, jlong, jint);
@@ -39,6 +48,10 @@ JNIEXPORT jboolean JNICALL Java_com_js8call_core_JS8Engine_nativeStartTune(JNIEn
 JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeStopTransmit(JNIEnv*, jobject, jlong);
 JNIEXPORT jboolean JNICALL Java_com_js8call_core_JS8Engine_nativeIsTransmitting(JNIEnv*, jobject, jlong);
 JNIEXPORT jboolean JNICALL Java_com_js8call_core_JS8Engine_nativeIsTransmittingAudio(JNIEnv*, jobject, jlong);
+JNIEXPORT jboolean JNICALL Java_com_js8call_core_JS8Engine_nativeStartRecording(JNIEnv*, jobject, jlong, jstring);
+JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_nativeStopRecording(JNIEnv*, jobject, jlong);
+JNIEXPORT void JNICALL Java_com_js8call_core_JS8Engine_00024Companion_nativeSetTracingEnabled(JNIEnv*, jobject, jboolean);
+JNIEXPORT jstring JNICALL Java_com_js8call_core_JS8Engine_00024Companion_nativeDumpTrace(JNIEnv*, jobject);
 }
 
 // Global JavaVM reference for callbacks
@@ -55,9 +68,30 @@ struct JS8Engine_Native {
   std::unique_ptr<js8core::android::BsdUdpChannel> udp;
   std::unique_ptr<js8core::android::NullRigControl> rig;
 
-  // Java callback handler (global ref)
+  // Kotlin event bridge (global ref) and its method IDs, resolved once at create
   jobject callback_handler = nullptr;
   std::mutex callback_mutex;
+  jmethodID on_decode_batch = nullptr;
+  jmethodID on_spectrum_frame = nullptr;
+  jmethodID on_decode_started = nullptr;
+  jmethodID on_decode_finished = nullptr;
+  jmethodID on_decode_metrics = nullptr;
+  jmethodID on_error = nullptr;
+  jmethodID on_log = nullptr;
+
+  // Decodes are packed into a shared direct buffer and delivered once per decode
+  // cycle (see kDecodeRecordBytes for the record layout).
+  std::vector<std::byte> decode_batch;
+  jobject decode_batch_buffer = nullptr;
+  std::size_t decode_batch_bytes = 0;
+  int decode_batch_count = 0;
+  bool decode_cycle_open = false;
+
+  // Spectrum frames are written over the same direct buffer every time; the
+  // sequence number in the header lets Kotlin spot frames it has missed.
+  std::vector<std::byte> spectrum_frame;
+  jobject spectrum_frame_buffer = nullptr;
+  std::int32_t spectrum_sequence = 0;
 
   bool tx_boost_enabled = false;
   std::mutex tx_boost_mutex;
@@ -66,18 +100,11 @@ struct JS8Engine_Native {
   js8core::AudioFormat audio_format;
   std::vector<std::byte> audio_buffer;
 
-  // Decimation state for Java-side raw audio (e.g., 48 kHz -> 12 kHz)
-  int decimation_factor = 1;
-  int decimation_mirror = 0;
-  std::vector<float> decimation_taps;
-  std::vector<int16_t> decimation_buffer;
-  int decimation_pos = 0;
-
-  // Fractional resampling state for non-integer rate conversion (e.g., 44.1 kHz -> 12 kHz)
-  std::vector<float> resample_buffer;
-  double resample_pos = 0.0;
-  int resample_input_rate = 0;
-  int resample_output_rate = 0;
+  // Capture ring shared with Kotlin: a direct ByteBuffer of interleaved int16
+  // frames that AudioRecord writes into and the engine reads in place.
+  jobject capture_ring = nullptr;
+  const int16_t* capture_ring_data = nullptr;
+  size_t capture_ring_samples = 0;
 };
 
 // Helper to get JNI environment for current thread
@@ -276,6 +303,68 @@ static std::string render_decoded_text(js8core::events::Decoded const& decoded)
   return frame;
 }
 
+// Shared buffer layouts (native byte order, read by DecodeBatch/SpectrumFrame in JS8Engine.kt).
+//
+// Decode record: utc:i32 snr:i32 dt:f32 freq:f32 type:i32 quality:f32 mode:i32 text_len:i32,
+// followed by text_len bytes of UTF-8 padded to a 4-byte boundary.
+//
+// Spectrum frame: sequence:i32 bin_count:i32 bin_hz:f32 power_db:f32 peak_db:f32 reserved:i32,
+// followed by bin_count f32 bins.
+constexpr std::size_t kDecodeBatchBytes = 64 * 1024;
+constexpr std::size_t kDecodeRecordBytes = 32;
+constexpr std::size_t kSpectrumHeaderBytes = 24;
+constexpr std::size_t kSpectrumMaxBins = js8core::kJs8NsMax;
+
+// Decode metrics stage times: wall_ns, cpu_ns pairs for total, sync, downsample,
+// search, demod, bp and subtract, in that order (see DecodeMetrics in JS8EngineEvents.kt).
+constexpr std::size_t kDecodeMetricsStages = 7;
+
+template <typename T>
+static void put_field(std::byte* base, std::size_t offset, T value) {
+  std::memcpy(base + offset, &value, sizeof(T));
+}
+
+// Deliver the pending decode batch; caller holds callback_mutex.
+static void flush_decode_batch(JS8Engine_Native* native, JNIEnv* env) {
+  if (native->decode_batch_count == 0) return;
+  if (native->on_decode_batch) {
+    env->CallVoidMethod(native->callback_handler, native->on_decode_batch,
+                        static_cast<jint>(native->decode_batch_count),
+                        static_cast<jint>(native->decode_batch_bytes));
+  }
+  native->decode_batch_count = 0;
+  native->decode_batch_bytes = 0;
+}
+
+// Append a decode to the batch; caller holds callback_mutex.
+static void append_decode(JS8Engine_Native* native, JNIEnv* env,
+                          js8core::events::Decoded const& d, std::string const& text) {
+  std::size_t text_len = std::min(text.size(), kDecodeBatchBytes - kDecodeRecordBytes);
+  // Back a clamped cut up to a character boundary, i.e. off UTF-8 continuation bytes.
+  while (text_len > 0 && text_len < text.size() &&
+         (static_cast<unsigned char>(text[text_len]) & 0xC0) == 0x80) {
+    --text_len;
+  }
+  std::size_t record = kDecodeRecordBytes + ((text_len + 3) & ~std::size_t{3});
+  if (native->decode_batch_bytes + record > native->decode_batch.size()) {
+    flush_decode_batch(native, env);
+  }
+
+  std::byte* base = native->decode_batch.data() + native->decode_batch_bytes;
+  put_field<std::int32_t>(base, 0, d.utc);
+  put_field<std::int32_t>(base, 4, d.snr);
+  put_field<float>(base, 8, d.xdt);
+  put_field<float>(base, 12, d.frequency);
+  put_field<std::int32_t>(base, 16, d.type);
+  put_field<float>(base, 20, d.quality);
+  put_field<std::int32_t>(base, 24, d.mode);
+  put_field<std::int32_t>(base, 28, static_cast<std::int32_t>(text_len));
+  std::memcpy(base + kDecodeRecordBytes, text.data(), text_len);
+
+  native->decode_batch_bytes += record;
+  ++native->decode_batch_count;
+}
+
 // Event callback that marshals C++ events to Java
 static void event_callback(JS8Engine_Native* native, js8core::events::Variant const& event) {
   if (!native || !native->callback_handler) return;
@@ -285,96 +374,81 @@ static void event_callback(JS8Engine_Native* native, js8core::events::Variant co
 
   std::lock_guard<std::mutex> lock(native->callback_mutex);
 
-  // Get callback handler class
-  jclass handler_class = env->GetObjectClass(native->callback_handler);
-  if (!handler_class) return;
-
   // Handle different event types
   if (auto* decoded = std::get_if<js8core::events::Decoded>(&event)) {
-    auto rendered = render_decoded_text(*decoded);
-
-    auto emit_decoded = [&](js8core::events::Decoded const& d, std::string const& text_str) {
-      jmethodID method = env->GetMethodID(handler_class, "onDecoded", "(IIFFLjava/lang/String;IFI)V");
-      if (method) {
-        jstring text = env->NewStringUTF(text_str.c_str());
-        env->CallVoidMethod(native->callback_handler, method,
-                           d.utc, d.snr, d.xdt, d.frequency,
-                           text, d.type, d.quality, d.mode);
-        env->DeleteLocalRef(text);
-      }
-    };
-    emit_decoded(*decoded, rendered);
+    append_decode(native, env, *decoded, render_decoded_text(*decoded));
+    // Decodes outside a cycle have nothing to batch with.
+    if (!native->decode_cycle_open) flush_decode_batch(native, env);
   } else if (auto* spectrum = std::get_if<js8core::events::Spectrum>(&event)) {
-    // Call onSpectrum(float[] bins, float binHz, float powerDb, float peakDb)
-    jmethodID method = env->GetMethodID(handler_class, "onSpectrum", "([FFFF)V");
-    if (method) {
-      jfloatArray bins = env->NewFloatArray(static_cast<jsize>(spectrum->bins.size()));
-      env->SetFloatArrayRegion(bins, 0, static_cast<jsize>(spectrum->bins.size()),
-                               spectrum->bins.data());
-      env->CallVoidMethod(native->callback_handler, method,
-                         bins, spectrum->bin_hz, spectrum->power_db, spectrum->peak_db);
-      env->DeleteLocalRef(bins);
-    }
+    if (!native->on_spectrum_frame) return;
+    std::size_t count = std::min(spectrum->bins.size(), kSpectrumMaxBins);
+    std::byte* base = native->spectrum_frame.data();
+    put_field<std::int32_t>(base, 0, ++native->spectrum_sequence);
+    put_field<std::int32_t>(base, 4, static_cast<std::int32_t>(count));
+    put_field<float>(base, 8, spectrum->bin_hz);
+    put_field<float>(base, 12, spectrum->power_db);
+    put_field<float>(base, 16, spectrum->peak_db);
+    std::memcpy(base + kSpectrumHeaderBytes, spectrum->bins.data(), count * sizeof(float));
+    env->CallVoidMethod(native->callback_handler, native->on_spectrum_frame);
   } else if (auto* decode_started = std::get_if<js8core::events::DecodeStarted>(&event)) {
-    // Call onDecodeStarted(int submodes)
-    jmethodID method = env->GetMethodID(handler_class, "onDecodeStarted", "(I)V");
-    if (method) {
-      env->CallVoidMethod(native->callback_handler, method, decode_started->submodes);
+    native->decode_cycle_open = true;
+    if (native->on_decode_started) {
+      env->CallVoidMethod(native->callback_handler, native->on_decode_started,
+                          decode_started->submodes);
+    }
+  } else if (auto* metrics = std::get_if<js8core::events::DecodeMetrics>(&event)) {
+    if (!native->on_decode_metrics) return;
+    js8core::events::DecodeStageTime const* stages[kDecodeMetricsStages] = {
+        &metrics->total, &metrics->sync, &metrics->downsample, &metrics->search,
+        &metrics->demod, &metrics->bp, &metrics->subtract};
+    jlong times[kDecodeMetricsStages * 2];
+    for (std::size_t i = 0; i < kDecodeMetricsStages; ++i) {
+      times[i * 2] = static_cast<jlong>(stages[i]->wall.count());
+      times[i * 2 + 1] = static_cast<jlong>(stages[i]->cpu.count());
     }
+    jlongArray array = env->NewLongArray(static_cast<jsize>(kDecodeMetricsStages * 2));
+    if (!array) return;
+    env->SetLongArrayRegion(array, 0, static_cast<jsize>(kDecodeMetricsStages * 2), times);
+    env->CallVoidMethod(native->callback_handler, native->on_decode_metrics,
+                        metrics->submodes, metrics->passes,
+                        metrics->candidates_tried, metrics->candidates_decoded, array);
+    env->DeleteLocalRef(array);
   } else if (auto* decode_finished = std::get_if<js8core::events::DecodeFinished>(&event)) {
-    // Call onDecodeFinished(int count)
-    jmethodID method = env->GetMethodID(handler_class, "onDecodeFinished", "(I)V");
-    if (method) {
-      env->CallVoidMethod(native->callback_handler, method,
-                         static_cast<jint>(decode_finished->decoded));
+    native->decode_cycle_open = false;
+    flush_decode_batch(native, env);
+    if (native->on_decode_finished) {
+      env->CallVoidMethod(native->callback_handler, native->on_decode_finished,
+                          static_cast<jint>(decode_finished->decoded));
     }
   }
-
-  env->DeleteLocalRef(handler_class);
 }
 
 // Error callback
 static void error_callback(JS8Engine_Native* native, std::string_view message) {
-  if (!native || !native->callback_handler) return;
+  if (!native || !native->callback_handler || !native->on_error) return;
 
   JNIEnv* env = get_jni_env();
   if (!env) return;
 
   std::lock_guard<std::mutex> lock(native->callback_mutex);
 
-  jclass handler_class = env->GetObjectClass(native->callback_handler);
-  if (!handler_class) return;
-
-  jmethodID method = env->GetMethodID(handler_class, "onError", "(Ljava/lang/String;)V");
-  if (method) {
-    jstring msg = env->NewStringUTF(std::string(message).c_str());
-    env->CallVoidMethod(native->callback_handler, method, msg);
-    env->DeleteLocalRef(msg);
-  }
-
-  env->DeleteLocalRef(handler_class);
+  jstring msg = env->NewStringUTF(std::string(message).c_str());
+  env->CallVoidMethod(native->callback_handler, native->on_error, msg);
+  env->DeleteLocalRef(msg);
 }
 
 // Log callback
 static void log_callback(JS8Engine_Native* native, js8core::LogLevel level, std::string_view message) {
-  if (!native || !native->callback_handler) return;
+  if (!native || !native->callback_handler || !native->on_log) return;
 
   JNIEnv* env = get_jni_env();
   if (!env) return;
 
   std::lock_guard<std::mutex> lock(native->callback_mutex);
 
-  jclass handler_class = env->GetObjectClass(native->callback_handler);
-  if (!handler_class) return;
-
-  jmethodID method = env->GetMethodID(handler_class, "onLog", "(ILjava/lang/String;)V");
-  if (method) {
-    jstring msg = env->NewStringUTF(std::string(message).c_str());
-    env->CallVoidMethod(native->callback_handler, method, static_cast<jint>(level), msg);
-    env->DeleteLocalRef(msg);
-  }
-
-  env->DeleteLocalRef(handler_class);
+  jstring msg = env->NewStringUTF(std::string(message).c_str());
+  env->CallVoidMethod(native->callback_handler, native->on_log, static_cast<jint>(level), msg);
+  env->DeleteLocalRef(msg);
 }
 
 extern "C" {
@@ -385,8 +459,38 @@ JS8Engine_Native* js8_engine_create(JNIEnv* env, jobject callback_handler,
 
   auto native = new JS8Engine_Native();
 
-  // Create global reference to callback handler
+  // Create global reference to callback handler and resolve its methods once
   native->callback_handler = env->NewGlobalRef(callback_handler);
+  jclass handler_class = env->GetObjectClass(callback_handler);
+  if (handler_class) {
+    native->on_decode_batch = env->GetMethodID(handler_class, "onDecodeBatch", "(II)V");
+    native->on_spectrum_frame = env->GetMethodID(handler_class, "onSpectrumFrame", "()V");
+    native->on_decode_started = env->GetMethodID(handler_class, "onDecodeStarted", "(I)V");
+    native->on_decode_finished = env->GetMethodID(handler_class, "onDecodeFinished", "(I)V");
+    native->on_decode_metrics = env->GetMethodID(handler_class, "onDecodeMetrics", "(IIII[J)V");
+    native->on_error = env->GetMethodID(handler_class, "onError", "(Ljava/lang/String;)V");
+    native->on_log = env->GetMethodID(handler_class, "onLog", "(ILjava/lang/String;)V");
+    env->DeleteLocalRef(handler_class);
+  }
+  if (env->ExceptionCheck()) {
+    env->ExceptionClear();  // a missing method just disables that callback
+  }
+
+  // Shared event buffers
+  native->decode_batch.assign(kDecodeBatchBytes, std::byte{0});
+  native->spectrum_frame.assign(kSpectrumHeaderBytes + kSpectrumMaxBins * sizeof(float), std::byte{0});
+  jobject decode_buffer = env->NewDirectByteBuffer(native->decode_batch.data(),
+                                                   static_cast<jlong>(native->decode_batch.size()));
+  jobject spectrum_buffer = env->NewDirectByteBuffer(native->spectrum_frame.data(),
+                                                     static_cast<jlong>(native->spectrum_frame.size()));
+  if (decode_buffer) {
+    native->decode_batch_buffer = env->NewGlobalRef(decode_buffer);
+    env->DeleteLocalRef(decode_buffer);
+  }
+  if (spectrum_buffer) {
+    native->spectrum_frame_buffer = env->NewGlobalRef(spectrum_buffer);
+    env->DeleteLocalRef(spectrum_buffer);
+  }
 
   // Create adapters
   native->logger = std::make_unique<js8core::android::AndroidLogger>("JS8Call");
@@ -405,6 +509,7 @@ JS8Engine_Native* js8_engine_create(JNIEnv* env, jobject callback_handler,
   js8core::EngineConfig config;
   config.sample_rate_hz = sample_rate_hz;
   config.submodes = (submodes == 0) ? 0x1F : submodes;  // default to all standard submodes
+  config.input_channel = js8core::kInputChannelLoudest;  // follow the live channel on stereo USB codecs
   config.tx_output_rate_hz = 0;  // Use device native output rate and resample
   config.tx_output_gain = 0.2f;  // Leave headroom to avoid splatter/ALC
 
@@ -472,17 +577,32 @@ void js8_engine_destroy(JS8Engine_Native* engine) {
   // Stop engine first
   js8_engine_stop(engine);
 
-  // Delete global reference to callback handler
-  if (engine->callback_handler) {
-    JNIEnv* env = get_jni_env();
-    if (env) {
-      env->DeleteGlobalRef(engine->callback_handler);
-    }
+  // Delete global references to callback handler and capture ring
+  JNIEnv* env = get_jni_env();
+  if (env && engine->callback_handler) {
+    env->DeleteGlobalRef(engine->callback_handler);
+  }
+  if (env && engine->capture_ring) {
+    env->DeleteGlobalRef(engine->capture_ring);
+  }
+  if (env && engine->decode_batch_buffer) {
+    env->DeleteGlobalRef(engine->decode_batch_buffer);
+  }
+  if (env && engine->spectrum_frame_buffer) {
+    env->DeleteGlobalRef(engine->spectrum_frame_buffer);
   }
 
   delete engine;
 }
 
+jobject js8_engine_get_decode_batch_buffer(JS8Engine_Native* engine) {
+  return engine ? engine->decode_batch_buffer : nullptr;
+}
+
+jobject js8_engine_get_spectrum_buffer(JS8Engine_Native* engine) {
+  return engine ? engine->spectrum_frame_buffer : nullptr;
+}
+
 int js8_engine_start(JS8Engine_Native* engine) {
   if (!engine || !engine->engine) return 0;
   return engine->engine->start() ? 1 : 0;
@@ -521,134 +641,97 @@ int js8_engine_submit_audio(JS8Engine_Native* engine, const int16_t* samples,
   return result ? 1 : 0;
 }
 
-// Decimate raw input to the engine sample rate using the same FIR as native OboeAudioInput.
+// Hand device-rate audio to the engine; channel selection and resampling to
+// the decoder rate happen inside the core.
+static int submit_device_audio(JS8Engine_Native* engine, const int16_t* samples,
+                               size_t num_frames, int channels, int input_sample_rate) {
+  js8core::AudioInputBuffer buffer;
+  buffer.data = std::span<const std::byte>(reinterpret_cast<const std::byte*>(samples),
+                                           num_frames * static_cast<size_t>(channels) *
+                                               sizeof(int16_t));
+  buffer.format.sample_rate = input_sample_rate;
+  buffer.format.channels = channels;
+  buffer.format.sample_type = js8core::SampleType::Int16;
+  buffer.captured_at = js8core::SteadyClock::now();
+  return engine->engine->submit_capture(buffer) ? 1 : 0;
+}
+
 int js8_engine_submit_audio_raw(JS8Engine_Native* engine, const int16_t* samples,
                                 size_t num_samples, int input_sample_rate,
                                 int64_t timestamp_ns) {
+  (void)timestamp_ns;
   if (!engine || !engine->engine || !samples) return 0;
   if (input_sample_rate <= 0) return 0;
+  return submit_device_audio(engine, samples, num_samples, 1, input_sample_rate);
+}
 
-  int target_rate = engine->audio_format.sample_rate;
-  if (target_rate <= 0) return 0;
+int js8_engine_attach_capture_ring(JS8Engine_Native* engine, JNIEnv* env, jobject byte_buffer) {
+  if (!engine || !env) return 0;
 
-  if (input_sample_rate % target_rate != 0) {
-    if (engine->resample_input_rate != input_sample_rate ||
-        engine->resample_output_rate != target_rate) {
-      engine->resample_input_rate = input_sample_rate;
-      engine->resample_output_rate = target_rate;
-      engine->resample_buffer.clear();
-      engine->resample_pos = 0.0;
-      __android_log_print(ANDROID_LOG_INFO, "JS8Engine_Native",
-                         "Fractional resampler configured: input_rate=%d, target_rate=%d",
-                         input_sample_rate, target_rate);
-    }
+  js8_engine_detach_capture_ring(engine, env);
+  if (!byte_buffer) return 0;
 
-    engine->resample_buffer.reserve(engine->resample_buffer.size() + num_samples);
-    for (size_t i = 0; i < num_samples; ++i) {
-      engine->resample_buffer.push_back(static_cast<float>(samples[i]));
-    }
+  void* address = env->GetDirectBufferAddress(byte_buffer);
+  jlong capacity = env->GetDirectBufferCapacity(byte_buffer);
+  if (!address || capacity < static_cast<jlong>(sizeof(int16_t))) {
+    __android_log_print(ANDROID_LOG_ERROR, "JS8Engine_Native",
+                       "Capture ring must be a direct ByteBuffer");
+    return 0;
+  }
+  // Samples are read in place as int16_t; a sliced buffer can start on an odd byte.
+  if (reinterpret_cast<uintptr_t>(address) % alignof(int16_t) != 0) {
+    __android_log_print(ANDROID_LOG_ERROR, "JS8Engine_Native",
+                       "Capture ring must be 2-byte aligned");
+    return 0;
+  }
 
-    double step = static_cast<double>(input_sample_rate) / static_cast<double>(target_rate);
-    if (step <= 0.0) return 0;
-
-    std::vector<int16_t> resampled;
-    if (engine->resample_buffer.size() > 1) {
-      double available = static_cast<double>(engine->resample_buffer.size() - 1) - engine->resample_pos;
-      if (available > 0) {
-        std::size_t estimate = static_cast<std::size_t>(available / step) + 1;
-        resampled.reserve(estimate);
-        while (engine->resample_pos + 1.0 < engine->resample_buffer.size()) {
-          std::size_t idx = static_cast<std::size_t>(engine->resample_pos);
-          double frac = engine->resample_pos - static_cast<double>(idx);
-          float a = engine->resample_buffer[idx];
-          float b = engine->resample_buffer[idx + 1];
-          float sample = a + static_cast<float>(frac) * (b - a);
-          int value = static_cast<int>(std::lrint(sample));
-          value = std::clamp(value,
-                             static_cast<int>(std::numeric_limits<int16_t>::min()),
-                             static_cast<int>(std::numeric_limits<int16_t>::max()));
-          resampled.push_back(static_cast<int16_t>(value));
-          engine->resample_pos += step;
-        }
-      }
-    }
+  // Hold a global ref so the backing memory stays valid while native code reads it.
+  engine->capture_ring = env->NewGlobalRef(byte_buffer);
+  engine->capture_ring_data = static_cast<const int16_t*>(address);
+  engine->capture_ring_samples = static_cast<size_t>(capacity) / sizeof(int16_t);
 
-    if (!resampled.empty()) {
-      std::size_t drop = static_cast<std::size_t>(engine->resample_pos);
-      if (drop > 0) {
-        if (drop >= engine->resample_buffer.size()) {
-          engine->resample_buffer.clear();
-          engine->resample_pos = 0.0;
-        } else {
-          engine->resample_buffer.erase(
-              engine->resample_buffer.begin(),
-              engine->resample_buffer.begin() +
-                  static_cast<std::vector<float>::difference_type>(drop));
-          engine->resample_pos -= static_cast<double>(drop);
-        }
-      }
-      return js8_engine_submit_audio(engine, resampled.data(), resampled.size(), timestamp_ns);
-    }
+  __android_log_print(ANDROID_LOG_INFO, "JS8Engine_Native",
+                     "Capture ring attached: %zu samples", engine->capture_ring_samples);
+  return static_cast<int>(engine->capture_ring_samples);
+}
 
-    return 0;
+void js8_engine_detach_capture_ring(JS8Engine_Native* engine, JNIEnv* env) {
+  if (!engine) return;
+  if (env && engine->capture_ring) {
+    env->DeleteGlobalRef(engine->capture_ring);
   }
+  engine->capture_ring = nullptr;
+  engine->capture_ring_data = nullptr;
+  engine->capture_ring_samples = 0;
+}
 
-  int factor = input_sample_rate / target_rate;
-
-  // Rebuild taps/buffer if factor changed or not initialized.
-  if (factor != engine->decimation_factor || engine->decimation_taps.empty()) {
-    engine->decimation_factor = factor;
-    engine->decimation_taps = js8core::dsp::make_js8_fir(input_sample_rate, target_rate);
-    engine->decimation_mirror = static_cast<int>(engine->decimation_taps.size());
-    engine->decimation_buffer.assign(engine->decimation_mirror * 2, 0);
-    engine->decimation_pos = 0;
-    __android_log_print(ANDROID_LOG_INFO, "JS8Engine_Native",
-                       "Decimator configured: input_rate=%d, target_rate=%d, factor=%d, taps=%zu",
-                       input_sample_rate, target_rate, factor, engine->decimation_taps.size());
-    engine->resample_buffer.clear();
-    engine->resample_pos = 0.0;
-    engine->resample_input_rate = 0;
-    engine->resample_output_rate = 0;
+int js8_engine_submit_capture_ring(JS8Engine_Native* engine, size_t offset_samples,
+                                   size_t num_frames, int channels, int input_sample_rate,
+                                   int64_t timestamp_ns) {
+  if (!engine || !engine->engine || !engine->capture_ring_data) return -1;
+  if (input_sample_rate <= 0 || channels <= 0) return -1;
+
+  size_t total = num_frames * static_cast<size_t>(channels);
+  if (offset_samples > engine->capture_ring_samples ||
+      total > engine->capture_ring_samples - offset_samples) {
+    return -1;
   }
+  if (num_frames == 0) return 0;
 
-  std::vector<int16_t> decimated;
-  if (factor <= 1) {
-    decimated.assign(samples, samples + num_samples);
-  } else {
-    decimated.reserve(num_samples / static_cast<size_t>(factor) + 1);
-    int taps = static_cast<int>(engine->decimation_taps.size());
-    int mirror = engine->decimation_mirror;
-
-    for (size_t i = 0; i < num_samples; ++i) {
-      int16_t sample = samples[i];
-      engine->decimation_buffer[engine->decimation_pos] = sample;
-      engine->decimation_buffer[engine->decimation_pos + mirror] = sample;
-      engine->decimation_pos = (engine->decimation_pos + 1) % mirror;
-
-      if ((static_cast<int>(i) % factor) == factor - 1) {
-        double acc = 0.0;
-        int read_pos = (engine->decimation_pos - 1 + mirror) % mirror;
-        for (int j = 0; j < taps; ++j) {
-          int idx = (read_pos - j + mirror) % mirror;
-          acc += static_cast<double>(engine->decimation_taps[j]) *
-                 static_cast<double>(engine->decimation_buffer[idx]);
-        }
-        int value = static_cast<int>(std::lrint(acc));
-        value = std::clamp(value,
-                           static_cast<int>(std::numeric_limits<int16_t>::min()),
-                           static_cast<int>(std::numeric_limits<int16_t>::max()));
-        decimated.push_back(static_cast<int16_t>(value));
-      }
-    }
+  (void)timestamp_ns;
+  const int16_t* block = engine->capture_ring_data + offset_samples;
+  int peak = 0;
+  for (size_t i = 0; i < total; ++i) {
+    peak = std::max(peak, std::abs(static_cast<int>(block[i])));
   }
 
-  return js8_engine_submit_audio(engine, decimated.data(), decimated.size(), timestamp_ns);
+  if (!submit_device_audio(engine, block, num_frames, channels, input_sample_rate)) return -1;
+  return peak;
 }
 
 void js8_engine_set_frequency(JS8Engine_Native* engine, uint64_t frequency_hz) {
-  // TODO: Implement frequency setting through engine API
-  (void)engine;
-  (void)frequency_hz;
+  if (!engine || !engine->engine) return;
+  engine->engine->set_dial_frequency(frequency_hz);
 }
 
 void js8_engine_set_submodes(JS8Engine_Native* engine, int submodes) {
@@ -736,12 +819,32 @@ int js8_engine_is_transmitting_audio(JS8Engine_Native* engine) {
   return engine->engine->is_transmitting_audio() ? 1 : 0;
 }
 
+int js8_engine_start_recording(JS8Engine_Native* engine, const char* path) {
+  if (!engine || !engine->engine || !path) return 0;
+  return engine->engine->start_recording(path) ? 1 : 0;
+}
+
+void js8_engine_stop_recording(JS8Engine_Native* engine) {
+  if (!engine || !engine->engine) return;
+  engine->engine->stop_recording();
+}
+
 int js8_engine_is_running(JS8Engine_Native* engine) {
   if (!engine || !engine->engine) return 0;
   // TODO: Add is_running() method to engine interface
   return 1;  // Assume running if engine exists
 }
 
+void js8_trace_set_enabled(int enabled) {
+  js8core::trace::set_enabled(enabled != 0);
+}
+
+jstring js8_trace_dump(JNIEnv* env) {
+  if (!env) return nullptr;
+  std::string json = js8core::trace::dump_json();
+  return env->NewStringUTF(json.c_str());
+}
+
 int js8_register_natives(JavaVM* vm, JNIEnv* env) {
   g_jvm = vm;
 
@@ -753,13 +856,21 @@ int js8_register_natives(JavaVM* vm, JNIEnv* env) {
 
   // Map Kotlin Companion method to static method
   JNINativeMethod methods[] = {
-    {"nativeCreate", "(Lcom/js8call/core/JS8Engine$CallbackHandler;II)J",
+    {"nativeCreate", "(Lcom/js8call/core/JS8Engine$EventBridge;II)J",
      (void*)Java_com_js8call_core_JS8Engine_00024Companion_nativeCreate},
+    {"nativeGetDecodeBatchBuffer", "(J)Ljava/nio/ByteBuffer;",
+     (void*)Java_com_js8call_core_JS8Engine_nativeGetDecodeBatchBuffer},
+    {"nativeGetSpectrumBuffer", "(J)Ljava/nio/ByteBuffer;",
+     (void*)Java_com_js8call_core_JS8Engine_nativeGetSpectrumBuffer},
     {"nativeStart", "(J)Z", (void*)Java_com_js8call_core_JS8Engine_nativeStart},
     {"nativeStop", "(J)V", (void*)Java_com_js8call_core_JS8Engine_nativeStop},
     {"nativeDestroy", "(J)V", (void*)Java_com_js8call_core_JS8Engine_nativeDestroy},
     {"nativeSubmitAudio", "(J[SIJ)Z", (void*)Java_com_js8call_core_JS8Engine_nativeSubmitAudio},
     {"nativeSubmitAudioRaw", "(J[SIIJ)Z", (void*)Java_com_js8call_core_JS8Engine_nativeSubmitAudioRaw},
+    {"nativeAttachCaptureRing", "(JLjava/nio/ByteBuffer;)I",
+     (void*)Java_com_js8call_core_JS8Engine_nativeAttachCaptureRing},
+    {"nativeDetachCaptureRing", "(J)V", (void*)Java_com_js8call_core_JS8Engine_nativeDetachCaptureRing},
+    {"nativeSubmitCaptureRing", "(JIIIIJ)I", (void*)Java_com_js8call_core_JS8Engine_nativeSubmitCaptureRing},
     {"nativeSetFrequency", "(JJ)V", (void*)Java_com_js8call_core_JS8Engine_nativeSetFrequency},
     {"nativeSetSubmodes", "(JI)V", (void*)Java_com_js8call_core_JS8Engine_nativeSetSubmodes},
     {"nativeSetOutputDevice", "(JI)V", (void*)Java_com_js8call_core_JS8Engine_nativeSetOutputDevice},
@@ -776,7 +887,15 @@ int js8_register_natives(JavaVM* vm, JNIEnv* env) {
      (void*)Java_com_js8call_core_JS8Engine_nativeIsTransmitting},
     {"nativeIsTransmittingAudio", "(J)Z",
      (void*)Java_com_js8call_core_JS8Engine_nativeIsTransmittingAudio},
-    {"nativeIsRunning", "(J)Z", (void*)Java_com_js8call_core_JS8Engine_nativeIsRunning}
+    {"nativeStartRecording", "(JLjava/lang/String;)Z",
+     (void*)Java_com_js8call_core_JS8Engine_nativeStartRecording},
+    {"nativeStopRecording", "(J)V",
+     (void*)Java_com_js8call_core_JS8Engine_nativeStopRecording},
+    {"nativeIsRunning", "(J)Z", (void*)Java_com_js8call_core_JS8Engine_nativeIsRunning},
+    {"nativeSetTracingEnabled", "(Z)V",
+     (void*)Java_com_js8call_core_JS8Engine_00024Companion_nativeSetTracingEnabled},
+    {"nativeDumpTrace", "()Ljava/lang/String;",
+     (void*)Java_com_js8call_core_JS8Engine_00024Companion_nativeDumpTrace}
   };
 
   int num_methods = sizeof(methods) / sizeof(methods[0]);
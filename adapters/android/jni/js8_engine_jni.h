@@ -17,10 +17,26 @@ void js8_engine_destroy(JS8Engine_Native* engine);
 int js8_engine_start(JS8Engine_Native* engine);
 void js8_engine_stop(JS8Engine_Native* engine);
 
+// Shared event buffers (direct ByteBuffers owned by the native engine).
+// Decodes are delivered per cycle through onDecodeBatch(count, bytes); spectrum
+// frames overwrite the spectrum buffer and are announced via onSpectrumFrame().
+jobject js8_engine_get_decode_batch_buffer(JS8Engine_Native* engine);
+jobject js8_engine_get_spectrum_buffer(JS8Engine_Native* engine);
+
 // Audio submission
 int js8_engine_submit_audio(JS8Engine_Native* engine, const int16_t* samples, size_t num_samples, int64_t timestamp_ns);
 int js8_engine_submit_audio_raw(JS8Engine_Native* engine, const int16_t* samples, size_t num_samples, int input_sample_rate, int64_t timestamp_ns);
 
+// Zero-copy capture: Kotlin owns a direct ByteBuffer of interleaved int16 frames that
+// AudioRecord fills; native code reads committed blocks from it in place.
+// attach returns the ring capacity in samples (0 on failure, including a buffer that
+// isn't 2-byte aligned); submit returns the peak magnitude of the block, or -1 if it
+// was rejected by either this layer or the engine. Input may be at any device
+// rate and channel count; the engine resamples to the decoder rate.
+int js8_engine_attach_capture_ring(JS8Engine_Native* engine, JNIEnv* env, jobject byte_buffer);
+void js8_engine_detach_capture_ring(JS8Engine_Native* engine, JNIEnv* env);
+int js8_engine_submit_capture_ring(JS8Engine_Native* engine, size_t offset_samples, size_t num_frames, int channels, int input_sample_rate, int64_t timestamp_ns);
+
 // Configuration
 void js8_engine_set_frequency(JS8Engine_Native* engine, uint64_t frequency_hz);
 void js8_engine_set_submodes(JS8Engine_Native* engine, int submodes);
@@ -52,9 +68,17 @@ void js8_engine_stop_transmit(JS8Engine_Native* engine);
 int js8_engine_is_transmitting(JS8Engine_Native* engine);
 int js8_engine_is_transmitting_audio(JS8Engine_Native* engine);
 
+// Capture recording (see js8core/recording.hpp); returns 0 if the file cannot be created.
+int js8_engine_start_recording(JS8Engine_Native* engine, const char* path);
+void js8_engine_stop_recording(JS8Engine_Native* engine);
+
 // Status queries
 int js8_engine_is_running(JS8Engine_Native* engine);
 
+// Timeline tracing (process-wide). The dump is Chrome trace-event JSON.
+void js8_trace_set_enabled(int enabled);
+jstring js8_trace_dump(JNIEnv* env);
+
 // JNI registration
 int js8_register_natives(JavaVM* vm, JNIEnv* env);
 
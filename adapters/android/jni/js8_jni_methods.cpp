@@ -57,6 +57,24 @@ Java_com_js8call_core_JS8Engine_00024Companion_nativeCreate(
   return reinterpret_cast<jlong>(engine);
 }
 
+JNIEXPORT jobject JNICALL
+Java_com_js8call_core_JS8Engine_nativeGetDecodeBatchBuffer(
+    JNIEnv* /* env */,
+    jobject /* thiz */,
+    jlong handle) {
+  JS8Engine_Native* engine = reinterpret_cast<JS8Engine_Native*>(handle);
+  return js8_engine_get_decode_batch_buffer(engine);
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_js8call_core_JS8Engine_nativeGetSpectrumBuffer(
+    JNIEnv* /* env */,
+    jobject /* thiz */,
+    jlong handle) {
+  JS8Engine_Native* engine = reinterpret_cast<JS8Engine_Native*>(handle);
+  return js8_engine_get_spectrum_buffer(engine);
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_js8call_core_JS8Engine_nativeStart(
     JNIEnv* /* env */,
@@ -152,6 +170,46 @@ Java_com_js8call_core_JS8Engine_nativeSubmitAudioRaw(
   return result ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT jint JNICALL
+Java_com_js8call_core_JS8Engine_nativeAttachCaptureRing(
+    JNIEnv* env,
+    jobject /* thiz */,
+    jlong handle,
+    jobject byte_buffer) {
+  JS8Engine_Native* engine = reinterpret_cast<JS8Engine_Native*>(handle);
+  return static_cast<jint>(js8_engine_attach_capture_ring(engine, env, byte_buffer));
+}
+
+JNIEXPORT void JNICALL
+Java_com_js8call_core_JS8Engine_nativeDetachCaptureRing(
+    JNIEnv* env,
+    jobject /* thiz */,
+    jlong handle) {
+  JS8Engine_Native* engine = reinterpret_cast<JS8Engine_Native*>(handle);
+  js8_engine_detach_capture_ring(engine, env);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_js8call_core_JS8Engine_nativeSubmitCaptureRing(
+    JNIEnv* /* env */,
+    jobject /* thiz */,
+    jlong handle,
+    jint offset_samples,
+    jint num_frames,
+    jint channels,
+    jint input_sample_rate_hz,
+    jlong timestamp_ns) {
+  JS8Engine_Native* engine = reinterpret_cast<JS8Engine_Native*>(handle);
+  if (offset_samples < 0 || num_frames < 0) return -1;
+  return static_cast<jint>(js8_engine_submit_capture_ring(
+      engine,
+      static_cast<size_t>(offset_samples),
+      static_cast<size_t>(num_frames),
+      static_cast<int>(channels),
+      static_cast<int>(input_sample_rate_hz),
+      timestamp_ns));
+}
+
 JNIEXPORT void JNICALL
 Java_com_js8call_core_JS8Engine_nativeSetFrequency(
     JNIEnv* /* env */,
@@ -293,6 +351,26 @@ Java_com_js8call_core_JS8Engine_nativeIsTransmittingAudio(
   return js8_engine_is_transmitting_audio(engine) ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_js8call_core_JS8Engine_nativeStartRecording(
+    JNIEnv* env,
+    jobject /* thiz */,
+    jlong handle,
+    jstring path) {
+  JS8Engine_Native* engine = reinterpret_cast<JS8Engine_Native*>(handle);
+  auto path_utf8 = to_utf8(env, path);
+  return js8_engine_start_recording(engine, path_utf8.c_str()) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_js8call_core_JS8Engine_nativeStopRecording(
+    JNIEnv* /* env */,
+    jobject /* thiz */,
+    jlong handle) {
+  JS8Engine_Native* engine = reinterpret_cast<JS8Engine_Native*>(handle);
+  js8_engine_stop_recording(engine);
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_js8call_core_JS8Engine_nativeIsRunning(
     JNIEnv* /* env */,
@@ -302,6 +380,21 @@ Java_com_js8call_core_JS8Engine_nativeIsRunning(
   return js8_engine_is_running(engine) ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT void JNICALL
+Java_com_js8call_core_JS8Engine_00024Companion_nativeSetTracingEnabled(
+    JNIEnv* /* env */,
+    jobject /* thiz */,
+    jboolean enabled) {
+  js8_trace_set_enabled(enabled == JNI_TRUE ? 1 : 0);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_js8call_core_JS8Engine_00024Companion_nativeDumpTrace(
+    JNIEnv* env,
+    jobject /* thiz */) {
+  return js8_trace_dump(env);
+}
+
 JNIEXPORT jobjectArray JNICALL
 Java_com_js8call_core_HamlibRigCatalog_nativeListRigModels(
     JNIEnv* env,
@@ -33,6 +33,7 @@ class JS8AudioHelper(
     companion object {
         private const val DEFAULT_CHANNEL_CONFIG = AudioFormat.CHANNEL_IN_MONO
         private const val AUDIO_FORMAT = AudioFormat.ENCODING_PCM_16BIT
+        private const val CAPTURE_RING_SLOTS = 4
     }
 
     private var audioRecord: AudioRecord? = null
@@ -184,18 +185,10 @@ class JS8AudioHelper(
                 "Audio capture started: requested $captureSampleRate Hz, actual $actualSampleRate Hz, " +
                 "target $targetSampleRate Hz, source=${audioSourceName(audioSource)}, " +
                 "deviceType=${deviceTypeName(preferredDeviceType)}, " +
-                "handing raw audio to native downsampler " +
+                "handing raw audio to the engine resampler " +
                 "(resample ratio: ${"%.3f".format(resampleRatio)}), " +
                 "channels=$inputChannelCount, buffer size: $bufferSizeBytes bytes")
 
-            if (actualSampleRate % targetSampleRate != 0) {
-                android.util.Log.i(
-                    "JS8AudioHelper",
-                    "Actual sample rate $actualSampleRate not divisible by target $targetSampleRate; " +
-                        "using fractional resampler"
-                )
-            }
-
             // Start recording thread
             recordingThread = HandlerThread("JS8AudioCapture", Process.THREAD_PRIORITY_AUDIO).apply {
                 start()
@@ -240,89 +233,85 @@ class JS8AudioHelper(
         } else {
             (bufferFrames / 2).coerceIn(256, 2048)
         }
-        val buffer = ShortArray(framesPerRead * channels)
-        val monoBuffer = if (channels > 1) ShortArray(framesPerRead) else null
+
+        // AudioRecord writes straight into a direct ring that native code reads in
+        // place, so no ShortArray is copied across JNI. AudioRecord ignores the buffer
+        // position, hence one pre-built slice per slot.
+        val slotSamples = framesPerRead * channels
+        val slotBytes = slotSamples * 2
+        val ring = ByteBuffer.allocateDirect(slotBytes * CAPTURE_RING_SLOTS)
+            .order(ByteOrder.nativeOrder())
+        val slots = Array(CAPTURE_RING_SLOTS) { index ->
+            val view = ring.duplicate()
+            view.position(index * slotBytes)
+            view.limit((index + 1) * slotBytes)
+            view.slice().order(ByteOrder.nativeOrder())
+        }
+        if (engine.attachCaptureRing(ring) < slotSamples * CAPTURE_RING_SLOTS) {
+            android.util.Log.e("JS8AudioHelper", "Failed to attach capture ring")
+            return
+        }
+
+        var slotIndex = 0
         var totalSamples = 0L
         var lastLogTime = System.currentTimeMillis()
-        var lastReadNs = System.nanoTime()
 
-        while (isRecording) {
-            val readStartNs = System.nanoTime()
-            val samplesRead = recorder.read(buffer, 0, buffer.size)
-            val readEndNs = System.nanoTime()
-            lastReadNs = readEndNs
+        try {
+            while (isRecording) {
+                val slot = slots[slotIndex]
+                val bytesRead = recorder.read(slot, slotBytes)
 
-            if (samplesRead > 0) {
-                val timestamp = System.nanoTime()
-                val success = if (channels > 1) {
+                if (bytesRead > 0) {
+                    val timestamp = System.nanoTime()
+                    val samplesRead = bytesRead / 2
                     val framesRead = samplesRead / channels
-                    if (framesRead <= 0) {
-                        false
+                    val peak = if (framesRead > 0) {
+                        engine.submitCaptureRing(
+                            slotIndex * slotSamples,
+                            framesRead,
+                            channels,
+                            actualSampleRate,
+                            timestamp
+                        )
                     } else {
-                        val out = monoBuffer ?: ShortArray(framesRead)
-                        val sums = LongArray(channels)
-                        val maxAbs = IntArray(channels)
-                        for (i in 0 until framesRead) {
-                            val base = i * channels
-                            for (ch in 0 until channels) {
-                                val value = kotlin.math.abs(buffer[base + ch].toInt())
-                                sums[ch] += value.toLong()
-                                if (value > maxAbs[ch]) {
-                                    maxAbs[ch] = value
-                                }
-                            }
-                        }
-                        var bestChannel = 0
-                        for (ch in 1 until channels) {
-                            if (sums[ch] > sums[bestChannel]) {
-                                bestChannel = ch
-                            }
-                        }
-                        for (i in 0 until framesRead) {
-                            out[i] = buffer[i * channels + bestChannel]
-                        }
-                        lastAbsMax = maxAbs[bestChannel]
-                        engine.submitAudioRaw(out, framesRead, actualSampleRate, timestamp)
+                        -1
                     }
-                } else {
-                    var maxAbs = 0
-                    for (i in 0 until samplesRead) {
-                        val value = kotlin.math.abs(buffer[i].toInt())
-                        if (value > maxAbs) {
-                            maxAbs = value
-                        }
+                    val success = peak >= 0
+                    if (success) {
+                        lastAbsMax = peak
+                    } else {
+                        android.util.Log.w("JS8AudioHelper", "submitCaptureRing failed for $samplesRead samples")
                     }
-                    lastAbsMax = maxAbs
-                    engine.submitAudioRaw(buffer, samplesRead, actualSampleRate, timestamp)
-                }
-                if (!success) {
-                    android.util.Log.w("JS8AudioHelper", "submitAudioRaw failed for $samplesRead samples")
-                }
 
-                totalSamples += samplesRead
-
-                // Log every second
-                val now = System.currentTimeMillis()
-                if (now - lastLogTime >= 1000) {
-                    val sampleRate = totalSamples / ((now - lastLogTime) / 1000f)
-                    android.util.Log.d("JS8AudioHelper",
-                        "Audio: $samplesRead samples @ ${captureSampleRate}Hz (raw), " +
-                        "success=$success, rate=${sampleRate.toInt()} samples/sec, " +
-                        "channels=$channels, first3=[${buffer[0]}, ${buffer[1]}, ${buffer[2]}]")
-                    lastLogTime = now
-                    totalSamples = 0
-                }
-            } else if (samplesRead < 0) {
-                // Error occurred
-                when (samplesRead) {
-                    AudioRecord.ERROR_INVALID_OPERATION,
-                    AudioRecord.ERROR_BAD_VALUE,
-                    AudioRecord.ERROR_DEAD_OBJECT -> {
-                        isRecording = false
-                        break
+                    totalSamples += samplesRead
+
+                    // Log every second
+                    val now = System.currentTimeMillis()
+                    if (now - lastLogTime >= 1000) {
+                        val sampleRate = totalSamples / ((now - lastLogTime) / 1000f)
+                        android.util.Log.d("JS8AudioHelper",
+                            "Audio: $samplesRead samples @ ${captureSampleRate}Hz (raw), " +
+                            "success=$success, rate=${sampleRate.toInt()} samples/sec, " +
+                            "channels=$channels, first3=[${slot.getShort(0)}, ${slot.getShort(2)}, ${slot.getShort(4)}]")
+                        lastLogTime = now
+                        totalSamples = 0
+                    }
+
+                    slotIndex = (slotIndex + 1) % CAPTURE_RING_SLOTS
+                } else if (bytesRead < 0) {
+                    // Error occurred
+                    when (bytesRead) {
+                        AudioRecord.ERROR_INVALID_OPERATION,
+                        AudioRecord.ERROR_BAD_VALUE,
+                        AudioRecord.ERROR_DEAD_OBJECT -> {
+                            isRecording = false
+                            break
+                        }
                     }
                 }
             }
+        } finally {
+            engine.detachCaptureRing()
         }
     }
 
@@ -529,6 +518,64 @@ class UIThreadCallbackAdapter(
         }
     }
 
+    // The batch view is only valid on the native thread, so copy the records and
+    // replay them from a single posted runnable.
+    override fun onDecodeBatch(batch: DecodeBatch) {
+        if (batch.size == 0) return
+        val utc = IntArray(batch.size) { batch.utc(it) }
+        val snr = IntArray(batch.size) { batch.snr(it) }
+        val dt = FloatArray(batch.size) { batch.dt(it) }
+        val freq = FloatArray(batch.size) { batch.freq(it) }
+        val text = Array(batch.size) { batch.text(it) }
+        val type = IntArray(batch.size) { batch.type(it) }
+        val quality = FloatArray(batch.size) { batch.quality(it) }
+        val mode = IntArray(batch.size) { batch.mode(it) }
+        handler.post {
+            for (i in utc.indices) {
+                delegate.onDecoded(utc[i], snr[i], dt[i], freq[i], text[i], type[i], quality[i], mode[i])
+            }
+        }
+    }
+
+    // Spectrum frames are latest-wins: the newest frame is staged in a reused
+    // array and at most one delivery is queued on the handler at a time.
+    private val spectrumLock = Any()
+    private var spectrumBins = FloatArray(0)
+    private var spectrumCount = 0
+    private var spectrumBinHz = 0f
+    private var spectrumPowerDb = 0f
+    private var spectrumPeakDb = 0f
+    private var spectrumPending = false
+    private val deliverSpectrum = Runnable {
+        val bins: FloatArray
+        val binHz: Float
+        val powerDb: Float
+        val peakDb: Float
+        synchronized(spectrumLock) {
+            bins = spectrumBins.copyOf(spectrumCount)
+            binHz = spectrumBinHz
+            powerDb = spectrumPowerDb
+            peakDb = spectrumPeakDb
+            spectrumPending = false
+        }
+        delegate.onSpectrum(bins, binHz, powerDb, peakDb)
+    }
+
+    override fun onSpectrumFrame(frame: SpectrumFrame) {
+        synchronized(spectrumLock) {
+            if (spectrumBins.size < frame.binCount) {
+                spectrumBins = FloatArray(frame.binCount)
+            }
+            spectrumCount = frame.copyBins(spectrumBins)
+            spectrumBinHz = frame.binHz
+            spectrumPowerDb = frame.powerDb
+            spectrumPeakDb = frame.peakDb
+            if (spectrumPending) return
+            spectrumPending = true
+        }
+        handler.post(deliverSpectrum)
+    }
+
     override fun onDecodeStarted(submodes: Int) {
         handler.post {
             delegate.onDecodeStarted(submodes)
@@ -541,6 +588,12 @@ class UIThreadCallbackAdapter(
         }
     }
 
+    override fun onDecodeMetrics(metrics: DecodeMetrics) {
+        handler.post {
+            delegate.onDecodeMetrics(metrics)
+        }
+    }
+
     override fun onError(message: String) {
         handler.post {
             delegate.onError(message)
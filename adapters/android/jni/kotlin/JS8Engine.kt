@@ -1,5 +1,7 @@
 package com.js8call.core
 
+import java.nio.ByteBuffer
+
 /**
  * Native JS8Call engine wrapper for Android.
  *
@@ -28,16 +30,40 @@ class JS8Engine private constructor(
             submodes: Int = 0x1F, // default to A/B/C/E/I like desktop
             callbackHandler: CallbackHandler
         ): JS8Engine {
-            val handle = nativeCreate(callbackHandler, sampleRateHz, submodes)
+            val bridge = EventBridge(callbackHandler)
+            val handle = nativeCreate(bridge, sampleRateHz, submodes)
             if (handle == 0L) {
                 throw RuntimeException("Failed to create native JS8 engine")
             }
-            return JS8Engine(handle, callbackHandler)
+            val engine = JS8Engine(handle, callbackHandler)
+            bridge.attach(
+                engine.nativeGetDecodeBatchBuffer(handle),
+                engine.nativeGetSpectrumBuffer(handle)
+            )
+            return engine
         }
 
+        /**
+         * Record a timeline of engine, decoder and TX spans (process-wide).
+         * Costs next to nothing while disabled.
+         */
+        fun setTracingEnabled(enabled: Boolean) = nativeSetTracingEnabled(enabled)
+
+        /**
+         * Spans recorded so far as Chrome trace-event JSON; save it to a file
+         * and open it in chrome://tracing or ui.perfetto.dev.
+         */
+        fun dumpTrace(): String = nativeDumpTrace()
+
+        @JvmStatic
+        private external fun nativeSetTracingEnabled(enabled: Boolean)
+
+        @JvmStatic
+        private external fun nativeDumpTrace(): String
+
         @JvmStatic
         private external fun nativeCreate(
-            callbackHandler: CallbackHandler,
+            bridge: EventBridge,
             sampleRateHz: Int,
             submodes: Int
         ): Long
@@ -73,7 +99,7 @@ class JS8Engine private constructor(
     }
 
     /**
-     * Submit raw audio at a higher rate; native code will decimate to the engine rate.
+     * Submit raw audio at the device rate; the engine resamples it to the decoder rate.
      *
      * @param samples   Audio samples (16-bit PCM, mono)
      * @param numSamples Number of valid samples in the array
@@ -90,6 +116,56 @@ class JS8Engine private constructor(
         return nativeSubmitAudioRaw(nativeHandle, samples, numSamples, inputSampleRateHz, timestampNs)
     }
 
+    /**
+     * Share a capture ring with native code for zero-copy submission.
+     *
+     * The buffer must be a direct ByteBuffer in native byte order holding interleaved
+     * 16-bit PCM, starting on a 2-byte boundary. Native code keeps a reference until
+     * [detachCaptureRing] or [close].
+     *
+     * @param ring Direct buffer that the audio source writes into
+     * @return Ring capacity in samples, or 0 if the buffer was rejected
+     */
+    fun attachCaptureRing(ring: ByteBuffer): Int {
+        checkNotClosed()
+        require(ring.isDirect) { "Capture ring must be a direct ByteBuffer" }
+        return nativeAttachCaptureRing(nativeHandle, ring)
+    }
+
+    /**
+     * Release the capture ring previously passed to [attachCaptureRing].
+     */
+    fun detachCaptureRing() {
+        if (nativeHandle != 0L) {
+            nativeDetachCaptureRing(nativeHandle)
+        }
+    }
+
+    /**
+     * Hand a block already written into the capture ring to the engine.
+     * The engine reads the interleaved samples directly from the ring, follows
+     * the loudest channel and resamples to the decoder rate.
+     *
+     * @param offsetSamples Start of the block in the ring, in 16-bit samples
+     * @param numFrames Number of interleaved frames in the block
+     * @param channels Channels per frame
+     * @param inputSampleRateHz Sample rate of the captured data
+     * @param timestampNs Capture timestamp in nanoseconds
+     * @return Peak magnitude of the block, or -1 if it was rejected
+     */
+    fun submitCaptureRing(
+        offsetSamples: Int,
+        numFrames: Int,
+        channels: Int,
+        inputSampleRateHz: Int,
+        timestampNs: Long = System.nanoTime()
+    ): Int {
+        checkNotClosed()
+        return nativeSubmitCaptureRing(
+            nativeHandle, offsetSamples, numFrames, channels, inputSampleRateHz, timestampNs
+        )
+    }
+
     /**
      * Set the operating frequency.
      *
@@ -100,6 +176,26 @@ class JS8Engine private constructor(
         nativeSetFrequency(nativeHandle, frequencyHz)
     }
 
+    /**
+     * Record the decoder-rate capture stream, with timestamps and dial changes,
+     * for offline replay (js8core-replay). Fails if a recording is already in progress.
+     *
+     * @param path File to create
+     * @return true if the file was opened
+     */
+    fun startRecording(path: String): Boolean {
+        checkNotClosed()
+        return nativeStartRecording(nativeHandle, path)
+    }
+
+    /**
+     * Stop and flush the current capture recording, if any.
+     */
+    fun stopRecording() {
+        checkNotClosed()
+        nativeStopRecording(nativeHandle)
+    }
+
     /**
      * Set enabled submodes.
      *
@@ -241,7 +337,42 @@ class JS8Engine private constructor(
         }
     }
 
+    /**
+     * Receives events from native code and fans them out to the [CallbackHandler].
+     * Decodes arrive once per decode cycle and spectrum frames through a shared
+     * buffer, so nothing is allocated per event on the JNI path.
+     */
+    private class EventBridge(private val handler: CallbackHandler) {
+        private var decodeBatch: DecodeBatch? = null
+        private var spectrumFrame: SpectrumFrame? = null
+
+        fun attach(decodeBuffer: ByteBuffer?, spectrumBuffer: ByteBuffer?) {
+            decodeBatch = decodeBuffer?.let { DecodeBatch(it) }
+            spectrumFrame = spectrumBuffer?.let { SpectrumFrame(it) }
+        }
+
+        fun onDecodeBatch(count: Int, bytes: Int) {
+            val batch = decodeBatch ?: return
+            batch.reset(count, bytes)
+            handler.onDecodeBatch(batch)
+        }
+
+        fun onSpectrumFrame() {
+            val frame = spectrumFrame ?: return
+            handler.onSpectrumFrame(frame)
+        }
+
+        fun onDecodeStarted(submodes: Int) = handler.onDecodeStarted(submodes)
+        fun onDecodeFinished(count: Int) = handler.onDecodeFinished(count)
+        fun onDecodeMetrics(submodes: Int, passes: Int, tried: Int, decoded: Int, stageNanos: LongArray) =
+            handler.onDecodeMetrics(DecodeMetrics(submodes, passes, tried, decoded, stageNanos))
+        fun onError(message: String) = handler.onError(message)
+        fun onLog(level: Int, message: String) = handler.onLog(level, message)
+    }
+
     // Native methods
+    private external fun nativeGetDecodeBatchBuffer(handle: Long): ByteBuffer?
+    private external fun nativeGetSpectrumBuffer(handle: Long): ByteBuffer?
     private external fun nativeStart(handle: Long): Boolean
     private external fun nativeStop(handle: Long)
     private external fun nativeDestroy(handle: Long)
@@ -258,10 +389,22 @@ class JS8Engine private constructor(
         inputSampleRateHz: Int,
         timestampNs: Long
     ): Boolean
+    private external fun nativeAttachCaptureRing(handle: Long, ring: ByteBuffer): Int
+    private external fun nativeDetachCaptureRing(handle: Long)
+    private external fun nativeSubmitCaptureRing(
+        handle: Long,
+        offsetSamples: Int,
+        numFrames: Int,
+        channels: Int,
+        inputSampleRateHz: Int,
+        timestampNs: Long
+    ): Int
     private external fun nativeSetFrequency(handle: Long, frequencyHz: Long)
     private external fun nativeSetSubmodes(handle: Long, submodes: Int)
     private external fun nativeSetOutputDevice(handle: Long, deviceId: Int)
     private external fun nativeSetTxBoostEnabled(handle: Long, enabled: Boolean)
+    private external fun nativeStartRecording(handle: Long, path: String): Boolean
+    private external fun nativeStopRecording(handle: Long)
     private external fun nativeIsRunning(handle: Long): Boolean
     private external fun nativeTransmitMessage(
         handle: Long,
@@ -296,8 +439,38 @@ class JS8Engine private constructor(
     /**
      * Callback interface for engine events.
      * All callbacks are invoked on a native thread.
+     *
+     * Native code delivers decodes as a [DecodeBatch] per decode cycle and spectra
+     * as a shared [SpectrumFrame]. The default implementations unpack these into
+     * [onDecoded] and [onSpectrum]; override them to avoid per-event allocation.
      */
     interface CallbackHandler {
+        /**
+         * Called once per decode cycle with everything decoded in it,
+         * just before [onDecodeFinished].
+         */
+        fun onDecodeBatch(batch: DecodeBatch) {
+            for (i in 0 until batch.size) {
+                onDecoded(
+                    batch.utc(i),
+                    batch.snr(i),
+                    batch.dt(i),
+                    batch.freq(i),
+                    batch.text(i),
+                    batch.type(i),
+                    batch.quality(i),
+                    batch.mode(i)
+                )
+            }
+        }
+
+        /**
+         * Called when a new spectrum frame has been written to the shared buffer.
+         */
+        fun onSpectrumFrame(frame: SpectrumFrame) {
+            onSpectrum(frame.copyBins(), frame.binHz, frame.powerDb, frame.peakDb)
+        }
+
         /**
          * Called when a message is decoded.
          */
@@ -332,6 +505,12 @@ class JS8Engine private constructor(
          */
         fun onDecodeFinished(count: Int)
 
+        /**
+         * Called once per decode cycle, just before [onDecodeFinished], with
+         * per-stage timing and candidate counts.
+         */
+        fun onDecodeMetrics(metrics: DecodeMetrics) {}
+
         /**
          * Called on engine errors.
          */
@@ -0,0 +1,131 @@
+package com.js8call.core
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.FloatBuffer
+import java.nio.charset.StandardCharsets
+
+/**
+ * Read-only view over the decodes of one decode cycle.
+ *
+ * The records live in a direct buffer owned by the native engine and are
+ * overwritten by the next batch, so the view is only valid for the duration of
+ * [JS8Engine.CallbackHandler.onDecodeBatch]. Copy out anything you need to keep.
+ */
+class DecodeBatch internal constructor(buffer: ByteBuffer) {
+
+    private companion object {
+        // utc, snr, dt, freq, type, quality, mode, textLength (see js8_engine_jni.cpp)
+        const val RECORD_HEADER_BYTES = 32
+    }
+
+    private val buffer: ByteBuffer = buffer.duplicate().order(ByteOrder.nativeOrder())
+    private var offsets = IntArray(32)
+    private var textBytes = ByteArray(256)
+
+    /** Number of decodes in the batch. */
+    var size: Int = 0
+        private set
+
+    internal fun reset(count: Int, bytes: Int) {
+        if (offsets.size < count) {
+            offsets = IntArray(maxOf(count, offsets.size * 2))
+        }
+        var offset = 0
+        var parsed = 0
+        while (parsed < count && offset + RECORD_HEADER_BYTES <= bytes) {
+            offsets[parsed++] = offset
+            val textLength = buffer.getInt(offset + 28)
+            offset += RECORD_HEADER_BYTES + ((textLength + 3) and 3.inv())
+        }
+        size = parsed
+    }
+
+    fun utc(index: Int): Int = buffer.getInt(offsets[index])
+    fun snr(index: Int): Int = buffer.getInt(offsets[index] + 4)
+    fun dt(index: Int): Float = buffer.getFloat(offsets[index] + 8)
+    fun freq(index: Int): Float = buffer.getFloat(offsets[index] + 12)
+    fun type(index: Int): Int = buffer.getInt(offsets[index] + 16)
+    fun quality(index: Int): Float = buffer.getFloat(offsets[index] + 20)
+    fun mode(index: Int): Int = buffer.getInt(offsets[index] + 24)
+
+    /** Decoded text; allocates a String, so call it only for records you use. */
+    fun text(index: Int): String {
+        val base = offsets[index]
+        val length = buffer.getInt(base + 28)
+        if (textBytes.size < length) {
+            textBytes = ByteArray(length)
+        }
+        buffer.position(base + RECORD_HEADER_BYTES)
+        buffer.get(textBytes, 0, length)
+        return String(textBytes, 0, length, StandardCharsets.UTF_8)
+    }
+}
+
+/**
+ * View over the latest spectrum frame.
+ *
+ * Native code rewrites the same direct buffer for every frame and bumps
+ * [sequence]; a gap between consecutive sequence numbers means frames were
+ * skipped. The contents are stable only inside
+ * [JS8Engine.CallbackHandler.onSpectrumFrame].
+ */
+class SpectrumFrame internal constructor(buffer: ByteBuffer) {
+
+    private companion object {
+        // sequence, binCount, binHz, powerDb, peakDb, reserved (see js8_engine_jni.cpp)
+        const val HEADER_BYTES = 24
+    }
+
+    private val header: ByteBuffer = buffer.duplicate().order(ByteOrder.nativeOrder())
+    private val bins: FloatBuffer = buffer.duplicate().apply { position(HEADER_BYTES) }
+        .slice().order(ByteOrder.nativeOrder()).asFloatBuffer()
+
+    val sequence: Int get() = header.getInt(0)
+    val binCount: Int get() = header.getInt(4)
+    val binHz: Float get() = header.getFloat(8)
+    val powerDb: Float get() = header.getFloat(12)
+    val peakDb: Float get() = header.getFloat(16)
+
+    fun bin(index: Int): Float = bins.get(index)
+
+    /**
+     * Copy the bins into [dest] without allocating.
+     *
+     * @return Number of bins copied
+     */
+    fun copyBins(dest: FloatArray): Int {
+        val count = minOf(binCount, dest.size)
+        bins.position(0)
+        bins.get(dest, 0, count)
+        return count
+    }
+
+    /** Copy the bins into a new array. */
+    fun copyBins(): FloatArray {
+        val out = FloatArray(binCount)
+        copyBins(out)
+        return out
+    }
+}
+
+/**
+ * Where one decode cycle spent its time, summed over every submode and pass.
+ *
+ * Times are in nanoseconds; CPU times are for the decode thread and read zero
+ * on platforms without a per-thread CPU clock.
+ */
+class DecodeMetrics internal constructor(
+    val submodes: Int,
+    val passes: Int,
+    val candidatesTried: Int,
+    /** Candidates that passed CRC, before duplicates are merged. */
+    val candidatesDecoded: Int,
+    private val stageNanos: LongArray
+) {
+    /** Decoder stages, in the order native code packs them. */
+    enum class Stage { TOTAL, SYNC, DOWNSAMPLE, SEARCH, DEMOD, BP, SUBTRACT }
+
+    fun wallNanos(stage: Stage): Long = stageNanos[stage.ordinal * 2]
+    fun cpuNanos(stage: Stage): Long = stageNanos[stage.ordinal * 2 + 1]
+}
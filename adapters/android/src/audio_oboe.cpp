@@ -5,7 +5,6 @@
 #include <limits>
 #include <android/log.h>
 
-#include "js8core/dsp/resampler.hpp"
 
 #ifdef __ANDROID__
 
@@ -72,29 +71,13 @@ bool OboeAudioInput::start(AudioStreamParams const& params,
     return false;
   }
 
-  // Prepare decimator if device overrided the requested rate
-  actual_sample_rate_ = stream_->getSampleRate();
-  decimation_factor_ = 1;
-  fir_taps_.clear();
-  fir_buffer_.clear();
-
-  if (actual_sample_rate_ > 0 && params_.format.sample_rate > 0 &&
-      actual_sample_rate_ % params_.format.sample_rate == 0) {
-    decimation_factor_ = actual_sample_rate_ / params_.format.sample_rate;
-
-    if (decimation_factor_ > 1 &&
-        params_.format.sample_type == SampleType::Int16) {
-      fir_taps_ =
-          js8core::dsp::make_js8_fir(actual_sample_rate_, params_.format.sample_rate);
-      fir_buffer_.assign(fir_taps_.size() * 2, 0);
-      fir_pos_ = 0;
-      __android_log_print(ANDROID_LOG_INFO, "JS8AudioInput",
-                         "Decimating audio: device_rate=%d, target_rate=%d, "
-                         "factor=%d, taps=%zu",
-                         actual_sample_rate_, params_.format.sample_rate,
-                         decimation_factor_, fir_taps_.size());
-    }
-  }
+  // The device may not honour the requested rate (or none was requested); report
+  // what it actually delivers and let the engine resample to the decoder rate.
+  params_.format.sample_rate = stream_->getSampleRate();
+  params_.format.channels = stream_->getChannelCount();
+  __android_log_print(ANDROID_LOG_INFO, "JS8AudioInput",
+                     "Input stream open: rate=%d, channels=%d",
+                     params_.format.sample_rate, params_.format.channels);
 
   return true;
 }
@@ -128,55 +111,12 @@ oboe::DataCallbackResult OboeAudioInput::onAudioReady(oboe::AudioStream* stream,
   const std::size_t buffer_size = static_cast<std::size_t>(num_frames) *
                                   params_.format.channels * bytes_per_sample;
 
-  if (decimation_factor_ > 1 && params_.format.sample_type == SampleType::Int16 &&
-      !fir_taps_.empty()) {
-    auto* in = static_cast<const int16_t*>(audio_data);
-    const int taps = static_cast<int>(fir_taps_.size());
-    const int mirror = taps;  // mirror buffer to avoid bounds checks
-
-    std::vector<int16_t> decimated;
-    decimated.reserve(static_cast<std::size_t>(num_frames / decimation_factor_ + 1));
-
-    for (int i = 0; i < num_frames; ++i) {
-      const auto sample = in[i];
-      fir_buffer_[fir_pos_] = sample;
-      fir_buffer_[fir_pos_ + mirror] = sample;
-      fir_pos_ = (fir_pos_ + 1) % mirror;
-
-      if ((i % decimation_factor_) == decimation_factor_ - 1) {
-        double acc = 0.0;
-        int read_pos = (fir_pos_ - 1 + mirror) % mirror;
-        for (int j = 0; j < taps; ++j) {
-          int idx = (read_pos - j + mirror) % mirror;
-          acc += static_cast<double>(fir_taps_[j]) *
-                 static_cast<double>(fir_buffer_[idx]);
-        }
-        int value = static_cast<int>(std::lrint(acc));
-        value = std::clamp(value,
-                           static_cast<int>(std::numeric_limits<int16_t>::min()),
-                           static_cast<int>(std::numeric_limits<int16_t>::max()));
-        decimated.push_back(static_cast<int16_t>(value));
-      }
-    }
-
-    buffer.data = std::span<const std::byte>(
-        reinterpret_cast<const std::byte*>(decimated.data()),
-        decimated.size() * sizeof(int16_t));
-
-    try {
-      on_frames_(buffer);
-    } catch (...) {
-      // Swallow exceptions to prevent stream termination
-    }
-  } else {
-    // No resampling needed; pass through
-    buffer.data = std::span<const std::byte>(
-        static_cast<const std::byte*>(audio_data), buffer_size);
-    try {
-      on_frames_(buffer);
-    } catch (...) {
-      // Swallow exceptions to prevent stream termination
-    }
+  buffer.data = std::span<const std::byte>(
+      static_cast<const std::byte*>(audio_data), buffer_size);
+  try {
+    on_frames_(buffer);
+  } catch (...) {
+    // Swallow exceptions to prevent stream termination
   }
 
   return oboe::DataCallbackResult::Continue;
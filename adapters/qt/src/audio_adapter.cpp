@@ -104,6 +104,23 @@ bool AudioInputAdapter::start(AudioStreamParams const& params,
   QAudioDevice device = QMediaDevices::defaultAudioInput();
   QAudioFormat qfmt = to_qt_format(params.format);
 
+  // The engine converts any Int16/Float32 layout itself, so if the requested
+  // format is not native to the device, capture in the device's preferred
+  // sample format and channel count instead. The engine also resamples, so a
+  // zero rate keeps the device's own rate.
+  if (params.format.sample_rate <= 0 || !qfmt.isValid() ||
+      !device.isFormatSupported(qfmt)) {
+    QAudioFormat preferred = device.preferredFormat();
+    if (params.format.sample_rate > 0) {
+      preferred.setSampleRate(params.format.sample_rate);
+    }
+    if (preferred.sampleFormat() != QAudioFormat::Int16 &&
+        preferred.sampleFormat() != QAudioFormat::Float) {
+      preferred.setSampleFormat(QAudioFormat::Float);
+    }
+    qfmt = preferred;
+  }
+
   if (!qfmt.isValid() || !device.isFormatSupported(qfmt)) {
     if (d_->on_error) d_->on_error("AudioInputAdapter: unsupported audio format");
     d_.reset();
@@ -132,13 +149,15 @@ bool AudioInputAdapter::start(AudioStreamParams const& params,
 
   connect(d_->io_device, &QIODevice::readyRead, this, [this, qfmt]() {
     if (!d_ || !d_->io_device) return;
-    while (d_->io_device->bytesAvailable() >= static_cast<qint64>(bytes_per_frame(qfmt))) {
+    auto const frame_bytes = static_cast<qint64>(bytes_per_frame(qfmt));
+    while (d_->io_device->bytesAvailable() >= frame_bytes) {
       qint64 avail = d_->io_device->bytesAvailable();
+      avail -= avail % frame_bytes;  // hand over whole frames only
       if (avail > static_cast<qint64>(d_->buffer.size())) {
         d_->buffer.resize(static_cast<std::size_t>(avail));
       }
       qint64 read = d_->io_device->read(reinterpret_cast<char*>(d_->buffer.data()), avail);
-  if (read > 0 && d_->on_frames) {
+      if (read > 0 && d_->on_frames) {
         std::span<const std::byte> span(d_->buffer.data(), static_cast<std::size_t>(read));
         AudioInputBuffer buf{span, to_core_format(qfmt), SteadyClock::now()};
         d_->on_frames(buf);
@@ -15,6 +15,8 @@
 # Keep JNI callback methods that are called from native code
 -keepclassmembers class com.js8call.core.JS8Engine$CallbackHandler {
     public void onDecoded(...);
+    public void onDecodeBatch(...);
+    public void onSpectrumFrame(...);
     public void onSpectrum(...);
     public void onDecodeStarted(...);
     public void onDecodeFinished(...);
@@ -22,6 +24,9 @@
     public void onLog(...);
 }
 
+# Native code delivers events through this bridge
+-keep class com.js8call.core.JS8Engine$EventBridge { *; }
+
 # Keep Companion object for static factory methods
 -keepclassmembers class com.js8call.core.JS8Engine$Companion {
     public ** create(...);
@@ -58,6 +58,7 @@ extern struct dec_data
     int nfb;                    // High decode limit (Hz) (filter max)
     bool syncStats;             // only compute sync candidates
     int kin;                    // number of frames written to d2
+    int koff;                   // index in d2 of frame 0; see js8_ring_index()
     int kposA;                  // starting position of decode for submode A
     int kposB;                  // starting position of decode for submode B
     int kposC;                  // starting position of decode for submode C
@@ -72,6 +73,23 @@ extern struct dec_data
   } params;
 } dec_data;
 
+// The d2 sample buffer is a ring; frame k of the period, in the sense of
+// kin and the decode positions, lives at d2[js8_ring_index(k, koff)]. When
+// the detector realigns the buffer to the period, it moves koff instead of
+// moving the samples. koff is in [0, JS8_RX_SAMPLE_SIZE), and k + koff
+// must be in [-JS8_RX_SAMPLE_SIZE, 2 * JS8_RX_SAMPLE_SIZE).
+
+inline int
+js8_ring_index(int const k,
+               int const koff)
+{
+  int const i = k + koff;
+
+  if (i <  0)                  return i + JS8_RX_SAMPLE_SIZE;
+  if (i >= JS8_RX_SAMPLE_SIZE) return i - JS8_RX_SAMPLE_SIZE;
+                               return i;
+}
+
 extern struct
 specData
 {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <functional>
+#include <map>
+#include <mutex>
 
 #include "js8core/types.hpp"
 
@@ -17,4 +19,54 @@ public:
   virtual void cancel(TimerHandle handle) = 0;
 };
 
+// Source of "now" for the engine: UTC period alignment, TX slot sync, decode
+// timestamps and spectrum throttling. Queue wait statistics always use the real steady clock,
+// since they measure how far the workers lag the caller.
+class Clock {
+public:
+  virtual ~Clock() = default;
+  virtual WallTimePoint wall_now() const = 0;
+  virtual SteadyTimePoint steady_now() const = 0;
+};
+
+// The process clocks; used when EngineDependencies::clock is null.
+Clock& real_clock();
+
+// Clock and Scheduler that only move when advance() is called, so recorded
+// audio can be replayed through the engine faster than real time. The owner
+// advances it by the duration of each buffer it submits; timers fire on the
+// advancing thread, in deadline order, with the clock set to their deadline.
+class SimulatedClock : public Clock, public Scheduler {
+public:
+  explicit SimulatedClock(WallTimePoint start = WallTimePoint{});
+
+  SimulatedClock(SimulatedClock const&) = delete;
+  SimulatedClock& operator=(SimulatedClock const&) = delete;
+
+  WallTimePoint wall_now() const override;
+  SteadyTimePoint steady_now() const override;
+
+  SteadyTimePoint now() const override { return steady_now(); }
+  TimerHandle call_after(SteadyDuration delay, std::function<void()> fn) override;
+  TimerHandle call_every(SteadyDuration period, std::function<void()> fn) override;
+  void cancel(TimerHandle handle) override;
+
+  void advance(SteadyDuration delta);
+
+private:
+  struct Timer {
+    SteadyTimePoint deadline;
+    SteadyDuration period;  // zero for one-shot timers
+    std::function<void()> fn;
+  };
+
+  TimerHandle add_timer(SteadyDuration delay, SteadyDuration period, std::function<void()> fn);
+
+  WallTimePoint const wall_start_;
+  mutable std::mutex mutex_;
+  SteadyDuration elapsed_{};
+  TimerHandle next_handle_ = 1;
+  std::map<TimerHandle, Timer> timers_;
+};
+
 }  // namespace js8core
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "js8core/decoder.hpp"
+
+namespace js8core {
+
+struct DecodePoolConfig {
+  int threads = 1;
+  // Decode CPU time the pool may spend per second of real time, summed over
+  // its threads (1.5 = one and a half cores); 0 leaves it unthrottled. Over
+  // budget, jobs wait their turn instead of being dropped, and the engines'
+  // bounded decode queues absorb the delay by merging windows.
+  double cpu_budget = 0.0;
+  std::string name = "js8-decode";  // thread name, numbered when threads > 1
+  DecoderMemoryConfig decoder_memory;  // for each thread's Decoder
+};
+
+struct DecodePoolStats {
+  int threads = 0;
+  int decoders = 0;  // built so far; one per thread that has run a job
+  std::size_t queued = 0;
+  std::uint64_t jobs = 0;
+  std::chrono::nanoseconds cpu{0};        // thread CPU time spent in jobs
+  std::chrono::nanoseconds throttled{0};  // time jobs waited for CPU budget
+  DecoderMemory memory{};  // per-mode state bytes per Decoder, with the count of Decoders holding it
+};
+
+// Threads that run decode jobs in the order they were posted, each thread
+// with a Decoder of its own, built on its first job. An engine runs a
+// one-thread pool of its own unless EngineDependencies::decode_pool supplies
+// a shared one (see ReceiverHost); a shared pool must outlive its engines.
+class DecodePool {
+public:
+  using Job = std::function<void(Decoder&)>;
+
+  explicit DecodePool(DecodePoolConfig config = {});
+  ~DecodePool();  // joins the threads; jobs still queued are discarded
+
+  DecodePool(DecodePool const&) = delete;
+  DecodePool& operator=(DecodePool const&) = delete;
+
+  void post(Job job);
+
+  DecodePoolStats stats() const;
+
+private:
+  void worker_loop(std::string const& name, std::size_t index);
+  bool wait_for_budget(std::unique_lock<std::mutex>& lock);
+
+  DecodePoolConfig const config_;
+  std::vector<std::thread> threads_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Job> jobs_;
+  bool stop_ = false;
+
+  // CPU budget, as a bucket of seconds that refills at cpu_budget per second
+  // and may run into debt by the cost of the jobs in flight.
+  double credit_s_ = 0.0;
+  std::chrono::steady_clock::time_point refilled_at_{};
+
+  DecodePoolStats stats_{};
+  std::vector<DecoderMemory> memory_;  // per thread
+};
+
+}  // namespace js8core
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 
 #include "js8core/decoder_state.hpp"
 #include "js8core/engine.hpp"
@@ -8,7 +10,40 @@
 
 namespace js8core {
 
-// Qt-free legacy decoder entry point (moved from JS8.cpp).
+// Working buffers for decoding, from about 1.6 MB (submode I) to about
+// 11.6 MB (submode E) per submode, built the first time a decode asks for
+// that submode. A Decoder is not thread-safe: give each decoding thread its own.
+// The read-only per-submode tables and FFTW plans behind it are built once
+// per process, with the first state of their submode, and shared by all
+// Decoders; they are never released.
+class Decoder {
+public:
+  explicit Decoder(DecoderMemoryConfig config = {});
+  ~Decoder();
+
+  Decoder(Decoder const&) = delete;
+  Decoder& operator=(Decoder const&) = delete;
+
+  std::size_t decode(DecodeState const& state,
+                     std::function<void(events::Variant const&)> emit);
+
+  // Releases the working buffers of the submodes in the mask (1 << id).
+  void release(int submodes);
+
+  // Submodes whose working buffers are held, as a mask, and their bytes.
+  int resident() const;
+  std::size_t resident_bytes() const;
+
+  // Sizes of every submode, built or not; decoders counts this Decoder only.
+  DecoderMemory memory() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+// Qt-free legacy decoder entry point (moved from JS8.cpp). Decodes with a
+// process-wide Decoder; concurrent calls are serialised.
 std::size_t legacy_decode(DecodeState const& state,
                           std::function<void(events::Variant const&)> emit);
 
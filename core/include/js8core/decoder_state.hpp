@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <vector>
@@ -20,6 +23,13 @@ struct DecodeParams {
   int nfa = 0;
   int nfb = 0;
   bool syncStats = false;
+  // Energy gate for the sync search: only frequencies whose average power
+  // over a signal's width is at least syncGateDb above the noise baseline
+  // get the full Costas search. Lower values are more sensitive; at the
+  // default, quiet spectrum is skipped and signals at each submode's
+  // decoding threshold are still searched.
+  bool syncGate = true;
+  float syncGateDb = 0.3f;
   int kin = 0;
   int kposA = 0;
   int kposB = 0;
@@ -39,6 +49,28 @@ struct DecodeState {
   DecodeParams params;
 };
 
+constexpr int kDecoderModes = 5;  // indexed by protocol::SubmodeId
+
+struct DecoderMemoryConfig {
+  // Working-buffer bytes one Decoder may hold; 0 is unlimited. Building a
+  // submode's state past the budget first releases the least recently used
+  // states the decode in progress has no further need of; a submode that
+  // still doesn't fit is built, used and released again within the decode.
+  std::size_t budget_bytes = 0;
+  // Release a submode's state once no decode has used it for this long, e.g.
+  // after the submode is disabled; 0 keeps it.
+  std::chrono::seconds release_after{0};
+};
+
+struct DecoderModeMemory {
+  std::size_t state_bytes = 0;  // working buffers, per Decoder holding them
+  std::size_t table_bytes = 0;  // shared tables and plans, once per process
+  int decoders = 0;             // Decoders currently holding state_bytes
+  bool tables_built = false;
+};
+
+using DecoderMemory = std::array<DecoderModeMemory, kDecoderModes>;
+
 struct SpectrumState {
   float savg[kJs8NsMax]{};
   float slin[kJs8NsMax]{};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "js8core/types.hpp"
+
+namespace js8core::dsp {
+
+// Splits a wideband complex IQ stream into JS8 receiver audio, one real
+// stream at output_rate per dial frequency, as a USB receiver tuned to that
+// dial would hear it (RF dial + f comes out as an audio tone at f).
+//
+// This is an overlap-save fast-convolution filter bank: each block of input
+// costs one forward FFT shared by every channel, then per channel only a
+// short inverse FFT over the bins around its dial, so adding a channel is far
+// cheaper than mixing and resampling the full-rate stream again. Each channel
+// filter passes 0..5.4 kHz above its dial and rejects the opposite sideband.
+// Output sample n lines up with input sample n * input_rate / output_rate;
+// the filter's delay is removed, so DT is unaffected.
+class Channelizer {
+public:
+  // channel, audio samples (full scale +/-1.0 for full-scale input)
+  using Sink = std::function<void(std::size_t, std::span<const float>)>;
+
+  Channelizer();
+  ~Channelizer();
+
+  Channelizer(Channelizer const&) = delete;
+  Channelizer& operator=(Channelizer const&) = delete;
+
+  // center_hz is the RF frequency at DC of the IQ stream (I + jQ, positive
+  // frequencies above it). Every dial needs its channel, dial - output_rate/2
+  // to dial + output_rate/2, inside the IQ span.
+  bool configure(int input_rate,
+                 FrequencyHz center_hz,
+                 std::vector<FrequencyHz> const& dials,
+                 int output_rate,
+                 std::string* error = nullptr);
+  void reset();  // forget buffered input; the next sample starts a new stream
+
+  std::size_t channels() const;
+  std::size_t block_input() const;   // new input samples per block
+  std::size_t block_output() const;  // output samples per channel per block
+
+  // Consumes all of `iq`; calls `sink` once per channel for each completed
+  // block, channels in configuration order.
+  void process(std::span<const std::complex<float>> iq, Sink const& sink);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace js8core::dsp
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <span>
 #include <vector>
 
@@ -131,4 +132,37 @@ private:
   bool has_next_ = false;
 };
 
+// Push-based polyphase resampler for capture audio: converts any integer input
+// rate to the output rate by the reduced ratio up/down (e.g. 44100 -> 12000 is
+// 40/147). Only the phases that land on output samples are evaluated, and each
+// phase is a contiguous dot product over a mirrored history buffer.
+class RationalResampler {
+public:
+  void configure(int input_rate, int output_rate);
+  void reset();
+
+  int input_rate() const { return input_rate_; }
+  int output_rate() const { return output_rate_; }
+  int taps_per_phase() const { return taps_per_phase_; }
+
+  // Upper bound on the output produced by process() for `input_frames` samples.
+  std::size_t max_output(std::size_t input_frames) const;
+
+  // Consume all of `input` and write the resampled signal to `output`, which
+  // must hold max_output(input.size()) samples. Returns the samples written.
+  std::size_t process(std::span<const std::int16_t> input, std::span<std::int16_t> output);
+
+private:
+  int input_rate_ = 0;
+  int output_rate_ = 0;
+  int up_ = 1;
+  int down_ = 1;
+  int taps_per_phase_ = 0;
+  std::vector<float> phases_;   // up_ rows of taps_per_phase_, oldest sample first
+  std::vector<float> history_;  // mirrored: 2 * taps_per_phase_
+  int history_pos_ = 0;
+  int phase_ = 0;               // filter phase of the next output
+  int pending_ = 1;             // inputs still needed before the next output
+};
+
 }  // namespace js8core::dsp
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "js8core/types.hpp"
+
+namespace js8core::dsp {
+
+// Size in bytes of one sample of the given type (0 for unknown types).
+std::size_t bytes_per_sample(SampleType type);
+
+// Index of the channel carrying the most energy in an interleaved buffer.
+int loudest_channel(std::span<const std::byte> data, SampleType type, int channels);
+
+// Convert `out.size()` frames of one channel of an interleaved Int16/Float32
+// buffer to int16. Float input is full scale at +/-1.0 and is clamped.
+void extract_channel(std::span<const std::byte> data,
+                     SampleType type,
+                     int channels,
+                     int channel,
+                     std::span<std::int16_t> out);
+
+}  // namespace js8core::dsp
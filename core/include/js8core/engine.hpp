@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -9,6 +12,7 @@
 
 #include "js8core/audio.hpp"
 #include "js8core/clock.hpp"
+#include "js8core/decoder_state.hpp"
 #include "js8core/protocol/varicode.hpp"
 #include "js8core/logger.hpp"
 #include "js8core/network.hpp"
@@ -63,13 +67,56 @@ struct Spectrum {
   float peak_db = 0.0f;
 };
 
-using Variant = std::variant<DecodeStarted, SyncStart, SyncState, Decoded, DecodeFinished, Spectrum>;
+// Wall-clock and decode-thread CPU time spent in one decoder stage. cpu stays
+// zero on platforms without a per-thread CPU clock.
+struct DecodeStageTime {
+  std::chrono::nanoseconds wall{0};
+  std::chrono::nanoseconds cpu{0};
+};
+
+// Emitted once per decode cycle, just before DecodeFinished. Stage times and
+// counters are summed over every submode and pass in the cycle.
+struct DecodeMetrics {
+  int submodes = 0;
+  int passes = 0;
+  int candidates_tried = 0;
+  int candidates_decoded = 0;  // passed CRC, before duplicates are merged
+  int sync_bins = 0;          // frequency bins given the full sync search
+  int sync_bins_skipped = 0;  // left out by the sync energy gate
+  DecodeStageTime total;
+  DecodeStageTime sync;        // syncjs8 candidate search
+  DecodeStageTime downsample;  // baseband FFT and per-candidate downsampling
+  DecodeStageTime search;      // DT and fine frequency search
+  DecodeStageTime demod;       // symbol spectra, Costas check and LLRs
+  DecodeStageTime bp;          // belief-propagation decoding
+  DecodeStageTime subtract;    // signal subtraction
+};
+
+using Variant = std::variant<DecodeStarted, SyncStart, SyncState, Decoded, DecodeFinished, Spectrum,
+                             DecodeMetrics>;
 
 }  // namespace events
 
+// Channel selector value that follows whichever input channel is loudest.
+inline constexpr int kInputChannelLoudest = -1;
+
 struct EngineConfig {
-  int sample_rate_hz = 0;
+  int sample_rate_hz = 0;  // decoder rate; 0 means kJs8RxSampleRate (12 kHz)
   int submodes = 0;
+  // Capture format requested from EngineDependencies::audio_in. submit_capture
+  // accepts any rate and any Int16/Float32 layout; channel selection and rate
+  // conversion to the decoder rate happen once in the engine, so adapters
+  // should pass device buffers through untouched.
+  int capture_rate_hz = 0;  // 0 lets the device use its native rate
+  SampleType input_sample_type = SampleType::Int16;
+  int input_channels = 1;
+  int input_channel = 0;  // channel fed to the decoder, or kInputChannelLoudest
+  // Energy gate for the decoder's sync search; see DecodeParams::syncGate.
+  bool sync_gate = true;
+  float sync_gate_db = 0.3f;
+  // Decoder memory for the engine's own decode pool; a shared pool has its
+  // own in DecodePoolConfig.
+  DecoderMemoryConfig decoder_memory;
   int tx_output_rate_hz = 48000;
   float tx_output_gain = 1.0f;
   bool tx_output_gain_boost_enabled = false;
@@ -101,14 +148,45 @@ struct EngineCallbacks {
   std::function<void(LogLevel level, std::string_view message)> on_log;
 };
 
+class DecodePool;
+
 struct EngineDependencies {
   AudioInput* audio_in = nullptr;
   AudioOutput* audio_out = nullptr;
   RigControl* rig = nullptr;
   Scheduler* scheduler = nullptr;
+  Clock* clock = nullptr;  // null uses real_clock(); see SimulatedClock for replay
   Storage* storage = nullptr;
   Logger* logger = nullptr;
   UdpChannel* udp = nullptr;
+  DecodePool* decode_pool = nullptr;  // null runs a one-thread pool of the engine's own
+};
+
+// Counters for one of the engine's worker queues. Both queues are bounded:
+// the spectrum queue keeps only the newest frame, and the decode queue folds a
+// pending snapshot into the next one (or drops it once its windows have been
+// overwritten in the ring).
+struct QueueStats {
+  std::size_t depth = 0;
+  std::size_t capacity = 0;
+  std::uint64_t enqueued = 0;
+  std::uint64_t processed = 0;  // picked up by the worker
+  std::uint64_t completed = 0;  // finished by the worker; == processed when idle
+  std::uint64_t dropped = 0;  // superseded before the worker picked them up
+  std::uint64_t merged = 0;   // folded into a newer decode job
+  std::chrono::microseconds last_wait{0};
+  std::chrono::microseconds max_wait{0};
+  std::chrono::microseconds total_wait{0};  // divide by processed for the mean
+  // Queued to completed, i.e. wait plus run time; a merged job counts from
+  // its oldest window.
+  std::chrono::microseconds last_latency{0};
+  std::chrono::microseconds max_latency{0};
+  std::chrono::microseconds total_latency{0};  // divide by completed for the mean
+};
+
+struct EngineQueueStats {
+  QueueStats decode;
+  QueueStats spectrum;
 };
 
 class Js8Engine {
@@ -127,6 +205,23 @@ public:
   virtual bool is_transmitting() const = 0;
   virtual bool is_transmitting_audio() const = 0;
   virtual void set_tx_boost_enabled(bool enabled) = 0;
+
+  virtual EngineQueueStats queue_stats() const = 0;
+
+  // Decoder memory of the decode pool while running, which for a shared
+  // pool covers every engine on it; empty when stopped.
+  virtual DecoderMemory decoder_memory() const = 0;
+
+  // Current dial (RF) frequency, for consumers that need to know the band;
+  // also taken from RigControl state updates when a rig is attached.
+  virtual void set_dial_frequency(FrequencyHz dial_hz) = 0;
+  virtual FrequencyHz dial_frequency() const = 0;
+
+  // Record the decoder-rate capture stream to `path` (see recording.hpp)
+  // until stop_recording(). Safe to call while audio is flowing; the capture
+  // thread only copies into a preallocated buffer.
+  virtual bool start_recording(std::string const& path, std::string* error = nullptr) = 0;
+  virtual void stop_recording() = 0;
 };
 
 std::unique_ptr<Js8Engine> make_engine(EngineConfig const& config,
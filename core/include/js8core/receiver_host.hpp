@@ -0,0 +1,68 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "js8core/decode_pool.hpp"
+#include "js8core/engine.hpp"
+#include "js8core/types.hpp"
+
+namespace js8core {
+
+struct ReceiverHostConfig {
+  int decode_threads = 0;   // 0: one per core less one for capture, at least one
+  double cpu_budget = 0.0;  // decode cores for all receivers; see DecodePoolConfig
+  DecoderMemoryConfig decoder_memory;  // for each decode thread
+};
+
+struct ReceiverStats {
+  int id = 0;
+  std::string name;
+  FrequencyHz dial_hz = 0;
+  QueueStats decode;  // last/max/total_latency is this receiver's decode latency
+};
+
+// Runs several independent receivers in one process, e.g. one per SDR slice.
+// Each receiver is a full Js8Engine with its own capture ring, decode
+// schedule and dial frequency; decoding happens on one DecodePool shared by
+// all of them, so decoder memory and threads scale with decode_threads, not
+// with the number of receivers, and the per-submode tables and FFTW plans
+// exist once. The pool serves receivers in turn, one decode job each.
+class ReceiverHost {
+public:
+  explicit ReceiverHost(ReceiverHostConfig const& config = {});
+  ~ReceiverHost();  // removes every receiver, then stops the pool
+
+  ReceiverHost(ReceiverHost const&) = delete;
+  ReceiverHost& operator=(ReceiverHost const&) = delete;
+
+  // Creates a receiver and returns its id. deps.decode_pool is replaced by
+  // the host's pool; every other dependency belongs to the receiver.
+  int add_receiver(std::string name,
+                   EngineConfig const& config,
+                   EngineCallbacks callbacks,
+                   EngineDependencies deps);
+  bool remove_receiver(int id);
+
+  // Valid until the receiver is removed.
+  Js8Engine* receiver(int id) const;
+
+  std::vector<ReceiverStats> stats() const;
+  DecodePoolStats decode_pool_stats() const { return pool_.stats(); }
+
+private:
+  struct Receiver {
+    std::string name;
+    std::unique_ptr<Js8Engine> engine;
+  };
+
+  DecodePool pool_;
+  mutable std::mutex mutex_;
+  std::map<int, Receiver> receivers_;
+  int next_id_ = 1;
+};
+
+}  // namespace js8core
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "js8core/clock.hpp"
+#include "js8core/engine.hpp"
+#include "js8core/types.hpp"
+
+namespace js8core {
+
+// Capture recordings: the exact decoder-rate sample stream an engine saw,
+// with capture timestamps and dial frequency changes, so a decoding problem
+// can be replayed offline.
+//
+// File layout (little-endian): a RecordingHeader, then records of
+// RecordHeader followed by `count` int16 samples for audio records or one
+// uint64 for dial records. Contiguous audio is coalesced into blocks of up
+// to a second, so the stream costs barely more than its raw PCM.
+namespace recording {
+
+inline constexpr char kMagic[8] = {'J', 'S', '8', 'R', 'E', 'C', '\0', '\1'};
+inline constexpr std::uint32_t kVersion = 1;
+
+struct RecordingHeader {
+  char magic[8] = {};
+  std::uint32_t version = kVersion;
+  std::uint32_t sample_rate = 0;    // decoder rate of the stored stream
+  std::int32_t submodes = 0;
+  std::int32_t ring_position = 0;   // engine ring index of the first sample
+  std::int32_t capture_rate = 0;    // device rate before resampling; informational
+  std::int32_t input_channels = 0;
+  std::int32_t input_channel = 0;
+  std::uint32_t reserved = 0;
+  std::int64_t start_wall_ns = 0;   // UTC of the first sample
+  std::uint64_t dial_hz = 0;        // dial frequency when recording started
+};
+
+enum class RecordType : std::uint32_t { Audio = 1, Dial = 2, Gap = 3 };
+
+struct RecordHeader {
+  RecordType type = RecordType::Audio;
+  std::uint32_t count = 0;   // samples in (Audio) or missing from (Gap) the stream
+  std::int64_t wall_ns = 0;  // UTC when the first sample reached the engine
+  std::int64_t steady_ns = 0;  // AudioInputBuffer::captured_at of that sample
+};
+
+static_assert(sizeof(RecordingHeader) == 56);
+static_assert(sizeof(RecordHeader) == 24);
+
+// Writes a recording from the engine's capture thread without blocking it:
+// append_*() copy into a preallocated single-producer ring and return, and a
+// background thread drains the ring to disk. If the disk falls behind by more
+// than the ring holds, audio is dropped and a Gap record marks the loss.
+class Writer {
+public:
+  // buffer_samples sizes the ring; the default holds about 20 s at 12 kHz.
+  explicit Writer(std::size_t buffer_samples = 1u << 18);
+  ~Writer();
+
+  Writer(Writer const&) = delete;
+  Writer& operator=(Writer const&) = delete;
+
+  // Creates the file and starts the writer thread. The header is written
+  // once begin() supplies where the stream starts.
+  bool open(std::string const& path, RecordingHeader const& header, std::string* error = nullptr);
+  void close();  // drains everything appended so far
+
+  // Producer side: one thread only; never blocks, allocates or does I/O.
+  // begin() comes first, from the thread that owns the engine ring. Audio may
+  // arrive as two spans when it wraps around that ring.
+  bool begun() const { return begun_; }
+  void begin(std::int32_t ring_position, std::int64_t wall_ns);
+  void append_audio(std::span<const std::int16_t> first,
+                    std::span<const std::int16_t> second,
+                    std::int64_t wall_ns,
+                    std::int64_t steady_ns);
+  void append_dial(std::uint64_t dial_hz, std::int64_t wall_ns);
+
+  std::uint64_t samples_written() const { return samples_.load(std::memory_order_relaxed); }
+  std::uint64_t samples_dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  bool push(RecordHeader const& record, std::span<const std::int16_t> first,
+            std::span<const std::int16_t> second, std::uint64_t const* dial_hz);
+  void copy_in(std::size_t pos, void const* data, std::size_t bytes);
+  void copy_out(std::size_t pos, void* data, std::size_t bytes) const;
+  void drain_loop();
+  bool drain_once();
+  void write_header();
+  void flush_block();
+
+  std::vector<std::byte> ring_;
+  std::atomic<std::size_t> head_{0};  // bytes produced
+  std::atomic<std::size_t> tail_{0};  // bytes consumed
+  std::atomic<bool> stop_{false};
+  std::atomic<std::uint64_t> samples_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  bool begun_ = false;             // producer-only
+  std::uint32_t pending_gap_ = 0;  // producer-only
+  std::int64_t gap_wall_ns_ = 0;   // producer-only
+  RecordingHeader header_{};       // completed by begin(), read by the writer thread
+
+  // Writer-thread state.
+  std::FILE* file_ = nullptr;
+  std::thread thread_;
+  bool header_written_ = false;
+  RecordHeader block_{};  // audio block being coalesced
+  std::vector<std::int16_t> block_samples_;
+};
+
+struct Record {
+  RecordHeader header;
+  std::vector<std::int16_t> samples;  // Audio
+  std::uint64_t dial_hz = 0;          // Dial
+};
+
+class Reader {
+public:
+  bool open(std::string const& path, std::string* error = nullptr);
+  RecordingHeader const& header() const { return header_; }
+  bool next(Record& out);  // false at end of file or on a truncated record
+
+private:
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> file_{nullptr, &std::fclose};
+  RecordingHeader header_{};
+};
+
+struct ReplayStats {
+  std::uint64_t samples = 0;
+  std::uint64_t gap_samples = 0;
+  std::uint64_t dial_changes = 0;
+  std::uint64_t decodes_waited = 0;
+};
+
+// Feeds a recording back through an engine. Build the engine with
+// config() and with clock() as both its Clock and Scheduler: the clock starts
+// where the recorded ring was, so decode windows and UTC stamps come out as
+// they did live. run() follows the recorded timestamps (filling gaps with
+// silence) and, by default, waits for each decode to finish before feeding
+// more audio, so the output does not depend on how fast the machine is.
+class Replay {
+public:
+  bool open(std::string const& path, std::string* error = nullptr);
+
+  RecordingHeader const& header() const { return reader_.header(); }
+  EngineConfig config() const;
+  SimulatedClock& clock() { return *clock_; }
+
+  ReplayStats run(Js8Engine& engine, bool wait_for_decodes = true);
+
+private:
+  Reader reader_;
+  std::unique_ptr<SimulatedClock> clock_;
+  std::int32_t lead_samples_ = 0;  // silence that puts the first sample at ring_position
+};
+
+}  // namespace recording
+}  // namespace js8core
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace js8core::trace {
+
+// Optional timeline of scoped spans, dumped as Chrome trace-event JSON (load
+// it in chrome://tracing or ui.perfetto.dev). Each thread records into its own
+// fixed-size ring, so recording takes no locks; the oldest spans are
+// overwritten once a ring is full. While tracing is disabled a span costs one
+// relaxed atomic load.
+//
+// Span names, categories and argument names must be string literals (or
+// otherwise outlive the trace); only the pointers are stored.
+
+namespace detail {
+extern std::atomic<bool> g_enabled;
+std::int64_t now_ns();
+void record(char const* name, char const* category, char const* arg_name,
+            std::int64_t arg, std::int64_t start_ns, std::int64_t end_ns);
+}  // namespace detail
+
+inline bool enabled() {
+  return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+void set_enabled(bool enabled);
+
+// Label the calling thread in the dump. Cheap; may be called before tracing
+// is enabled.
+void set_thread_name(char const* name);
+
+// Drop everything recorded so far.
+void clear();
+
+// Chrome trace-event JSON for all spans currently held in the thread rings.
+std::string dump_json();
+
+class Span {
+public:
+  explicit Span(char const* name, char const* category = "js8core")
+      : Span(name, category, nullptr, 0) {}
+
+  Span(char const* name, char const* category, char const* arg_name, std::int64_t arg)
+      : name_(name), category_(category), arg_name_(arg_name), arg_(arg),
+        start_ns_(enabled() ? detail::now_ns() : -1) {}
+
+  ~Span() {
+    if (start_ns_ >= 0) {
+      detail::record(name_, category_, arg_name_, arg_, start_ns_, detail::now_ns());
+    }
+  }
+
+  Span(Span const&) = delete;
+  Span& operator=(Span const&) = delete;
+
+private:
+  char const* name_;
+  char const* category_;
+  char const* arg_name_;
+  std::int64_t arg_;
+  std::int64_t start_ns_;
+};
+
+}  // namespace js8core::trace
@@ -4,6 +4,7 @@
 #include <atomic>
 #include <cstdint>
 
+#include "js8core/clock.hpp"
 #include "js8core/protocol/constants.hpp"
 
 namespace js8core::tx {
@@ -12,13 +13,29 @@ class Modulator {
 public:
   enum class State { Synchronizing, Active, Idle };
 
+  // The clock is what a synced start waits on; the engine passes its own, so
+  // that under a SimulatedClock the TX slot follows simulated time.
+  explicit Modulator(Clock const& clock = real_clock()) : clock_(&clock) {}
+
+  // Unless tuning, or told not to sync, the symbol stream waits for the
+  // start of its slot in the next period.
   void start(std::array<int, protocol::kJs8NumSymbols> const& tones,
              int symbol_samples,
              int start_delay_ms,
              int period_ms,
              double audio_frequency_hz,
              double tx_delay_s,
-             bool tuning);
+             bool tuning,
+             bool sync = true);
+
+  // Start the symbol stream on the very next sample instead of waiting for
+  // the next period boundary; used when generating audio offline.
+  void start_now(std::array<int, protocol::kJs8NumSymbols> const& tones,
+                 int symbol_samples,
+                 double audio_frequency_hz);
+
+  // Retune mid-transmission; the phase stays continuous.
+  void set_audio_frequency(double audio_frequency_hz) { audio_frequency_ = audio_frequency_hz; }
 
   void stop();
   bool is_idle() const { return state_.load() == State::Idle; }
@@ -27,6 +44,7 @@ public:
   float next_sample();
 
 private:
+  Clock const* clock_;
   std::array<int, protocol::kJs8NumSymbols> tones_{};
   std::atomic<State> state_{State::Idle};
   bool tuning_ = false;
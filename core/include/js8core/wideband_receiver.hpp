@@ -0,0 +1,78 @@
+#pragma once
+
+#include <complex>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "js8core/audio.hpp"
+#include "js8core/dsp/channelizer.hpp"
+#include "js8core/engine.hpp"
+#include "js8core/receiver_host.hpp"
+#include "js8core/types.hpp"
+
+namespace js8core {
+
+struct WidebandConfig {
+  int sample_rate_hz = 0;     // IQ rate, e.g. 96000 or 192000 from an SDR
+  FrequencyHz center_hz = 0;  // RF frequency at DC of the IQ stream
+  SampleType sample_type = SampleType::Int16;  // interleaved I, Q
+  float gain = 1.0f;          // applied to every channel's audio
+  std::vector<FrequencyHz> dials;  // one receiver per dial, USB
+  EngineConfig receiver;      // for every receiver; the capture fields are set here
+};
+
+// Feeds several JS8 receivers from one wideband IQ stream, e.g. 192 kHz from
+// an SDR covering the JS8 frequencies of a band. A dsp::Channelizer cuts the
+// stream into one USB audio channel per dial, and each channel goes to its
+// own receiver in a ReceiverHost, so all of them share the host's decode
+// pool. The receivers' dial frequencies are set from the config; their
+// events carry the usual audio offsets relative to that dial.
+//
+// submit_iq is meant for one capture thread; configure and the destructor
+// must not run concurrently with it.
+class WidebandReceiver {
+public:
+  // Callbacks for the receiver on `dial`.
+  using CallbackFactory = std::function<EngineCallbacks(FrequencyHz dial)>;
+
+  explicit WidebandReceiver(ReceiverHost& host);
+  ~WidebandReceiver();  // stops capture and removes its receivers
+
+  WidebandReceiver(WidebandReceiver const&) = delete;
+  WidebandReceiver& operator=(WidebandReceiver const&) = delete;
+
+  // Replaces any earlier configuration. deps are given to every receiver;
+  // deps.audio_in is ignored, capture comes through submit_iq or start().
+  bool configure(WidebandConfig const& config,
+                 CallbackFactory const& callbacks,
+                 EngineDependencies deps = {},
+                 std::string* error = nullptr);
+
+  // Interleaved two-channel I/Q at the configured rate and sample type.
+  bool submit_iq(AudioInputBuffer const& buffer);
+
+  // Captures IQ from a two-channel input device until stop(); device errors
+  // go to on_error.
+  bool start(AudioInput& input, AudioErrorHandler on_error = {});
+  void stop();
+
+  std::vector<int> const& receiver_ids() const { return ids_; }
+  Js8Engine* receiver(std::size_t channel) const;
+
+private:
+  void clear();
+
+  ReceiverHost& host_;
+  WidebandConfig config_;
+  int audio_rate_ = 0;
+  dsp::Channelizer channelizer_;
+  std::vector<int> ids_;
+  std::vector<Js8Engine*> engines_;
+  std::vector<std::complex<float>> iq_;
+  std::vector<float> audio_;
+  SteadyTimePoint captured_at_{};
+  AudioInput* input_ = nullptr;
+};
+
+}  // namespace js8core
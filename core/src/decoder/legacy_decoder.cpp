@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <complex>
 #include <cstddef>
@@ -13,6 +15,7 @@
 #include <android/log.h>
 #endif
 #include <limits>
+#include <memory>
 #include <mutex>
 #include "js8core/compat/numbers.hpp"
 #include "js8core/compat/concepts.hpp"
@@ -26,6 +29,7 @@
 #include <utility>
 #include <variant>
 #include <vector>
+#include <time.h>
 #include <boost/crc.hpp>
 #include <boost/math/ccmath/round.hpp>
 #include <boost/multi_index_container.hpp>
@@ -38,6 +42,7 @@
 #include "commons.h"
 #include "js8core/protocol/costas.hpp"
 #include "js8core/protocol/constants.hpp"
+#include "js8core/trace.hpp"
 
 std::mutex fftw_mutex;
 
@@ -169,6 +174,68 @@ namespace
     };
 }
 
+/******************************************************************************/
+// Decode Metrics
+/******************************************************************************/
+
+namespace
+{
+    // CPU time consumed so far by the calling thread. Platforms without a
+    // per-thread CPU clock report zero, leaving only the wall-clock half of
+    // the metrics populated.
+
+    std::chrono::nanoseconds
+    threadCpuTime()
+    {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+        timespec ts;
+
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        {
+            return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+        }
+#endif
+        return std::chrono::nanoseconds::zero();
+    }
+
+    // Adds the wall and CPU time elapsed between construction and stop(),
+    // or destruction if stop() was never called, to a decode stage.
+
+    class StageTimer
+    {
+    public:
+
+        explicit StageTimer(events::DecodeStageTime & stage)
+        : stage_(stage)
+        , wall_ (std::chrono::steady_clock::now())
+        , cpu_  (threadCpuTime())
+        {}
+
+        StageTimer(StageTimer const &)             = delete;
+        StageTimer & operator=(StageTimer const &) = delete;
+
+        ~StageTimer() { stop(); }
+
+        void
+        stop()
+        {
+            if (stopped_) return;
+
+            stopped_     = true;
+            stage_.cpu  += threadCpuTime() - cpu_;
+            stage_.wall += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - wall_);
+        }
+
+    private:
+
+        events::DecodeStageTime               & stage_;
+        std::chrono::steady_clock::time_point   wall_;
+        std::chrono::nanoseconds                cpu_;
+        bool                                    stopped_ = false;
+    };
+}
+
 /******************************************************************************/
 // Constants
 /******************************************************************************/
@@ -442,6 +509,20 @@ namespace
 
         return nodes;
     }();
+
+    // Energy gate for the sync search. A frequency bin gets the full Costas
+    // correlation only if the average power across a signal's width above
+    // it, 8 tones at NFOS bins apiece, clears the noise baseline by the
+    // configured margin; GATE_GUARD bins either side of a passing span are
+    // searched as well. Every GATE_STRIDE'th gated bin is still searched so
+    // that the 40th percentile used to normalize sync values can be
+    // estimated from the quiet part of the band, with each sample standing
+    // in for the bins skipped around it.
+
+    constexpr int GATE_SPAN   = 8 * NFOS - 1;
+    constexpr int GATE_GUARD  = 1;
+    constexpr int GATE_STRIDE = 4;
+    constexpr int GATE_BUSY   = 50;  // percentage of bins passing that disables the gate
 }
 
 /******************************************************************************/
@@ -1131,15 +1212,249 @@ namespace
 
 namespace
 {
+    // Read-only state for one submode: the Nuttal window, Costas reference
+    // waveforms, subtraction filter and FFTW plans. Built once per process,
+    // on first use, and shared by every DecodeMode; the plans run on each
+    // decoder's own buffers through FFTW's new-array execute functions, which
+    // are safe to call concurrently on the same plan.
+
     template <typename Mode>
-    class DecodeMode
+    class ModeTables
     {
-        // Data members
+    public:
+
+        using Plan = FFTWPlanManager::Type;
 
         std::array<float, Mode::NFFT1>                                                nuttal;
         std::array<std::array<std::array<std::complex<float>, Mode::NDOWNSPS>, 7>, 3> csyncs;
-        alignas(64) std::array<std::complex<float>, Mode::NDOWNSPS>                   csymb;
         alignas(64) std::array<std::complex<float>, Mode::NMAX>                       filter;
+        FFTWPlanManager                                                               plans;
+
+        static ModeTables const &
+        get()
+        {
+            static ModeTables const instance;
+            return instance;
+        }
+
+        // True once get() has built the tables; they're never released.
+
+        static bool
+        built()
+        {
+            return isBuilt.load(std::memory_order_acquire);
+        }
+
+    private:
+
+        inline static const auto& Costas = protocol::costas(Mode::NCOSTAS);
+
+        // Constructor
+
+        ModeTables()
+        {
+            // Intialize the Nuttal window. In theory, we can do this as a
+            // constexpr function at compile time, but doing so yield results
+            // slightly different than the Fortran version did, so for sanity
+            // while testing, we'll opt for consistency. IEEE 754 is always a
+            // bit brittle.
+
+            constexpr float a0 =  0.3635819f;
+            constexpr float a1 = -0.4891775f;
+            constexpr float a2 =  0.1365995f;
+            constexpr float a3 = -0.0106411f;
+
+            // Computed Pi constant to match the Fortran version; we could
+            // probably use std::numbers::pi_v<float> here, but for the
+            // moment, matching Fortran exactly.
+
+            float const pi  = 4.0f * std::atan(1.0f);
+            float       sum = 0.0f;
+
+            for (std::size_t i = 0; i < nuttal.size(); ++i)
+            {
+                // Naive summation here will exhibit substantial precision loss
+                // relative to the Fortran version; we use Kahan summation to
+                // compensate, which should yield results identical to Fortran.
+
+                KahanSum value = a0;
+
+                value += a1 * std::cos(2 * pi * i / nuttal.size());
+                value += a2 * std::cos(4 * pi * i / nuttal.size());
+                value += a3 * std::cos(6 * pi * i / nuttal.size());
+
+                nuttal[i] = value;
+                sum      += value;
+            }
+
+            // Normalize the Nuttal window.
+
+            for (auto & value : nuttal) value = value / sum * nuttal.size() / 300.0f;
+
+            // Initialize Costas waveforms.
+
+            for (int i = 0; i < 7; ++i)
+            {
+                float const dphia = TAU * Costas[0][i] / Mode::NDOWNSPS;
+                float const dphib = TAU * Costas[1][i] / Mode::NDOWNSPS;
+                float const dphic = TAU * Costas[2][i] / Mode::NDOWNSPS;
+
+                float phia = 0.0f;
+                float phib = 0.0f;
+                float phic = 0.0f;
+
+                for (int j = 0; j < Mode::NDOWNSPS; ++j)
+                {
+                    csyncs[0][i][j] = std::polar(1.0f, phia);
+                    csyncs[1][i][j] = std::polar(1.0f, phib);
+                    csyncs[2][i][j] = std::polar(1.0f, phic);
+
+                    phia = std::fmod(phia + dphia, TAU);
+                    phib = std::fmod(phib + dphib, TAU);
+                    phic = std::fmod(phic + dphic, TAU);
+                }
+            }
+
+            // Compute a Hann-like window directly into the real part of the
+            // first NFILT + 1 elements in the filter, accumulating the sum
+            // as we go.
+
+            sum = 0.0f;
+
+            for (int j = -NFILT / 2; j <= NFILT / 2; ++j)
+            {
+                int   const index = j + NFILT / 2;
+                float const value = std::pow(std::cos(pi * j / NFILT), 2);
+
+                filter[index].real(value);
+                sum             += value;
+            }
+
+            // Now that we've got the sum, create actual complex numbers using
+            // the normalized real values that we just populated and zero the
+            // rest of the filter.
+
+            std::fill(std::transform(filter.begin(),
+                                     filter.begin() + NFILT + 1,
+                                     filter.begin(),
+                                     [sum](auto const value)
+                                     {
+                                         return std::complex<float>(value.real() / sum, 0.0f);
+                                     }),
+                      filter.end(),
+                      ZERO);
+
+            // Shift to position the window.
+
+            std::rotate(filter.begin(),
+                        filter.begin() + NFILT / 2,
+                        filter.begin() + NFILT + 1);
+
+            // Transform the filter into the frequency domain.
+
+            fftwf_plan fftw_plan;
+            {
+                std::lock_guard<std::mutex> lock(fftw_mutex);
+
+                fftw_plan = fftwf_plan_dft_1d(Mode::NMAX,
+                                              reinterpret_cast<fftwf_complex *>(filter.data()),
+                                              reinterpret_cast<fftwf_complex *>(filter.data()),
+                                              FFTW_FORWARD,
+                                              FFTW_ESTIMATE_PATIENT);
+
+                if (!fftw_plan)
+                {
+                    throw std::runtime_error("Failed to create FFT plan");
+                }
+            }
+
+            fftwf_execute(fftw_plan);
+
+            {
+                std::lock_guard<std::mutex> lock(fftw_mutex);
+                fftwf_destroy_plan(fftw_plan);
+            }
+
+            // Normalize the frequency domain representation.
+
+            std::transform(filter.begin(),
+                           filter.end(),
+                           filter.begin(),
+                           [factor = 1.0f / Mode::NMAX](auto value)
+                           {
+                               return value * factor;
+                           });
+
+            // The rest of our FFT plans are always the same size and operate
+            // on arrays of the same alignment, so we plan them once against
+            // scratch arrays and execute them on each decoder's buffers.
+
+            std::lock_guard<std::mutex> lock(fftw_mutex);
+
+            auto const scratch = [](std::size_t const size)
+            {
+                return std::unique_ptr<fftwf_complex, void (*)(void *)>(fftwf_alloc_complex(size),
+                                                                        fftwf_free);
+            };
+
+            auto const ds = scratch(Mode::NDFFT2);
+            auto const bb = scratch(Mode::NDFFT1 / 2 + 1);
+            auto const cf = scratch(Mode::NMAX);
+            auto const sd = scratch(Mode::NFFT1  / 2 + 1);
+            auto const cs = scratch(Mode::NDOWNSPS);
+
+            plans[Plan::DS] = fftwf_plan_dft_1d(Mode::NDFFT2,
+                                                ds.get(),
+                                                ds.get(),
+                                                FFTW_BACKWARD,
+                                                FFTW_ESTIMATE_PATIENT);
+
+            plans[Plan::BB] = fftwf_plan_dft_r2c_1d(Mode::NDFFT1,
+                                                    reinterpret_cast<float *>(bb.get()),
+                                                    bb.get(),
+                                                    FFTW_ESTIMATE_PATIENT);
+
+            plans[Plan::CF] = fftwf_plan_dft_1d(Mode::NMAX,
+                                                cf.get(),
+                                                cf.get(),
+                                                FFTW_FORWARD,
+                                                FFTW_ESTIMATE_PATIENT);
+
+            plans[Plan::CB] = fftwf_plan_dft_1d(Mode::NMAX,
+                                                cf.get(),
+                                                cf.get(),
+                                                FFTW_BACKWARD,
+                                                FFTW_ESTIMATE_PATIENT);
+
+            plans[Plan::SD] = fftwf_plan_dft_r2c_1d(Mode::NFFT1,
+                                                    reinterpret_cast<float *>(sd.get()),
+                                                    sd.get(),
+                                                    FFTW_ESTIMATE_PATIENT);
+
+            plans[Plan::CS] = fftwf_plan_dft_1d(Mode::NDOWNSPS,
+                                                cs.get(),
+                                                cs.get(),
+                                                FFTW_FORWARD,
+                                                FFTW_ESTIMATE_PATIENT);
+
+            for (auto plan : plans)
+            {
+                if (!plan) throw std::runtime_error("Failed to create FFT plan");
+            }
+
+            isBuilt.store(true, std::memory_order_release);
+        }
+
+        inline static std::atomic<bool> isBuilt = false;
+    };
+
+    template <typename Mode>
+    class DecodeMode
+    {
+        // Data members
+
+        ModeTables<Mode> const &                                                      tables = ModeTables<Mode>::get();
+        alignas(64) std::array<std::complex<float>, Mode::NDOWNSPS>                   csymb;
         alignas(64) std::array<std::complex<float>, Mode::NMAX>                       cfilt;
         alignas(64) std::array<std::complex<float>, Mode::NDFFT1 / 2 + 1>             ds_cx;
         alignas(64) std::array<std::complex<float>, Mode::NFFT1  / 2 + 1>             sd;
@@ -1147,7 +1462,8 @@ namespace
         std::array<float, Mode::NMAX>                                                 dd;
         std::array<std::array<float, Mode::NHSYM>, Mode::NSPS>                        s;
         std::array<float, Mode::NSPS>                                                 savg;
-        FFTWPlanManager                                                               plans;
+        std::array<float, Mode::NSPS>                                                 slin;
+        std::array<bool,  Mode::NSPS>                                                 gate;
         SyncIndex                                                                     sync;
 
         using Plan = FFTWPlanManager::Type;
@@ -1211,7 +1527,8 @@ namespace
                float             & xdt,
                int               & nharderrors,
                float             & xsnr,
-               EventEmitter emitEvent)
+               EventEmitter emitEvent,
+               events::DecodeMetrics & metrics)
         {
             constexpr float FR  = 12000.0f / Mode::NFFT1;  // Frequency resolution
             constexpr float FS2 = 12000.0f / Mode::NDOWN;
@@ -1226,7 +1543,12 @@ namespace
 
             // Downsample the signal and prepare for processing.
 
-            js8_downsample(f1);
+            {
+                StageTimer timer(metrics.downsample);
+                js8_downsample(f1);
+            }
+
+            StageTimer searchTimer(metrics.search);
 
             // Initial guess for the start of the signal.
 
@@ -1297,6 +1619,9 @@ namespace
 
             float const sync = syncjs8d(i0, 0.0f);
 
+            searchTimer.stop();
+            StageTimer demodTimer(metrics.demod);
+
             std::array<std::array<float, NN>, NROWS> s2;
 
 #ifdef __ANDROID__
@@ -1332,7 +1657,9 @@ namespace
                 }
 #endif
 
-                fftwf_execute(plans[Plan::CS]);
+                fftwf_execute_dft(tables.plans[Plan::CS],
+                                  reinterpret_cast<fftwf_complex *>(csymb.data()),
+                                  reinterpret_cast<fftwf_complex *>(csymb.data()));
 
                 // Normalize and take the magnitude of the first 8 points.
 
@@ -1463,6 +1790,8 @@ namespace
             normalizeLLR(llr0);
             normalizeLLR(llr1);
 
+            demodTimer.stop();
+
             std::array<int8_t, K> decoded;
             std::array<int8_t, N> cw;
 
@@ -1481,7 +1810,10 @@ namespace
 
                 // Decode using belief propagation.
 
-                nharderrors = bpdecode174(llr, decoded, cw);
+                {
+                    StageTimer timer(metrics.bp);
+                    nharderrors = bpdecode174(llr, decoded, cw);
+                }
                 xsnr        = -99.0f;
 
 #ifdef __ANDROID__
@@ -1517,6 +1849,8 @@ namespace
 #endif
                    if (crc_ok)
                    {
+                        ++metrics.candidates_decoded;
+
                         if (syncStats)
                         {
                             events::SyncState evt;
@@ -1540,7 +1874,11 @@ namespace
 
                         // Subtract signal if needed.
 
-                        if (lsubtract) subtractjs8(genjs8refsig(itone, f1), xdt2);
+                        if (lsubtract)
+                        {
+                            StageTimer timer(metrics.subtract);
+                            subtractjs8(genjs8refsig(itone, f1), xdt2);
+                        }
 
                         // Compute the signal power.
 
@@ -1686,21 +2024,70 @@ namespace
             }
         }
 
-        // Extracted from the downsampling process; this step is part of the
-        // frequency-domain filtering process for downsampling the JS8 signal.
-        // After the FFT, the resulting frequency-domain data (ds_cx) can be
-        // manipulated (e.g., band-pass filtered or shifted). Subsequent inverse
-        // FFT operations convert the filtered data back to the time domain at
-        // a lower sample rate, achieving the desired downsampling.
-
-        void
-        computeBasebandFFT()
+        // Mark the bins in [ia, ib] worth a full sync search. For each bin,
+        // compare the power averaged over the GATE_SPAN bins above it, taken
+        // from `slin`, the linear average spectrum, against the baseline now
+        // in `savg`; bins that clear it by at least `marginDb`, and their
+        // GATE_GUARD neighbours, are marked in `gate`. Returns the number of
+        // bins marked.
+        //
+        // A signal's average power over its own width clears the baseline
+        // well before it can be decoded; at each submode's decoding threshold
+        // it's 0.5 dB or more above it, while in noise the ratio centres on
+        // -0.2 dB and rarely reaches +0.3 dB. The baseline is only defined on
+        // [ia, ib], so spans reaching past ib use its value at ib.
+
+        int
+        gatejs8(int   const ia,
+                int   const ib,
+                float const marginDb)
         {
-            // ds_dx is an array of complex<float>; we're going to do an in-place
-            // FFT, so we'll interpret the first half of the array as if they were
-            // floats, which they are.
+            int const end = std::min(ib + GATE_SPAN + 1, Mode::NSPS);
 
-            float * fftw_real = reinterpret_cast<float *>(ds_cx.data());
+            std::vector<double> power(end - ia + 1, 0.0);
+            std::vector<double> noise(end - ia + 1, 0.0);
+
+            for (int i = ia; i < end; ++i)
+            {
+                power[i - ia + 1] = power[i - ia] + slin[i];
+                noise[i - ia + 1] = noise[i - ia] + std::pow(10.0, savg[std::min(i, ib)] / 10.0);
+            }
+
+            double const threshold = std::pow(10.0, marginDb / 10.0);
+
+            gate.fill(false);
+
+            for (int i = ia; i <= ib; ++i)
+            {
+                int const lo = i - ia;
+                int const hi = std::min(i + GATE_SPAN + 1, end) - ia;
+
+                if (power[hi] - power[lo] >= threshold * (noise[hi] - noise[lo]))
+                {
+                    std::fill(gate.begin() + std::max(ia, i - GATE_GUARD),
+                              gate.begin() + std::min(ib, i + GATE_GUARD) + 1,
+                              true);
+                }
+            }
+
+            return static_cast<int>(std::count(gate.begin() + ia, gate.begin() + ib + 1, true));
+        }
+
+        // Extracted from the downsampling process; this step is part of the
+        // frequency-domain filtering process for downsampling the JS8 signal.
+        // After the FFT, the resulting frequency-domain data (ds_cx) can be
+        // manipulated (e.g., band-pass filtered or shifted). Subsequent inverse
+        // FFT operations convert the filtered data back to the time domain at
+        // a lower sample rate, achieving the desired downsampling.
+
+        void
+        computeBasebandFFT()
+        {
+            // ds_dx is an array of complex<float>; we're going to do an in-place
+            // FFT, so we'll interpret the first half of the array as if they were
+            // floats, which they are.
+
+            float * fftw_real = reinterpret_cast<float *>(ds_cx.data());
 
             // Copy in data and zero-pad any remainder; not all modes will have
             // a remainder.
@@ -1708,7 +2095,9 @@ namespace
             std::copy(dd.begin(), dd.end(),  fftw_real);
             std::fill(fftw_real + dd.size(), fftw_real + Mode::NDFFT1, 0.0f);
 
-            fftwf_execute(plans[Plan::BB]);
+            fftwf_execute_dft_r2c(tables.plans[Plan::BB],
+                                  fftw_real,
+                                  reinterpret_cast<fftwf_complex *>(ds_cx.data()));
         }
 
         // This function extracts a narrow frequency band around the target frequency f0,
@@ -1794,7 +2183,9 @@ namespace
             // back into the time domain, effectively yielding a downsampled, time-domain signal
             // focused on the extracted narrow frequency band.
 
-            fftwf_execute(plans[Plan::DS]);
+            fftwf_execute_dft(tables.plans[Plan::DS],
+                              reinterpret_cast<fftwf_complex *>(cd0.data()),
+                              reinterpret_cast<fftwf_complex *>(cd0.data()));
 
 #ifdef __ANDROID__
             if (rotate_log_count <= 3) {
@@ -1842,28 +2233,35 @@ namespace
 	    //     - Baseline is computed to distinguish significant signal components from
         //       background noise.
         //
-	    // 4.  Synchronization Metric Calculation:
+	    // 4.  Energy Gate:
 	    //
-        //     - For each frequency bin in the specified range, evaluates synchronization
-        //       power using a Costas waveform.
+        //     - If a gate margin is given, bins whose span shows no energy above the
+        //       baseline are marked quiet; see gatejs8().
+        //
+	    // 5.  Synchronization Metric Calculation:
+	    //
+        //     - For each frequency bin in the specified range that isn't quiet, or for
+        //       a regular sample of the quiet ones, evaluates synchronization power
+        //       using a Costas waveform.
 	    //     - Sync metric is computed over the index range, considering all combinations
         //       of Costas patterns.
 	    //     - The maximum sync value and its corresponding offset are recorded for each
         //       frequency bin.
 	    //
-        // 5.  Normalization:
+        // 6.  Normalization:
 	    //
         //     - The sync values are normalized to the 40th percentile value using a ranked
         //       index. This ensures a consistent scaling across different signals and noise
-        //       levels.
+        //       levels. When the gate skipped bins, the percentile is taken over the
+        //       searched bins with each quiet sample weighted by the bins it stands for.
         //
-	    // 6.  Candidate Extraction:
+	    // 7.  Candidate Extraction:
         //
         //     - Candidates with a strong sync metric (above a defined threshold) are extracted.
 	    //     - Near-duplicate candidates of lesser synchronization power, based on frequency
         //       proximity, are eliminated.
         //
-	    // 7.  Output:
+	    // 8.  Output:
         //
         //	   - Returns a vector of the most promising signal candidates, sorted by their
         //       synchronization power. It's expected that these will be re-sorted by the
@@ -1876,8 +2274,10 @@ namespace
         //       in this version.
 
         std::vector<Sync>
-        syncjs8(int nfa,
-                int nfb)
+        syncjs8(int                  nfa,
+                int                  nfb,
+                std::optional<float> gateDb,
+                events::DecodeMetrics & metrics)
         {
             // Compute symbol spectra
 
@@ -1892,11 +2292,13 @@ namespace
 
                 std::transform(dd.begin() + ia,
                                dd.begin() + ib,
-                               nuttal.begin(),
+                               tables.nuttal.begin(),
                                reinterpret_cast<float *>(sd.data()),
                                std::multiplies<float>{});
 
-                fftwf_execute(plans[Plan::SD]);
+                fftwf_execute_dft_r2c(tables.plans[Plan::SD],
+                                      reinterpret_cast<float         *>(sd.data()),
+                                      reinterpret_cast<fftwf_complex *>(sd.data()));
 
                 // Compute power spectrum
 
@@ -1928,16 +2330,36 @@ namespace
             auto const ib =             static_cast<int>(std::round(nfb / Mode::DF));
 
             // Convert average spectrum from power to db scale and compute
-            // baseline from it; baseline replaces average spectrum.
+            // baseline from it; baseline replaces average spectrum, so the
+            // energy gate needs a copy of it first.
+
+            if (gateDb) std::copy(savg.begin(), savg.end(), slin.begin());
 
             baselinejs8(ia, ib);
 
-            // Compute and populate the sync index.
+            // On a busy band the gate would skip little, and the baseline
+            // it measures against sits on weak signals rather than noise;
+            // search everything there.
+
+            if (gateDb && gatejs8(ia, ib, *gateDb) > (ib - ia + 1) * GATE_BUSY / 100) gateDb.reset();
+
+            // Compute and populate the sync index. With the gate on, quiet
+            // bins are sampled, and the samples' sync values are kept along
+            // with every searched bin's for the percentile below.
 
             sync.clear();
 
+            std::vector<std::pair<float, bool>> searched;
+            int quiet = 0;
+            int sampled = 0;
+
             for (int i = ia; i <= ib; ++i)
             {
+                bool const active = !gateDb || gate[i];
+
+                if (!active && quiet++ % GATE_STRIDE != 0) continue;
+                if (!active) ++sampled;
+
                 float max_value = -std::numeric_limits<float>::infinity();
                 int   max_index = -Mode::JZ;
 
@@ -2001,8 +2423,15 @@ namespace
                 sync.emplace(Mode::DF    * i,
                              Mode::TSTEP * (max_index + 0.5f),
                                             max_value);
+
+                if (gateDb) searched.emplace_back(std::isnan(max_value) ? -std::numeric_limits<float>::infinity()
+                                                                        : max_value,
+                                                  active);
             }
 
+            metrics.sync_bins         += static_cast<int>(sync.size());
+            metrics.sync_bins_skipped += quiet - sampled;
+
             // If we found nothing, we're done here.
 
             if (sync.empty()) return {};
@@ -2020,9 +2449,31 @@ namespace
             // times low, infrequently actually the 40th percentile value.
             // This method should be perfectly accurate in all cases.
 
+            auto const percentile = [&]
+            {
+                if (quiet == sampled) return rankIndex.nth(rankIndex.size() * 4 / 10)->sync;
+
+                // Weighted: each quiet sample counts for quiet / sampled bins,
+                // so the total weight is the number of bins in [ia, ib].
+
+                std::sort(searched.begin(), searched.end());
+
+                double const weight = static_cast<double>(quiet) / sampled;
+                double const target = static_cast<double>((ib - ia + 1) * 4 / 10);
+                double       sum    = 0.0;
+
+                for (auto const & [value, active] : searched)
+                {
+                    sum += active ? 1.0 : weight;
+                    if (sum > target) return value;
+                }
+
+                return searched.back().first;
+            };
+
             auto const normalize =
             [
-               sync = rankIndex.nth(rankIndex.size() * 4 / 10)->sync
+               sync = percentile()
             ]
             (Sync & entry)
             {
@@ -2130,7 +2581,7 @@ namespace
                                 [&](auto const & fa,    // Conjugate and multiply
                                     auto const & cd)
                                 {
-                                    return cd * std::conj(fa * csyncs[i][j][&fa - &freqAdjust[0]]);
+                                    return cd * std::conj(fa * tables.csyncs[i][j][&fa - &freqAdjust[0]]);
                                 }
                             ));
                     }
@@ -2211,19 +2662,23 @@ namespace
 
             // FFT to the frequency domain.
 
-            fftwf_execute(plans[Plan::CF]);
+            fftwf_execute_dft(tables.plans[Plan::CF],
+                              reinterpret_cast<fftwf_complex *>(cfilt.data()),
+                              reinterpret_cast<fftwf_complex *>(cfilt.data()));
 
             // Apply the filter in the frequency domain.
 
             std::transform(cfilt.begin(),
                            cfilt.end(),
-                           filter.begin(),
+                           tables.filter.begin(),
                            cfilt.begin(),
                            std::multiplies<>());
 
             // Inverse FFT to return to the time domain.
 
-            fftwf_execute(plans[Plan::CB]);
+            fftwf_execute_dft(tables.plans[Plan::CB],
+                              reinterpret_cast<fftwf_complex *>(cfilt.data()),
+                              reinterpret_cast<fftwf_complex *>(cfilt.data()));
 
             // Subtract the reconstructed signal.
 
@@ -2235,194 +2690,14 @@ namespace
 
     public:
 
-        // Constructor
-
-        DecodeMode()
-        {
-            // Intialize the Nuttal window. In theory, we can do this as a
-            // constexpr function at compile time, but doing so yield results
-            // slightly different than the Fortran version did, so for sanity
-            // while testing, we'll opt for consistency. IEEE 754 is always a
-            // bit brittle.
-
-            constexpr float a0 =  0.3635819f;
-            constexpr float a1 = -0.4891775f;
-            constexpr float a2 =  0.1365995f;
-            constexpr float a3 = -0.0106411f;
-
-            // Computed Pi constant to match the Fortran version; we could
-            // probably use std::numbers::pi_v<float> here, but for the
-            // moment, matching Fortran exactly.
-
-            float const pi  = 4.0f * std::atan(1.0f);
-            float       sum = 0.0f;
-
-            for (std::size_t i = 0; i < nuttal.size(); ++i)
-            {
-                // Naive summation here will exhibit substantial precision loss
-                // relative to the Fortran version; we use Kahan summation to
-                // compensate, which should yield results identical to Fortran.
-
-                KahanSum value = a0;
-
-                value += a1 * std::cos(2 * pi * i / nuttal.size());
-                value += a2 * std::cos(4 * pi * i / nuttal.size());
-                value += a3 * std::cos(6 * pi * i / nuttal.size());
-
-                nuttal[i] = value;
-                sum      += value;
-            }
-
-            // Normalize the Nuttal window.
-
-            for (auto & value : nuttal) value = value / sum * nuttal.size() / 300.0f;
-
-            // Initialize Costas waveforms.
-
-            for (int i = 0; i < 7; ++i)
-            {
-                float const dphia = TAU * Costas[0][i] / Mode::NDOWNSPS;
-                float const dphib = TAU * Costas[1][i] / Mode::NDOWNSPS;
-                float const dphic = TAU * Costas[2][i] / Mode::NDOWNSPS;
-
-                float phia = 0.0f;
-                float phib = 0.0f;
-                float phic = 0.0f;
-
-                for (int j = 0; j < Mode::NDOWNSPS; ++j)
-                {
-                    csyncs[0][i][j] = std::polar(1.0f, phia);
-                    csyncs[1][i][j] = std::polar(1.0f, phib);
-                    csyncs[2][i][j] = std::polar(1.0f, phic);
-
-                    phia = std::fmod(phia + dphia, TAU);
-                    phib = std::fmod(phib + dphib, TAU);
-                    phic = std::fmod(phic + dphic, TAU);
-                }
-            }
-
-            // Compute a Hann-like window directly into the real part of the
-            // first NFILT + 1 elements in the filter, accumulating the sum
-            // as we go.
-
-            sum = 0.0f;
-
-            for (int j = -NFILT / 2; j <= NFILT / 2; ++j)
-            {
-                int   const index = j + NFILT / 2;
-                float const value = std::pow(std::cos(pi * j / NFILT), 2);
-
-                filter[index].real(value);
-                sum             += value;
-            }
-
-            // Now that we've got the sum, create actual complex numbers using
-            // the normalized real values that we just populated and zero the
-            // rest of the filter.
-
-            std::fill(std::transform(filter.begin(),
-                                     filter.begin() + NFILT + 1,
-                                     filter.begin(),
-                                     [sum](auto const value)
-                                     {
-                                         return std::complex<float>(value.real() / sum, 0.0f);
-                                     }),
-                      filter.end(),
-                      ZERO);
-
-            // Shift to position the window.
-
-            std::rotate(filter.begin(),
-                        filter.begin() + NFILT / 2,
-                        filter.begin() + NFILT + 1);
-
-            // Transform the filter into the frequency domain.
-
-            fftwf_plan fftw_plan;
-            {
-                std::lock_guard<std::mutex> lock(fftw_mutex);
-
-                fftw_plan = fftwf_plan_dft_1d(Mode::NMAX,
-                                              reinterpret_cast<fftwf_complex *>(filter.data()),
-                                              reinterpret_cast<fftwf_complex *>(filter.data()),
-                                              FFTW_FORWARD,
-                                              FFTW_ESTIMATE_PATIENT);
-
-                if (!fftw_plan)
-                {
-                    throw std::runtime_error("Failed to create FFT plan");
-                }
-            }
-
-            fftwf_execute(fftw_plan);
-
-            {
-                std::lock_guard<std::mutex> lock(fftw_mutex);
-                fftwf_destroy_plan(fftw_plan);
-            }
-
-            // Normalize the frequency domain representation.
-
-            std::transform(filter.begin(),
-                           filter.end(),
-                           filter.begin(),
-                           [factor = 1.0f / Mode::NMAX](auto value)
-                           {
-                               return value * factor;
-                           });
-
-            // The rest of our FFT plans are always the same size and operate on the
-            // same data, so we can reuse them as long as we're alive.
-
-            std::lock_guard<std::mutex> lock(fftw_mutex);
-
-            plans[Plan::DS] = fftwf_plan_dft_1d(Mode::NDFFT2,
-                                                reinterpret_cast<fftwf_complex *>(cd0.data()),
-                                                reinterpret_cast<fftwf_complex *>(cd0.data()),
-                                                FFTW_BACKWARD,
-                                                FFTW_ESTIMATE_PATIENT);
-
-            plans[Plan::BB] = fftwf_plan_dft_r2c_1d(Mode::NDFFT1,
-                                                    reinterpret_cast<float         *>(ds_cx.data()),
-                                                    reinterpret_cast<fftwf_complex *>(ds_cx.data()),
-                                                    FFTW_ESTIMATE_PATIENT);
-
-            plans[Plan::CF] = fftwf_plan_dft_1d(Mode::NMAX,
-                                                reinterpret_cast<fftwf_complex *>(cfilt.data()),
-                                                reinterpret_cast<fftwf_complex *>(cfilt.data()),
-                                                FFTW_FORWARD,
-                                                FFTW_ESTIMATE_PATIENT);
-
-            plans[Plan::CB] = fftwf_plan_dft_1d(Mode::NMAX,
-                                                reinterpret_cast<fftwf_complex *>(cfilt.data()),
-                                                reinterpret_cast<fftwf_complex *>(cfilt.data()),
-                                                FFTW_BACKWARD,
-                                                FFTW_ESTIMATE_PATIENT);
-
-            plans[Plan::SD] = fftwf_plan_dft_r2c_1d(Mode::NFFT1,
-                                                    reinterpret_cast<float         *>(sd.data()),
-                                                    reinterpret_cast<fftwf_complex *>(sd.data()),
-                                                    FFTW_ESTIMATE_PATIENT);
-
-            plans[Plan::CS] = fftwf_plan_dft_1d(Mode::NDOWNSPS,
-                                                reinterpret_cast<fftwf_complex *>(csymb.data()),
-                                                reinterpret_cast<fftwf_complex *>(csymb.data()),
-                                                FFTW_FORWARD,
-                                                FFTW_ESTIMATE_PATIENT);
-
-            for (auto plan : plans)
-            {
-                if (!plan) throw std::runtime_error("Failed to create FFT plan");
-            }
-        }
-
         // Decode entry point.
 
         std::size_t
         operator()(dec_data const & data,
                    int       const   kpos,
                    int       const   ksz,
-                   EventEmitter     emitEvent)
+                   EventEmitter     emitEvent,
+                   events::DecodeMetrics & metrics)
         {
             // Copy the relevant frames for decoding
 
@@ -2471,8 +2746,17 @@ namespace
                 // yield more results. If we do have some candidates, sort them
                 // by frequency, but put any that are close to nfqso up front.
 
+                ++metrics.passes;
+
+                trace::Span passSpan("legacy_decode pass", "decoder", "pass", ipass);
+
+                StageTimer syncTimer(metrics.sync);
                 auto candidates = syncjs8(data.params.nfa,
-                                          data.params.nfb);
+                                          data.params.nfb,
+                                          data.params.syncGate ? std::optional<float>(data.params.syncGateDb)
+                                                               : std::nullopt,
+                                          metrics);
+                syncTimer.stop();
 
 #ifdef __ANDROID__
                 __android_log_print(ANDROID_LOG_INFO, "JS8Decoder",
@@ -2505,7 +2789,10 @@ namespace
                                    "Computing baseband FFT for pass %d", ipass);
 #endif
 
-                computeBasebandFFT();
+                {
+                    StageTimer timer(metrics.downsample);
+                    computeBasebandFFT();
+                }
 
 #ifdef __ANDROID__
                 __android_log_print(ANDROID_LOG_DEBUG, "JS8Decoder",
@@ -2520,13 +2807,16 @@ namespace
                     float xsnr        =  0.0f;
                     int   nharderrors = -1;
 
+                    ++metrics.candidates_tried;
+
                     if (auto decode = js8dec(data.params.syncStats,
                                              subtract,
                                              f1,
                                              xdt,
                                              nharderrors,
                                              xsnr,
-                                             emitEvent))
+                                             emitEvent,
+                                             metrics))
                     {
                         // We don't need to be emitting duplicate events for something
                         // that's effectively the same SNR as a previous event.
@@ -2582,37 +2872,212 @@ namespace
     template class DecodeMode<ModeI>;
 }
 
-std::size_t legacy_decode(DecodeState const& state,
-                          std::function<void(events::Variant const&)> emit_fn)
+// Per-submode decoder state is built on first use and may be released again,
+// under DecoderMemoryConfig; slots are indexed by protocol::SubmodeId.
+
+struct Decoder::Impl
 {
-    using DecoderRef = std::variant<
-        std::reference_wrapper<DecodeMode<ModeA>>,
-        std::reference_wrapper<DecodeMode<ModeB>>,
-        std::reference_wrapper<DecodeMode<ModeC>>,
-        std::reference_wrapper<DecodeMode<ModeE>>,
-        std::reference_wrapper<DecodeMode<ModeI>>>;
+    using Clock = std::chrono::steady_clock;
 
-    struct DecodeEntry
+    template <typename Mode>
+    struct Slot
     {
-        DecoderRef decode;
-        int        mode;
-        int        kpos;
-        int        ksz;
+        using State  = DecodeMode<Mode>;
+        using Tables = ModeTables<Mode>;
+
+        static constexpr std::size_t bytes = sizeof(State);
+
+        std::unique_ptr<State> state;
+        Clock::time_point      used;
     };
 
-    // Keep decoder instances in static storage to avoid heavy stack allocations.
-    static DecodeMode<ModeA> decA;
-    static DecodeMode<ModeB> decB;
-    static DecodeMode<ModeC> decC;
-    static DecodeMode<ModeE> decE;
-    static DecodeMode<ModeI> decI;
+    DecoderMemoryConfig config;
+
+    std::tuple<Slot<ModeA>,
+               Slot<ModeB>,
+               Slot<ModeC>,
+               Slot<ModeE>,
+               Slot<ModeI>> slots;
+
+    // Invokes f(id, slot) for every slot.
+
+    template <typename F>
+    void
+    forEach(F && f)
+    {
+        std::apply([&](auto & ... slot)
+        {
+            int id = 0;
+            (f(id++, slot), ...);
+        }, slots);
+    }
+
+    template <typename F>
+    void
+    forEach(F && f) const
+    {
+        std::apply([&](auto const & ... slot)
+        {
+            int id = 0;
+            (f(id++, slot), ...);
+        }, slots);
+    }
+
+    std::size_t
+    residentBytes() const
+    {
+        std::size_t sum = 0;
+        forEach([&](int, auto const & slot) { if (slot.state) sum += slot.bytes; });
+        return sum;
+    }
+
+    void
+    release(int const submodes)
+    {
+        forEach([&](int const id, auto & slot) { if (submodes & (1 << id)) slot.state.reset(); });
+    }
+
+    // Releases least recently used states outside `keep` until `need` more
+    // bytes fit the budget, or nothing else can go.
+
+    void
+    makeRoom(std::size_t const need,
+             int         const keep)
+    {
+        if (!config.budget_bytes) return;
+
+        while (residentBytes() + need > config.budget_bytes)
+        {
+            int               victim = -1;
+            Clock::time_point oldest = Clock::time_point::max();
+
+            forEach([&](int const id, auto const & slot)
+            {
+                if (slot.state && !(keep & (1 << id)) && slot.used < oldest)
+                {
+                    victim = id;
+                    oldest = slot.used;
+                }
+            });
+
+            if (victim < 0) return;
+
+            release(1 << victim);
+        }
+    }
+
+    // Runs f on the state of `slot`, building it first if need be; `keep`
+    // holds the submodes the decode in progress has still to run.
+
+    template <typename Mode, typename F>
+    void
+    use(Slot<Mode> & slot,
+        int  const   keep,
+        F         && f)
+    {
+        if (!slot.state)
+        {
+            makeRoom(slot.bytes, keep);
+            slot.state = std::make_unique<typename Slot<Mode>::State>();
+        }
+
+        f(*slot.state);
+
+        slot.used = Clock::now();
+
+        if (config.budget_bytes && residentBytes() > config.budget_bytes) slot.state.reset();
+    }
+
+    template <typename F>
+    void
+    use(int  const   id,
+        int  const   keep,
+        F         && f)
+    {
+        switch (id)
+        {
+            case 0: use(std::get<0>(slots), keep, f); break;
+            case 1: use(std::get<1>(slots), keep, f); break;
+            case 2: use(std::get<2>(slots), keep, f); break;
+            case 3: use(std::get<3>(slots), keep, f); break;
+            case 4: use(std::get<4>(slots), keep, f); break;
+        }
+    }
+
+    void
+    releaseIdle()
+    {
+        if (config.release_after <= std::chrono::seconds::zero()) return;
+
+        auto const now = Clock::now();
+
+        forEach([&](int, auto & slot)
+        {
+            if (slot.state && now - slot.used >= config.release_after) slot.state.reset();
+        });
+    }
+};
+
+Decoder::Decoder(DecoderMemoryConfig config)
+: impl_(std::make_unique<Impl>())
+{
+    impl_->config = config;
+}
+
+Decoder::~Decoder() = default;
+
+void Decoder::release(int const submodes)
+{
+    impl_->release(submodes);
+}
+
+int Decoder::resident() const
+{
+    int mask = 0;
+    impl_->forEach([&](int const id, auto const & slot) { if (slot.state) mask |= 1 << id; });
+    return mask;
+}
+
+std::size_t Decoder::resident_bytes() const
+{
+    return impl_->residentBytes();
+}
+
+DecoderMemory Decoder::memory() const
+{
+    DecoderMemory memory{};
+
+    impl_->forEach([&](int const id, auto const & slot)
+    {
+        using Tables = typename std::decay_t<decltype(slot)>::Tables;
+
+        auto & entry = memory[id];
+
+        entry.state_bytes  = slot.bytes;
+        entry.table_bytes  = sizeof(Tables);
+        entry.decoders     = slot.state ? 1 : 0;
+        entry.tables_built = Tables::built();
+    });
+
+    return memory;
+}
+
+std::size_t Decoder::decode(DecodeState const& state,
+                            std::function<void(events::Variant const&)> emit_fn)
+{
+    struct DecodeEntry
+    {
+        int id;
+        int kpos;
+        int ksz;
+    };
 
     std::array<DecodeEntry, 5> entries{{
-        DecodeEntry{DecoderRef{std::ref(decI)}, 1 << 4, state.params.kposI, state.params.kszI},
-        DecodeEntry{DecoderRef{std::ref(decE)}, 1 << 3, state.params.kposE, state.params.kszE},
-        DecodeEntry{DecoderRef{std::ref(decC)}, 1 << 2, state.params.kposC, state.params.kszC},
-        DecodeEntry{DecoderRef{std::ref(decB)}, 1 << 1, state.params.kposB, state.params.kszB},
-        DecodeEntry{DecoderRef{std::ref(decA)}, 1 << 0, state.params.kposA, state.params.kszA},
+        DecodeEntry{4, state.params.kposI, state.params.kszI},
+        DecodeEntry{3, state.params.kposE, state.params.kszE},
+        DecodeEntry{2, state.params.kposC, state.params.kszC},
+        DecodeEntry{1, state.params.kposB, state.params.kszB},
+        DecodeEntry{0, state.params.kposA, state.params.kszA},
     }};
 
     auto emit = [&](events::Variant const& ev)
@@ -2623,6 +3088,11 @@ std::size_t legacy_decode(DecodeState const& state,
     auto const set = state.params.nsubmodes;
     std::size_t sum = 0;
 
+    trace::Span span("legacy_decode", "decoder", "submodes", set);
+
+    events::DecodeMetrics metrics;
+    metrics.submodes = set;
+
 #ifdef __ANDROID__
     // Debug: Log that we're about to emit DecodeStarted
     __android_log_print(ANDROID_LOG_INFO, "JS8Decoder",
@@ -2637,22 +3107,37 @@ std::size_t legacy_decode(DecodeState const& state,
                        "DecodeStarted emitted, processing %d submodes", set);
 #endif
 
+    StageTimer total(metrics.total);
+
+    int pending = set;
+
     for (auto const & entry : entries)
     {
-        if ((set & entry.mode) == entry.mode)
+        int const mode = 1 << entry.id;
+
+        if ((set & mode) == mode)
         {
-            std::visit([&](auto && decode_ref)
+            trace::Span modeSpan("legacy_decode submode", "decoder", "submode", mode);
+
+            impl_->use(entry.id, pending, [&](auto & decode)
             {
-                sum += decode_ref.get()(state, entry.kpos, entry.ksz, emit);
-            }, entry.decode);
+                sum += decode(state, entry.kpos, entry.ksz, emit, metrics);
+            });
+
+            pending &= ~mode;
         }
     }
 
+    impl_->releaseIdle();
+
+    total.stop();
+
 #ifdef __ANDROID__
     __android_log_print(ANDROID_LOG_INFO, "JS8Decoder",
                        "Decode loop finished, sum=%zu, emitting DecodeFinished", sum);
 #endif
 
+    emit(metrics);
     emit(events::DecodeFinished{sum});
 
 #ifdef __ANDROID__
@@ -2663,6 +3148,19 @@ std::size_t legacy_decode(DecodeState const& state,
     return sum;
 }
 
+std::size_t legacy_decode(DecodeState const& state,
+                          std::function<void(events::Variant const&)> emit_fn)
+{
+    // One process-wide Decoder, kept in static storage to avoid heavy stack
+    // allocations; engines use the Decoders of their DecodePool instead.
+    static Decoder    decoder;
+    static std::mutex mutex;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return decoder.decode(state, std::move(emit_fn));
+}
+
 void
 legacy_encode(int           const   type,
               protocol::CostasArray const & costas,
@@ -0,0 +1,253 @@
+#include "js8core/dsp/channelizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <numeric>
+
+#include <fftw3.h>
+
+#include "commons.h"
+#include "js8core/compat/numbers.hpp"
+
+namespace js8core::dsp {
+
+namespace {
+
+// Channel filter: -6 dB at 0 Hz and kPassHz above the dial. With the
+// 2048-point channel FFT the Blackman-windowed design below has a
+// transition of about 130 Hz, so the opposite sideband is down some 70 dB
+// from 65 Hz below the dial.
+constexpr double kPassHz = 5400.0;
+constexpr std::size_t kMinChannelFft = 2048;
+
+template <typename T>
+fftwf_complex* fftw_cast(T* data) {
+  return reinterpret_cast<fftwf_complex*>(data);
+}
+
+}  // namespace
+
+struct Channelizer::Impl {
+  struct Channel {
+    std::vector<std::size_t> source;                 // input bin for each channel bin
+    std::vector<std::complex<float>> response;       // filter, including 1/N
+    std::int64_t bin = 0;                            // input bin nearest the dial
+    std::int64_t block_phase = 0;                    // (bin * S * block) mod N
+    std::complex<double> nco{1.0, 0.0};              // removes the rest of the offset
+    std::complex<double> nco_step{1.0, 0.0};
+  };
+
+  std::size_t n = 0;  // input FFT size
+  std::size_t l = 0;  // channel FFT size; n / l = input_rate / output_rate
+  std::size_t overlap = 0;  // n / 4 samples carried between blocks
+  std::vector<std::complex<float>> input;
+  std::vector<std::complex<float>> spectrum;
+  std::vector<std::complex<float>> work;
+  std::vector<float> out;
+  std::vector<Channel> channels;
+  std::size_t fill = 0;
+  std::size_t skip = 0;  // output still inside the filter delay
+  fftwf_plan forward = nullptr;
+  fftwf_plan inverse = nullptr;
+
+  ~Impl() { destroy_plans(); }
+
+  void destroy_plans() {
+    std::lock_guard<std::mutex> lock(fftw_mutex);
+    if (forward) fftwf_destroy_plan(forward);
+    if (inverse) fftwf_destroy_plan(inverse);
+    forward = inverse = nullptr;
+  }
+
+  void reset() {
+    std::fill(input.begin(), input.end(), std::complex<float>{});
+    fill = overlap;
+    skip = l / 8;
+    for (auto& ch : channels) {
+      ch.block_phase = 0;
+      ch.nco = {1.0, 0.0};
+    }
+  }
+
+  void run_block(Sink const& sink) {
+    fftwf_execute(forward);
+
+    std::size_t const first = l / 4;  // earlier outputs wrap around the block
+    std::size_t const count = l - first;
+    std::size_t const step = n - overlap;
+    double const tau = 2.0 * std::numbers::pi;
+
+    for (std::size_t c = 0; c < channels.size(); ++c) {
+      auto& ch = channels[c];
+      for (std::size_t j = 0; j < l; ++j) {
+        work[j] = spectrum[ch.source[j]] * ch.response[j];
+      }
+      fftwf_execute(inverse);
+
+      // The block was mixed down relative to its own first sample; rotate
+      // it onto the stream's time axis, then take the residual offset out.
+      double const angle = -tau * static_cast<double>(ch.block_phase) / static_cast<double>(n);
+      std::complex<double> const rotate = std::polar(1.0, angle);
+      for (std::size_t i = 0; i < count; ++i) {
+        auto const z = std::complex<double>(work[first + i]) * rotate * ch.nco;
+        out[i] = static_cast<float>(z.real());
+        ch.nco *= ch.nco_step;
+      }
+      ch.nco /= std::abs(ch.nco);
+      // |bin| and step are both below n, so this cannot overflow.
+      std::int64_t const size = static_cast<std::int64_t>(n);
+      ch.block_phase = ((ch.block_phase + ch.bin * static_cast<std::int64_t>(step)) % size + size) % size;
+
+      std::size_t const drop = std::min(skip, count);
+      sink(c, std::span<const float>(out.data() + drop, count - drop));
+    }
+    skip -= std::min(skip, count);
+  }
+};
+
+Channelizer::Channelizer() : impl_(std::make_unique<Impl>()) {}
+
+Channelizer::~Channelizer() = default;
+
+bool Channelizer::configure(int input_rate,
+                            FrequencyHz center_hz,
+                            std::vector<FrequencyHz> const& dials,
+                            int output_rate,
+                            std::string* error) {
+  auto fail = [&](char const* message) {
+    if (error) *error = message;
+    return false;
+  };
+  if (output_rate <= 0 || input_rate <= output_rate) {
+    return fail("IQ rate must be above the receiver rate");
+  }
+  if (dials.empty()) return fail("no dial frequencies");
+
+  auto impl = std::make_unique<Impl>();
+
+  // Block sizes: l output samples per channel FFT, n = l * input_rate /
+  // output_rate input samples, both integers; l a multiple of 8 so the
+  // filter delay (n / 8 in, l / 8 out) and the 3/4 block step are whole
+  // samples on both sides.
+  std::size_t const g = static_cast<std::size_t>(std::gcd(input_rate, output_rate));
+  std::size_t const unit = 8 * (static_cast<std::size_t>(output_rate) / g);
+  impl->l = (kMinChannelFft + unit - 1) / unit * unit;
+  impl->n = impl->l / (static_cast<std::size_t>(output_rate) / g) * (static_cast<std::size_t>(input_rate) / g);
+  impl->overlap = impl->n / 4;
+
+  double const bin_hz = static_cast<double>(output_rate) / static_cast<double>(impl->l);
+  double const half_span = input_rate / 2.0;
+  double const half_channel = output_rate / 2.0;
+  std::size_t const taps = impl->overlap + 1;
+  double const centre = (taps - 1) / 2.0;
+  double const tau = 2.0 * std::numbers::pi;
+
+  // Filter design scratch: one N-point FFT per channel.
+  std::vector<std::complex<float>> design(impl->n);
+  fftwf_plan design_plan;
+  {
+    std::lock_guard<std::mutex> lock(fftw_mutex);
+    design_plan = fftwf_plan_dft_1d(static_cast<int>(impl->n), fftw_cast(design.data()),
+                                    fftw_cast(design.data()), FFTW_FORWARD, FFTW_ESTIMATE);
+  }
+  if (!design_plan) return fail("failed to create FFT plan");
+
+  for (FrequencyHz const dial : dials) {
+    double const offset = static_cast<double>(dial) - static_cast<double>(center_hz);
+    if (offset - half_channel < -half_span || offset + half_channel > half_span) {
+      std::lock_guard<std::mutex> lock(fftw_mutex);
+      fftwf_destroy_plan(design_plan);
+      if (error) {
+        char msg[128];
+        std::snprintf(msg, sizeof(msg), "dial %llu Hz is outside the IQ span",
+                      static_cast<unsigned long long>(dial));
+        *error = msg;
+      }
+      return false;
+    }
+
+    Impl::Channel ch;
+    ch.bin = std::llround(offset / bin_hz);
+    double const residual = offset - static_cast<double>(ch.bin) * bin_hz;
+
+    // Blackman-windowed lowpass, shifted up so it spans the USB passband of
+    // the true dial, which sits `residual` above the channel's centre bin.
+    double const cutoff = kPassHz / 2.0 / input_rate;
+    double const shift = (kPassHz / 2.0 + residual) / input_rate;
+    std::fill(design.begin(), design.end(), std::complex<float>{});
+    double sum = 0.0;
+    std::vector<double> lowpass(taps);
+    for (std::size_t i = 0; i < taps; ++i) {
+      double const t = static_cast<double>(i) - centre;
+      double const sinc = t == 0.0 ? 2.0 * cutoff : std::sin(tau * cutoff * t) / (std::numbers::pi * t);
+      double const window = 0.42 - 0.5 * std::cos(tau * i / (taps - 1)) + 0.08 * std::cos(2.0 * tau * i / (taps - 1));
+      lowpass[i] = sinc * window;
+      sum += lowpass[i];
+    }
+    for (std::size_t i = 0; i < taps; ++i) {
+      double const t = static_cast<double>(i) - centre;
+      design[i] = std::complex<float>(std::polar(lowpass[i] / sum, tau * shift * t));
+    }
+    fftwf_execute(design_plan);
+
+    std::int64_t const n = static_cast<std::int64_t>(impl->n);
+    std::int64_t const l = static_cast<std::int64_t>(impl->l);
+    ch.source.resize(impl->l);
+    ch.response.resize(impl->l);
+    for (std::int64_t j = 0; j < l; ++j) {
+      std::int64_t const k = j < l / 2 ? j : j - l;
+      ch.source[j] = static_cast<std::size_t>(((ch.bin + k) % n + n) % n);
+      ch.response[j] = design[static_cast<std::size_t>((k + n) % n)] / static_cast<float>(impl->n);
+    }
+    ch.nco_step = std::polar(1.0, -tau * residual / output_rate);
+    impl->channels.push_back(std::move(ch));
+  }
+
+  impl->input.resize(impl->n);
+  impl->spectrum.resize(impl->n);
+  impl->work.resize(impl->l);
+  impl->out.resize(impl->l);
+  {
+    std::lock_guard<std::mutex> lock(fftw_mutex);
+    fftwf_destroy_plan(design_plan);
+    impl->forward = fftwf_plan_dft_1d(static_cast<int>(impl->n), fftw_cast(impl->input.data()),
+                                      fftw_cast(impl->spectrum.data()), FFTW_FORWARD, FFTW_ESTIMATE);
+    impl->inverse = fftwf_plan_dft_1d(static_cast<int>(impl->l), fftw_cast(impl->work.data()),
+                                      fftw_cast(impl->work.data()), FFTW_BACKWARD, FFTW_ESTIMATE);
+  }
+  if (!impl->forward || !impl->inverse) return fail("failed to create FFT plan");
+
+  impl->reset();
+  impl_ = std::move(impl);
+  return true;
+}
+
+void Channelizer::reset() { impl_->reset(); }
+
+std::size_t Channelizer::channels() const { return impl_->channels.size(); }
+
+std::size_t Channelizer::block_input() const { return impl_->n - impl_->overlap; }
+
+std::size_t Channelizer::block_output() const { return impl_->l - impl_->l / 4; }
+
+void Channelizer::process(std::span<const std::complex<float>> iq, Sink const& sink) {
+  auto& s = *impl_;
+  if (!s.forward) return;
+  std::size_t pos = 0;
+  while (pos < iq.size()) {
+    std::size_t const take = std::min(iq.size() - pos, s.n - s.fill);
+    std::copy_n(iq.data() + pos, take, s.input.data() + s.fill);
+    s.fill += take;
+    pos += take;
+    if (s.fill < s.n) break;
+
+    s.run_block(sink);
+    std::copy(s.input.end() - static_cast<std::ptrdiff_t>(s.overlap), s.input.end(), s.input.begin());
+    s.fill = s.overlap;
+  }
+}
+
+}  // namespace js8core::dsp
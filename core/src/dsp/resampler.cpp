@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <numeric>
 
 namespace js8core::dsp {
 
@@ -49,6 +51,40 @@ std::vector<std::vector<float>> build_polyphase(std::vector<float> const& taps,
   return phases;
 }
 
+// Kaiser-windowed sinc prototype for the rational resampler, normalised to a
+// DC gain of `gain`. `cutoff` is relative to the (virtual) upsampled rate.
+std::vector<float> make_kaiser_sinc(std::size_t num_taps, double cutoff, double beta, double gain) {
+  constexpr double kPi = 3.14159265358979323846;
+  auto bessel_i0 = [](double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum += term;
+    }
+    return sum;
+  };
+
+  std::vector<double> taps(num_taps);
+  double const centre = (static_cast<double>(num_taps) - 1.0) / 2.0;
+  double const denom = bessel_i0(beta);
+  double sum = 0.0;
+  for (std::size_t i = 0; i < num_taps; ++i) {
+    double n = static_cast<double>(i) - centre;
+    double sinc = (n == 0.0) ? 2.0 * cutoff : std::sin(2.0 * kPi * cutoff * n) / (kPi * n);
+    double r = centre > 0.0 ? n / centre : 0.0;
+    double window = bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / denom;
+    taps[i] = sinc * window;
+    sum += taps[i];
+  }
+
+  std::vector<float> out(num_taps);
+  for (std::size_t i = 0; i < num_taps; ++i) {
+    out[i] = static_cast<float>(sum != 0.0 ? taps[i] * gain / sum : 0.0);
+  }
+  return out;
+}
+
 }  // namespace
 
 std::vector<float> make_js8_fir(int input_rate, int target_rate) {
@@ -130,4 +166,97 @@ void Resampler::reset() {
   has_next_ = false;
 }
 
+void RationalResampler::configure(int input_rate, int output_rate) {
+  reset();
+  input_rate_ = input_rate;
+  output_rate_ = output_rate;
+  if (input_rate_ <= 0 || output_rate_ <= 0) return;
+
+  int const g = std::gcd(input_rate_, output_rate_);
+  up_ = output_rate_ / g;
+  down_ = input_rate_ / g;
+
+  // Prototype at the virtual rate input*up: a Kaiser sinc whose length grows
+  // with the conversion ratio, keeping the transition band (and ~80 dB
+  // stopband) roughly constant in output-rate terms for every device rate.
+  // The older 49-tap desktop FIR only reaches ~40 dB near 12 kHz, which folds
+  // straight back into the JS8 passband.
+  std::vector<float> prototype;
+  if (up_ != 1 || down_ != 1) {
+    int const ratio = std::max(up_, down_);
+    std::size_t const num_taps = static_cast<std::size_t>(16 * ratio + 1);
+    double const cutoff = 0.45 / static_cast<double>(ratio);
+    prototype = make_kaiser_sinc(num_taps, cutoff, 8.0, static_cast<double>(up_));
+  } else {
+    prototype = {1.0f};
+  }
+
+  taps_per_phase_ = static_cast<int>((prototype.size() + static_cast<std::size_t>(up_) - 1) /
+                                     static_cast<std::size_t>(up_));
+  phases_.assign(static_cast<std::size_t>(up_ * taps_per_phase_), 0.0f);
+  for (int p = 0; p < up_; ++p) {
+    float* row = phases_.data() + static_cast<std::size_t>(p * taps_per_phase_);
+    for (int i = 0; i < taps_per_phase_; ++i) {
+      std::size_t idx = static_cast<std::size_t>(p + i * up_);
+      // Row is laid out oldest-first to line up with the history window.
+      row[taps_per_phase_ - 1 - i] = idx < prototype.size() ? prototype[idx] : 0.0f;
+    }
+  }
+  history_.assign(static_cast<std::size_t>(2 * taps_per_phase_), 0.0f);
+}
+
+void RationalResampler::reset() {
+  input_rate_ = 0;
+  output_rate_ = 0;
+  up_ = 1;
+  down_ = 1;
+  taps_per_phase_ = 0;
+  phases_.clear();
+  history_.clear();
+  history_pos_ = 0;
+  phase_ = 0;
+  pending_ = 1;
+}
+
+std::size_t RationalResampler::max_output(std::size_t input_frames) const {
+  if (down_ <= 0) return 0;
+  return (input_frames * static_cast<std::size_t>(up_)) / static_cast<std::size_t>(down_) + 1;
+}
+
+std::size_t RationalResampler::process(std::span<const std::int16_t> input,
+                                       std::span<std::int16_t> output) {
+  if (taps_per_phase_ == 0) return 0;
+
+  int const taps = taps_per_phase_;
+  std::size_t written = 0;
+
+  for (auto sample : input) {
+    float const x = static_cast<float>(sample);
+    history_[static_cast<std::size_t>(history_pos_)] = x;
+    history_[static_cast<std::size_t>(history_pos_ + taps)] = x;
+    history_pos_ = history_pos_ + 1 == taps ? 0 : history_pos_ + 1;
+
+    if (--pending_ > 0) continue;
+
+    float const* window = history_.data() + history_pos_;
+    while (pending_ == 0) {
+      float const* row = phases_.data() + static_cast<std::size_t>(phase_ * taps);
+      float acc = 0.0f;
+      for (int i = 0; i < taps; ++i) {
+        acc += row[i] * window[i];
+      }
+      if (written < output.size()) {
+        float clamped = std::clamp(acc, -32768.0f, 32767.0f);
+        output[written++] = static_cast<std::int16_t>(std::lrint(clamped));
+      }
+
+      phase_ += down_;
+      pending_ = phase_ / up_;
+      phase_ %= up_;
+    }
+  }
+
+  return written;
+}
+
 }  // namespace js8core::dsp
@@ -0,0 +1,94 @@
+#include "js8core/dsp/sample_convert.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace js8core::dsp {
+
+namespace {
+
+// Round-to-nearest without lrint so the loops below stay vectorisable.
+inline std::int16_t float_to_int16(float v) {
+  float scaled = std::clamp(v * 32767.0f, -32768.0f, 32767.0f);
+  return static_cast<std::int16_t>(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+}
+
+// The mono cases are kept as separate contiguous loops; that is what lets the
+// compiler turn them into straight SIMD copies/conversions.
+void convert_int16(std::int16_t const* in, int stride, std::span<std::int16_t> out) {
+  if (stride == 1) {
+    std::copy_n(in, out.size(), out.data());
+    return;
+  }
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = in[i * static_cast<std::size_t>(stride)];
+  }
+}
+
+void convert_float(float const* in, int stride, std::span<std::int16_t> out) {
+  if (stride == 1) {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      out[i] = float_to_int16(in[i]);
+    }
+    return;
+  }
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = float_to_int16(in[i * static_cast<std::size_t>(stride)]);
+  }
+}
+
+template <typename T>
+int loudest(T const* in, std::size_t frames, int channels) {
+  int best = 0;
+  double best_sum = -1.0;
+  for (int ch = 0; ch < channels; ++ch) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < frames; ++i) {
+      sum += std::abs(static_cast<double>(in[i * static_cast<std::size_t>(channels) + ch]));
+    }
+    if (sum > best_sum) {
+      best = ch;
+      best_sum = sum;
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+std::size_t bytes_per_sample(SampleType type) {
+  switch (type) {
+    case SampleType::Int16:   return sizeof(std::int16_t);
+    case SampleType::Float32: return sizeof(float);
+  }
+  return 0;
+}
+
+int loudest_channel(std::span<const std::byte> data, SampleType type, int channels) {
+  if (channels <= 1) return 0;
+  auto const frame_bytes = bytes_per_sample(type) * static_cast<std::size_t>(channels);
+  if (frame_bytes == 0) return 0;
+  auto const frames = data.size() / frame_bytes;
+  if (type == SampleType::Float32) {
+    return loudest(reinterpret_cast<float const*>(data.data()), frames, channels);
+  }
+  return loudest(reinterpret_cast<std::int16_t const*>(data.data()), frames, channels);
+}
+
+void extract_channel(std::span<const std::byte> data,
+                     SampleType type,
+                     int channels,
+                     int channel,
+                     std::span<std::int16_t> out) {
+  if (channels <= 0 || channel < 0 || channel >= channels) return;
+  auto const frame_bytes = bytes_per_sample(type) * static_cast<std::size_t>(channels);
+  if (frame_bytes == 0 || data.size() < out.size() * frame_bytes) return;
+
+  if (type == SampleType::Float32) {
+    convert_float(reinterpret_cast<float const*>(data.data()) + channel, channels, out);
+  } else {
+    convert_int16(reinterpret_cast<std::int16_t const*>(data.data()) + channel, channels, out);
+  }
+}
+
+}  // namespace js8core::dsp
@@ -0,0 +1,86 @@
+#include "js8core/clock.hpp"
+
+#include <utility>
+
+namespace js8core {
+
+namespace {
+
+class RealClock : public Clock {
+public:
+  WallTimePoint wall_now() const override { return SystemClock::now(); }
+  SteadyTimePoint steady_now() const override { return SteadyClock::now(); }
+};
+
+}  // namespace
+
+Clock& real_clock() {
+  static RealClock instance;
+  return instance;
+}
+
+SimulatedClock::SimulatedClock(WallTimePoint start) : wall_start_(start) {}
+
+WallTimePoint SimulatedClock::wall_now() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return wall_start_ + std::chrono::duration_cast<SystemClock::duration>(elapsed_);
+}
+
+SteadyTimePoint SimulatedClock::steady_now() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return SteadyTimePoint{} + elapsed_;
+}
+
+TimerHandle SimulatedClock::call_after(SteadyDuration delay, std::function<void()> fn) {
+  return add_timer(delay, SteadyDuration::zero(), std::move(fn));
+}
+
+TimerHandle SimulatedClock::call_every(SteadyDuration period, std::function<void()> fn) {
+  return add_timer(period, period, std::move(fn));
+}
+
+void SimulatedClock::cancel(TimerHandle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  timers_.erase(handle);
+}
+
+TimerHandle SimulatedClock::add_timer(SteadyDuration delay, SteadyDuration period,
+                                      std::function<void()> fn) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TimerHandle const handle = next_handle_++;
+  timers_[handle] = Timer{SteadyTimePoint{} + elapsed_ + delay, period, std::move(fn)};
+  return handle;
+}
+
+void SimulatedClock::advance(SteadyDuration delta) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  SteadyTimePoint const target = SteadyTimePoint{} + elapsed_ + delta;
+
+  for (;;) {
+    auto due = timers_.end();
+    for (auto it = timers_.begin(); it != timers_.end(); ++it) {
+      if (it->second.deadline <= target &&
+          (due == timers_.end() || it->second.deadline < due->second.deadline)) {
+        due = it;
+      }
+    }
+    if (due == timers_.end()) break;
+
+    elapsed_ = due->second.deadline - SteadyTimePoint{};
+    auto fn = due->second.fn;
+    if (due->second.period > SteadyDuration::zero()) {
+      due->second.deadline += due->second.period;
+    } else {
+      timers_.erase(due);
+    }
+
+    // Run without the lock so callbacks may read the clock or (re)schedule.
+    lock.unlock();
+    if (fn) fn();
+    lock.lock();
+  }
+
+  elapsed_ = target - SteadyTimePoint{};
+}
+
+}  // namespace js8core
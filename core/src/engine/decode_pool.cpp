@@ -0,0 +1,136 @@
+#include "js8core/decode_pool.hpp"
+
+#include <algorithm>
+#include <time.h>
+#include <utility>
+
+#include "js8core/trace.hpp"
+
+namespace js8core {
+
+namespace {
+
+// Positive credit is capped at this much budget, so an idle pool cannot save
+// up for a burst longer than a second.
+constexpr double kMaxCreditSeconds = 1.0;
+
+// CPU time of the calling thread; falls back to the steady clock where there
+// is no per-thread CPU clock, which overstates cost but keeps the budget.
+std::chrono::nanoseconds thread_cpu_now() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+  }
+#endif
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch());
+}
+
+}  // namespace
+
+DecodePool::DecodePool(DecodePoolConfig config)
+    : config_(std::move(config)) {
+  int const count = std::max(config_.threads, 1);
+  stats_.threads = count;
+  credit_s_ = config_.cpu_budget * kMaxCreditSeconds;
+  refilled_at_ = std::chrono::steady_clock::now();
+  memory_.resize(count);
+  threads_.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    std::string name = config_.name;
+    if (count > 1) name += "-" + std::to_string(i + 1);
+    threads_.emplace_back([this, name = std::move(name), i]() { worker_loop(name, i); });
+  }
+}
+
+DecodePool::~DecodePool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    jobs_.clear();
+  }
+  cv_.notify_all();
+  for (auto& thread : threads_) {
+    if (thread.joinable()) thread.join();
+  }
+}
+
+void DecodePool::post(Job job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) return;
+    jobs_.push_back(std::move(job));
+  }
+  cv_.notify_one();
+}
+
+DecodePoolStats DecodePool::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DecodePoolStats stats = stats_;
+  stats.queued = jobs_.size();
+  for (auto const& thread : memory_) {
+    for (std::size_t m = 0; m < thread.size(); ++m) {
+      if (!thread[m].state_bytes) continue;
+      stats.memory[m].state_bytes = thread[m].state_bytes;
+      stats.memory[m].table_bytes = thread[m].table_bytes;
+      stats.memory[m].decoders += thread[m].decoders;
+      stats.memory[m].tables_built = stats.memory[m].tables_built || thread[m].tables_built;
+    }
+  }
+  return stats;
+}
+
+// Refills the bucket and, while it is in debt, waits until it is not.
+// Returns false if the pool is stopping.
+bool DecodePool::wait_for_budget(std::unique_lock<std::mutex>& lock) {
+  if (config_.cpu_budget <= 0.0) return true;
+  for (;;) {
+    auto const now = std::chrono::steady_clock::now();
+    credit_s_ = std::min(credit_s_ + std::chrono::duration<double>(now - refilled_at_).count() *
+                                         config_.cpu_budget,
+                         config_.cpu_budget * kMaxCreditSeconds);
+    refilled_at_ = now;
+    if (credit_s_ >= 0.0) return true;
+
+    auto const wait = std::chrono::duration<double>(-credit_s_ / config_.cpu_budget);
+    cv_.wait_for(lock, wait);
+    stats_.throttled += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - now);
+    if (stop_) return false;
+  }
+}
+
+void DecodePool::worker_loop(std::string const& name, std::size_t index) {
+  trace::set_thread_name(name.c_str());
+
+  std::unique_ptr<Decoder> decoder;
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&]() { return stop_ || !jobs_.empty(); });
+      if (stop_ || !wait_for_budget(lock)) return;
+      if (jobs_.empty()) continue;  // another thread took it while we waited
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+
+    bool const first = !decoder;
+    if (first) decoder = std::make_unique<Decoder>(config_.decoder_memory);
+
+    auto const cpu_start = thread_cpu_now();
+    job(*decoder);
+    auto const cpu = thread_cpu_now() - cpu_start;
+    DecoderMemory const memory = decoder->memory();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    memory_[index] = memory;
+    ++stats_.jobs;
+    if (first) ++stats_.decoders;
+    stats_.cpu += cpu;
+    credit_s_ -= std::chrono::duration<double>(cpu).count();
+  }
+}
+
+}  // namespace js8core
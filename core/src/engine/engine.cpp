@@ -22,14 +22,18 @@
 #endif
 
 #include "commons.h"
+#include "js8core/decode_pool.hpp"
 #include "js8core/decoder_state.hpp"
 #include "js8core/decoder_bridge.hpp"
 #include "js8core/decoder.hpp"
 #include "js8core/dsp/resampler.hpp"
+#include "js8core/dsp/sample_convert.hpp"
 #include "js8core/protocol/costas.hpp"
 #include "js8core/protocol/constants.hpp"
 #include "js8core/protocol/submode.hpp"
 #include "js8core/protocol/varicode.hpp"
+#include "js8core/recording.hpp"
+#include "js8core/trace.hpp"
 #include "js8core/types.hpp"
 #include "js8core/tx/modulator.hpp"
 
@@ -58,20 +62,23 @@ public:
   Js8EngineImpl(EngineConfig config, EngineCallbacks callbacks, EngineDependencies deps)
       : config_(std::move(config)),
         callbacks_(std::move(callbacks)),
-        deps_(deps) {
+        deps_(deps),
+        clock_(deps.clock ? deps.clock : &real_clock()),
+        tx_modulator_(*clock_) {
     decode_state_.samples.resize(kJs8NtMax * kJs8RxSampleRate);
 
     // Initialize decoder parameters with sensible defaults
     decode_state_.params.nfa = 200;   // Start frequency (Hz) - avoid low-freq noise
     decode_state_.params.nfb = 2500;  // End frequency (Hz) - typical JS8Call range
     decode_state_.params.nfqso = 1500; // Center frequency for QSO
+    decode_state_.params.syncGate = config_.sync_gate;
+    decode_state_.params.syncGateDb = config_.sync_gate_db;
 
     // Align the ring buffer position to wall clock so decode windows line up with
     // the desktop timing (cycles relative to UTC within the current minute).
     {
       auto const sample_rate = config_.sample_rate_hz ? config_.sample_rate_hz : kJs8RxSampleRate;
-      using clock = std::chrono::system_clock;
-      auto now = clock::now();
+      auto now = clock_->wall_now();
       auto ms_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
       // JS8 RX buffer spans 60 seconds; use milliseconds into the current minute.
       auto ms_in_minute = ms_since_epoch.count() % (kJs8NtMax * 1000);
@@ -101,6 +108,7 @@ public:
   }
 
   ~Js8EngineImpl() override {
+    stop_recording();
     stop_decode_worker();
     stop_spectrum_worker();
   }
@@ -110,9 +118,9 @@ public:
 
     if (deps_.audio_in) {
       AudioStreamParams params;
-      params.format.sample_rate = config_.sample_rate_hz ? config_.sample_rate_hz : kJs8RxSampleRate;
-      params.format.channels = 1;
-      params.format.sample_type = SampleType::Int16;
+      params.format.sample_rate = config_.capture_rate_hz;
+      params.format.channels = std::max(config_.input_channels, 1);
+      params.format.sample_type = config_.input_sample_type;
       params.frames_per_buffer = 0;
 
       auto ok = deps_.audio_in->start(
@@ -131,7 +139,9 @@ public:
 
     if (deps_.rig) {
       deps_.rig->start(
-          [](RigState const&) {},
+          [this](RigState const& state) {
+            if (state.online && state.rx_frequency) set_dial_frequency(state.rx_frequency);
+          },
           [this](std::string_view msg) {
             if (callbacks_.on_error) callbacks_.on_error(msg);
           });
@@ -148,55 +158,103 @@ public:
   }
 
   bool submit_capture(AudioInputBuffer const& buffer) override {
-    if (buffer.format.sample_type != SampleType::Int16) {
+    trace::Span span("submit_capture", "engine");
+    auto const sample_type = buffer.format.sample_type;
+    auto const bytes_per_sample = dsp::bytes_per_sample(sample_type);
+    if (bytes_per_sample == 0) {
       if (callbacks_.on_error) callbacks_.on_error("Unsupported sample type");
       return false;
     }
 
-    // Only accept matching sample rate for now.
-    if (config_.sample_rate_hz && buffer.format.sample_rate != config_.sample_rate_hz) {
+    int const decode_rate = config_.sample_rate_hz ? config_.sample_rate_hz : kJs8RxSampleRate;
+    int const input_rate = buffer.format.sample_rate;
+    if (input_rate <= 0) {
       if (callbacks_.on_error) callbacks_.on_error("Unexpected sample rate");
       return false;
     }
 
-    auto bytes_per_sample = static_cast<std::size_t>(sizeof(std::int16_t) * buffer.format.channels);
-    if (bytes_per_sample == 0) return false;
-    auto total_samples = buffer.data.size() / bytes_per_sample;
+    int const channels = buffer.format.channels;
+    if (channels <= 0) return false;
+    auto const frame_bytes = bytes_per_sample * static_cast<std::size_t>(channels);
+    std::size_t const frames = buffer.data.size() / frame_bytes;
+
+    int channel = config_.input_channel;
+    if (channel == kInputChannelLoudest) {
+      channel = dsp::loudest_channel(buffer.data.first(frames * frame_bytes), sample_type, channels);
+    }
+    channel = std::clamp(channel, 0, channels - 1);
+
+    auto const ring_size = decode_state_.samples.size();
+    auto const ring_start = static_cast<std::size_t>(decode_state_.params.kin);
+    std::size_t written = 0;
+
+    if (input_rate == decode_rate) {
+      // Convert the selected channel straight into the decode ring, splitting
+      // at the wrap point.
+      std::size_t pos = ring_start;
+      while (written < frames) {
+        std::size_t chunk = std::min(frames - written, ring_size - pos);
+        dsp::extract_channel(buffer.data.subspan(written * frame_bytes, chunk * frame_bytes),
+                             sample_type, channels, channel,
+                             std::span<std::int16_t>(decode_state_.samples.data() + pos, chunk));
+        written += chunk;
+        pos = (pos + chunk) % ring_size;
+      }
+    } else {
+      if (capture_resampler_.input_rate() != input_rate ||
+          capture_resampler_.output_rate() != decode_rate) {
+        capture_resampler_.configure(input_rate, decode_rate);
+        if (callbacks_.on_log) {
+          char log_msg[160];
+          snprintf(log_msg, sizeof(log_msg),
+                   "Capture resampler configured: %d Hz -> %d Hz, %d taps/phase",
+                   input_rate, decode_rate, capture_resampler_.taps_per_phase());
+          callbacks_.on_log(LogLevel::Info, log_msg);
+        }
+      }
 
-    // Append mono data; if stereo, take left channel for now.
-    auto* raw = reinterpret_cast<const std::int16_t*>(buffer.data.data());
-    std::size_t frames = total_samples / static_cast<std::size_t>(buffer.format.channels);
+      capture_mono_.resize(frames);
+      dsp::extract_channel(buffer.data.first(frames * frame_bytes), sample_type, channels, channel,
+                           capture_mono_);
+      capture_resampled_.resize(capture_resampler_.max_output(frames));
+      std::size_t produced = capture_resampler_.process(capture_mono_, capture_resampled_);
+
+      std::size_t pos = ring_start;
+      while (written < produced) {
+        std::size_t chunk = std::min(produced - written, ring_size - pos);
+        std::copy_n(capture_resampled_.data() + written, chunk, decode_state_.samples.data() + pos);
+        written += chunk;
+        pos = (pos + chunk) % ring_size;
+      }
+    }
 
     // Calculate RMS power to verify we're getting actual audio data
     static int audio_log_counter = 0;
-    if (++audio_log_counter % 100 == 0 && callbacks_.on_log) {
+    if (++audio_log_counter % 100 == 0 && callbacks_.on_log && written > 0) {
       double sum_squares = 0.0;
-      for (std::size_t i = 0; i < frames; ++i) {
-        int16_t sample = raw[i * buffer.format.channels];
+      for (std::size_t i = 0; i < written; ++i) {
+        int16_t sample = decode_state_.samples[(ring_start + i) % ring_size];
         sum_squares += static_cast<double>(sample) * static_cast<double>(sample);
       }
-      double rms = std::sqrt(sum_squares / static_cast<double>(frames));
+      double rms = std::sqrt(sum_squares / static_cast<double>(written));
       char log_msg[256];
       snprintf(log_msg, sizeof(log_msg),
-              "Audio submit: frames=%zu, rms=%.1f, total_samples=%d, kin=%d",
-              frames, rms, total_samples_, decode_state_.params.kin);
+              "Audio submit: frames=%zu@%dHz -> %zu, channels=%d, channel=%d, rms=%.1f, total_samples=%d, kin=%d",
+              frames, input_rate, written, channels, channel, rms, total_samples_, decode_state_.params.kin);
       callbacks_.on_log(LogLevel::Info, log_msg);
     }
 
-    for (std::size_t i = 0; i < frames; ++i) {
-      auto write_index = (static_cast<std::size_t>(decode_state_.params.kin) + i) % decode_state_.samples.size();
-      decode_state_.samples[write_index] = raw[i * buffer.format.channels];
-    }
-    decode_state_.params.kin = (decode_state_.params.kin + static_cast<int>(frames)) %
-                               static_cast<int>(decode_state_.samples.size());
-    total_samples_ += static_cast<int>(frames);
+    record_capture(ring_start, written, buffer.captured_at);
+
+    decode_state_.params.kin = static_cast<int>((ring_start + written) % ring_size);
+    total_samples_ += static_cast<int>(written);
 
     // Emit a lightweight spectrum frame for UI consumers at a throttled rate.
-    if (callbacks_.on_event && frames > 0) {
-      auto const now = std::chrono::steady_clock::now();
+    if (callbacks_.on_event && written > 0) {
+      auto const now = buffer.captured_at != SteadyTimePoint{} ? buffer.captured_at : clock_->steady_now();
       if (now - last_spectrum_time_ >= kSpectrumInterval) {
         last_spectrum_time_ = now;
-        enqueue_spectrum(raw, frames, buffer.format.channels, buffer.format.sample_rate);
+        enqueue_spectrum(ring_start, written, decode_rate);
       }
     }
 
@@ -353,6 +411,79 @@ public:
     config_.tx_output_gain_boost_enabled = enabled;
   }
 
+  EngineQueueStats queue_stats() const override {
+    EngineQueueStats stats;
+    {
+      std::lock_guard<std::mutex> lock(decode_mutex_);
+      stats.decode = decode_stats_;
+    }
+    {
+      std::lock_guard<std::mutex> lock(spectrum_mutex_);
+      stats.spectrum = spectrum_stats_;
+    }
+    return stats;
+  }
+
+  DecoderMemory decoder_memory() const override {
+    return decode_pool_ ? decode_pool_->stats().memory : DecoderMemory{};
+  }
+
+  void set_dial_frequency(FrequencyHz dial_hz) override {
+    dial_hz_.store(dial_hz, std::memory_order_relaxed);
+  }
+
+  FrequencyHz dial_frequency() const override {
+    return dial_hz_.load(std::memory_order_relaxed);
+  }
+
+  bool start_recording(std::string const& path, std::string* error) override {
+    std::lock_guard<std::mutex> lock(recorder_mutex_);
+    if (recorder_owner_) {
+      if (error) *error = "already recording";
+      return false;
+    }
+
+    recording::RecordingHeader header;
+    header.sample_rate = static_cast<std::uint32_t>(config_.sample_rate_hz ? config_.sample_rate_hz
+                                                                            : kJs8RxSampleRate);
+    header.submodes = config_.submodes;
+    header.capture_rate = config_.capture_rate_hz;
+    header.input_channels = config_.input_channels;
+    header.input_channel = config_.input_channel;
+    header.dial_hz = dial_hz_.load(std::memory_order_relaxed);
+
+    auto writer = std::make_unique<recording::Writer>();
+    if (!writer->open(path, header, error)) return false;
+    recorder_owner_ = std::move(writer);
+    recorder_.store(recorder_owner_.get());
+
+    if (callbacks_.on_log) {
+      char log_msg[320];
+      snprintf(log_msg, sizeof(log_msg), "Recording capture to %s", path.c_str());
+      callbacks_.on_log(LogLevel::Info, log_msg);
+    }
+    return true;
+  }
+
+  void stop_recording() override {
+    std::lock_guard<std::mutex> lock(recorder_mutex_);
+    if (!recorder_owner_) return;
+
+    // Detach from the capture thread, wait out any append in flight, drain.
+    recorder_.store(nullptr);
+    while (recorder_users_.load() != 0) std::this_thread::yield();
+    recorder_owner_->close();
+
+    if (callbacks_.on_log) {
+      char log_msg[192];
+      snprintf(log_msg, sizeof(log_msg), "Recording stopped: %llu samples written, %llu dropped",
+               static_cast<unsigned long long>(recorder_owner_->samples_written()),
+               static_cast<unsigned long long>(recorder_owner_->samples_dropped()));
+      callbacks_.on_log(LogLevel::Info, log_msg);
+    }
+    recorder_owner_.reset();
+  }
+
  private:
     struct SubmodeSchedule {
       protocol::SubmodeId id;
@@ -378,11 +509,37 @@ public:
       bool tuning = false;
     };
 
+    // Hand the samples just written to the ring to an active recording.
+    void record_capture(std::size_t ring_start, std::size_t written, SteadyTimePoint captured_at) {
+      recorder_users_.fetch_add(1);
+      if (auto* recorder = recorder_.load(); recorder && written > 0) {
+        auto const wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 clock_->wall_now().time_since_epoch()).count();
+        if (!recorder->begun()) {
+          recorder->begin(static_cast<std::int32_t>(ring_start), wall_ns);
+          recorded_dial_hz_ = ~FrequencyHz{0};
+        }
+        if (auto const dial = dial_hz_.load(std::memory_order_relaxed); dial != recorded_dial_hz_) {
+          recorder->append_dial(dial, wall_ns);
+          recorded_dial_hz_ = dial;
+        }
+
+        auto const& ring = decode_state_.samples;
+        std::size_t const first = std::min(written, ring.size() - ring_start);
+        auto const steady_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   (captured_at != SteadyTimePoint{} ? captured_at : clock_->steady_now())
+                                       .time_since_epoch()).count();
+        recorder->append_audio(std::span<const std::int16_t>(ring.data() + ring_start, first),
+                               std::span<const std::int16_t>(ring.data(), written - first),
+                               wall_ns, steady_ns);
+      }
+      recorder_users_.fetch_sub(1);
+    }
+
     void init_schedules() {
       // Get current UTC time to synchronize decode windows
-      using clock = std::chrono::system_clock;
-      auto now = clock::now();
-      auto t = clock::to_time_t(now);
+      auto now = clock_->wall_now();
+      auto t = SystemClock::to_time_t(now);
       std::tm utc_tm{};
 #if defined(_WIN32)
       gmtime_s(&utc_tm, &t);
@@ -433,35 +590,60 @@ public:
       }
     }
 
-    void set_submode_window(protocol::SubmodeId id, int start, int size) {
+    static void set_submode_window(DecodeParams& params, protocol::SubmodeId id, int start, int size) {
       switch (id) {
         case protocol::SubmodeId::A:
-          decode_state_.params.kposA = start;
-          decode_state_.params.kszA = size;
+          params.kposA = start;
+          params.kszA = size;
           break;
         case protocol::SubmodeId::B:
-          decode_state_.params.kposB = start;
-          decode_state_.params.kszB = size;
+          params.kposB = start;
+          params.kszB = size;
           break;
         case protocol::SubmodeId::C:
-          decode_state_.params.kposC = start;
-          decode_state_.params.kszC = size;
+          params.kposC = start;
+          params.kszC = size;
           break;
         case protocol::SubmodeId::E:
-          decode_state_.params.kposE = start;
-          decode_state_.params.kszE = size;
+          params.kposE = start;
+          params.kszE = size;
           break;
         case protocol::SubmodeId::I:
-          decode_state_.params.kposI = start;
-          decode_state_.params.kszI = size;
+          params.kposI = start;
+          params.kszI = size;
           break;
       }
     }
 
+    void set_submode_window(protocol::SubmodeId id, int start, int size) {
+      set_submode_window(decode_state_.params, id, start, size);
+    }
+
+    static int submode_window_size(DecodeParams const& params, protocol::SubmodeId id) {
+      switch (id) {
+        case protocol::SubmodeId::A: return params.kszA;
+        case protocol::SubmodeId::B: return params.kszB;
+        case protocol::SubmodeId::C: return params.kszC;
+        case protocol::SubmodeId::E: return params.kszE;
+        case protocol::SubmodeId::I: return params.kszI;
+      }
+      return 0;
+    }
+
+    static int submode_window_start(DecodeParams const& params, protocol::SubmodeId id) {
+      switch (id) {
+        case protocol::SubmodeId::A: return params.kposA;
+        case protocol::SubmodeId::B: return params.kposB;
+        case protocol::SubmodeId::C: return params.kposC;
+        case protocol::SubmodeId::E: return params.kposE;
+        case protocol::SubmodeId::I: return params.kposI;
+      }
+      return 0;
+    }
+
     void populate_decode_metadata() {
-      using clock = std::chrono::system_clock;
-      auto now = clock::now();
-      auto t = clock::to_time_t(now);
+      auto now = clock_->wall_now();
+      auto t = SystemClock::to_time_t(now);
       std::tm utc_tm{};
 #if defined(_WIN32)
       gmtime_s(&utc_tm, &t);
@@ -549,6 +731,7 @@ public:
 
     void schedule_decodes() {
       if (!callbacks_.on_event) return;
+      trace::Span span("schedule_decodes", "engine");
 
       int const k = decode_state_.params.kin;
       int const k0 = k0_;
@@ -566,8 +749,7 @@ public:
       static int drift_log_counter = 0;
       if (++drift_log_counter % 200 == 0 && callbacks_.on_log) {
         auto const sample_rate = config_.sample_rate_hz ? config_.sample_rate_hz : kJs8RxSampleRate;
-        using clock = std::chrono::system_clock;
-        auto now = clock::now();
+        auto now = clock_->wall_now();
         auto ms_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
         int ms_in_minute = static_cast<int>(ms_since_epoch.count() % (kJs8NtMax * 1000));
         int k_ms = static_cast<int>((static_cast<long long>(k) * 1000) / sample_rate);
@@ -642,9 +824,8 @@ public:
 
           if (callbacks_.on_log) {
             // Get UTC time for logging
-            using clock = std::chrono::system_clock;
-            auto now = clock::now();
-            auto t = clock::to_time_t(now);
+            auto now = clock_->wall_now();
+            auto t = SystemClock::to_time_t(now);
             std::tm utc_tm{};
 #if defined(_WIN32)
             gmtime_s(&utc_tm, &t);
@@ -700,6 +881,7 @@ public:
     }
 
     std::size_t render_tx_audio(AudioOutputBuffer& buffer) {
+      trace::Span span("render_tx_audio", "tx");
       std::size_t bytes_per_sample = buffer.format.sample_type == SampleType::Float32
                                          ? sizeof(float)
                                          : sizeof(std::int16_t);
@@ -847,6 +1029,7 @@ public:
                           int sample_rate,
                           events::Spectrum& spec) {
       if (!data || frames == 0 || sample_rate <= 0) return false;
+      trace::Span span("compute_spectrum", "spectrum", "frames", static_cast<std::int64_t>(frames));
 
       // Limit FFT size for cost; keep it power of two for simplicity.
       // Clamp to the largest power-of-two that fits in the provided frame count
@@ -942,6 +1125,7 @@ public:
     EngineConfig config_;
     EngineCallbacks callbacks_;
     EngineDependencies deps_;
+    Clock* clock_;
     DecodeState decode_state_;
     SpectrumState spectrum_state_{};
     std::vector<SubmodeSchedule> schedules_;
@@ -958,8 +1142,21 @@ public:
     bool tx_output_logged_ = false;
     std::atomic<bool> tx_active_{false};
     bool tx_output_started_{false};
+    dsp::RationalResampler capture_resampler_;
+    std::vector<std::int16_t> capture_mono_;
+    std::vector<std::int16_t> capture_resampled_;
+    std::atomic<FrequencyHz> dial_hz_{0};
+
+    // Capture recording. The control thread owns the writer; the capture
+    // thread reaches it through recorder_ and holds recorder_users_ while it
+    // appends, so stop_recording() can detach it without a lock on that path.
+    std::mutex recorder_mutex_;
+    std::unique_ptr<recording::Writer> recorder_owner_;
+    std::atomic<recording::Writer*> recorder_{nullptr};
+    std::atomic<int> recorder_users_{0};
+    FrequencyHz recorded_dial_hz_{0};  // capture thread only
     static constexpr auto kSpectrumInterval = std::chrono::milliseconds(100);
-    std::chrono::steady_clock::time_point last_spectrum_time_{};
+    SteadyTimePoint last_spectrum_time_{};
     std::size_t spectrum_n_{0};
     std::vector<double> spectrum_window_;
     std::vector<double> spectrum_samples_;
@@ -967,24 +1164,65 @@ public:
     events::Variant spectrum_event_{events::Spectrum{}};
     std::mutex event_mutex_;
 
-    std::thread decode_thread_;
-    std::mutex decode_mutex_;
+    // Both worker queues hold at most one item. A decode snapshot that is
+    // still pending when the next one arrives is merged into it (or dropped if
+    // superseded); a pending spectrum frame is simply replaced. Decodes run on
+    // a DecodePool, which may be shared with other engines; at most one
+    // runner per engine is posted to it at a time (decode_posted_).
+    std::unique_ptr<DecodePool> own_decode_pool_;
+    DecodePool* decode_pool_{nullptr};
+    bool decode_posted_{false};
+    mutable std::mutex decode_mutex_;
     std::condition_variable decode_cv_;
-    std::deque<DecodeState> decode_queue_;
+    struct DecodeJob {
+      DecodeState state;
+      int k = 0;  // total_samples_ when the snapshot was taken
+      std::chrono::steady_clock::time_point queued_at{};
+    };
+    std::optional<DecodeJob> decode_pending_;
+    QueueStats decode_stats_{0, 1};
     bool decode_stop_{false};
 
     std::thread spectrum_thread_;
-    std::mutex spectrum_mutex_;
+    mutable std::mutex spectrum_mutex_;
     std::condition_variable spectrum_cv_;
     struct SpectrumTask {
       std::vector<std::int16_t> samples;
       std::size_t frames = 0;
       int channels = 1;
       int sample_rate = 0;
+      std::chrono::steady_clock::time_point queued_at{};
     };
-    std::deque<SpectrumTask> spectrum_queue_;
+    // Three buffers rotate by swap (capture fill -> pending -> worker) so
+    // steady-state spectrum updates do not allocate.
+    SpectrumTask spectrum_fill_;
+    SpectrumTask spectrum_pending_;
+    SpectrumTask spectrum_work_;
+    bool spectrum_has_pending_{false};
+    QueueStats spectrum_stats_{0, 1};
     bool spectrum_stop_{false};
 
+    static void note_dequeued(QueueStats& stats,
+                              std::chrono::steady_clock::time_point queued_at) {
+      auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - queued_at);
+      stats.depth = 0;
+      ++stats.processed;
+      stats.last_wait = wait;
+      stats.max_wait = std::max(stats.max_wait, wait);
+      stats.total_wait += wait;
+    }
+
+    static void note_completed(QueueStats& stats,
+                               std::chrono::steady_clock::time_point queued_at) {
+      auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - queued_at);
+      ++stats.completed;
+      stats.last_latency = latency;
+      stats.max_latency = std::max(stats.max_latency, latency);
+      stats.total_latency += latency;
+    }
+
     void emit_event(events::Variant const& ev) {
       if (!callbacks_.on_event) return;
       std::lock_guard<std::mutex> lock(event_mutex_);
@@ -992,17 +1230,27 @@ public:
     }
 
     void start_decode_worker() {
-      decode_thread_ = std::thread([this]() { decode_worker_loop(); });
+      decode_pool_ = deps_.decode_pool;
+      if (!decode_pool_) {
+        DecodePoolConfig pool;
+        pool.decoder_memory = config_.decoder_memory;
+        own_decode_pool_ = std::make_unique<DecodePool>(pool);
+        decode_pool_ = own_decode_pool_.get();
+      }
     }
 
+    // Waits out a decode in progress; a runner still queued on a shared pool
+    // sees decode_stop_ and returns without touching the engine further.
     void stop_decode_worker() {
       {
-        std::lock_guard<std::mutex> lock(decode_mutex_);
+        std::unique_lock<std::mutex> lock(decode_mutex_);
         decode_stop_ = true;
-        decode_queue_.clear();
+        decode_pending_.reset();
+        decode_stats_.depth = 0;
+        decode_cv_.wait(lock, [&]() { return !decode_posted_; });
       }
-      decode_cv_.notify_one();
-      if (decode_thread_.joinable()) decode_thread_.join();
+      decode_pool_ = nullptr;
+      own_decode_pool_.reset();
     }
 
     void start_spectrum_worker() {
@@ -1013,85 +1261,163 @@ public:
       {
         std::lock_guard<std::mutex> lock(spectrum_mutex_);
         spectrum_stop_ = true;
-        spectrum_queue_.clear();
+        spectrum_has_pending_ = false;
+        spectrum_stats_.depth = 0;
       }
       spectrum_cv_.notify_one();
       if (spectrum_thread_.joinable()) spectrum_thread_.join();
     }
 
+    // Carry the windows of a decode job the worker never started over into
+    // the newer job. A window is kept when the newer job does not decode that
+    // submode itself and the ring has not overwritten it since; returns the
+    // number of submodes carried over.
+    static int merge_decode_job(DecodeJob const& older, DecodeJob& newer) {
+      int const ring_size = kJs8NtMax * kJs8RxSampleRate;
+      int const elapsed = newer.k - older.k;
+      int merged = 0;
+      for (auto const& sm : protocol::submodes()) {
+        int const bit = 1 << static_cast<int>(sm.id);
+        if ((older.state.params.nsubmodes & bit) == 0) continue;
+        if ((newer.state.params.nsubmodes & bit) != 0) continue;
+        int const size = submode_window_size(older.state.params, sm.id);
+        if (elapsed + size > ring_size) continue;
+        set_submode_window(newer.state.params, sm.id,
+                           submode_window_start(older.state.params, sm.id), size);
+        newer.state.params.nsubmodes |= bit;
+        ++merged;
+      }
+      return merged;
+    }
+
     void enqueue_decode(DecodeState snapshot) {
+      DecodeJob job{std::move(snapshot), total_samples_, std::chrono::steady_clock::now()};
+      int merged = -1;
+      bool post = false;
       {
         std::lock_guard<std::mutex> lock(decode_mutex_);
-        decode_queue_.push_back(std::move(snapshot));
+        ++decode_stats_.enqueued;
+        if (decode_pending_) {
+          merged = merge_decode_job(*decode_pending_, job);
+          if (merged > 0) {
+            ++decode_stats_.merged;
+            job.queued_at = decode_pending_->queued_at;
+          } else {
+            ++decode_stats_.dropped;
+          }
+        }
+        decode_pending_ = std::move(job);
+        decode_stats_.depth = 1;
+        post = !decode_posted_ && !decode_stop_;
+        if (post) decode_posted_ = true;
+      }
+      if (post) post_decode_runner();
+
+      if (merged >= 0 && callbacks_.on_log) {
+        char log_msg[192];
+        snprintf(log_msg, sizeof(log_msg),
+                 "Decode worker busy: %s pending snapshot (%d submodes carried over)",
+                 merged > 0 ? "merged" : "dropped", merged);
+        callbacks_.on_log(LogLevel::Warn, log_msg);
       }
-      decode_cv_.notify_one();
     }
 
-    void enqueue_spectrum(const std::int16_t* data,
+    // Snapshot up to 4096 freshly written frames from the decode ring.
+    void enqueue_spectrum(std::size_t ring_start,
                           std::size_t frames,
-                          int channels,
                           int sample_rate) {
-      if (!data || frames == 0 || sample_rate <= 0) return;
+      if (frames == 0 || sample_rate <= 0) return;
+      auto const& ring = decode_state_.samples;
       std::size_t const max_frames = std::min<std::size_t>(frames, 4096);
-      SpectrumTask task;
+      SpectrumTask& task = spectrum_fill_;
       task.frames = max_frames;
       task.channels = 1;
       task.sample_rate = sample_rate;
       task.samples.resize(max_frames);
       for (std::size_t i = 0; i < max_frames; ++i) {
-        task.samples[i] = data[i * channels];
+        task.samples[i] = ring[(ring_start + i) % ring.size()];
       }
+      task.queued_at = std::chrono::steady_clock::now();
       {
         std::lock_guard<std::mutex> lock(spectrum_mutex_);
-        spectrum_queue_.push_back(std::move(task));
+        ++spectrum_stats_.enqueued;
+        if (spectrum_has_pending_) ++spectrum_stats_.dropped;  // latest wins
+        std::swap(spectrum_pending_, spectrum_fill_);
+        spectrum_has_pending_ = true;
+        spectrum_stats_.depth = 1;
       }
       spectrum_cv_.notify_one();
     }
 
-    void decode_worker_loop() {
-      for (;;) {
-        DecodeState task;
-        {
-          std::unique_lock<std::mutex> lock(decode_mutex_);
-          decode_cv_.wait(lock, [&]() { return decode_stop_ || !decode_queue_.empty(); });
-          if (decode_stop_) return;
-          task = std::move(decode_queue_.front());
-          decode_queue_.pop_front();
-        }
+    void post_decode_runner() {
+      decode_pool_->post([this](Decoder& decoder) { run_decode(decoder); });
+    }
 
-        if (callbacks_.on_log) {
-          char log_msg[512];
-          snprintf(log_msg, sizeof(log_msg),
-                   "Calling legacy_decode: nsubmodes=0x%x, freq_range=%d-%d Hz, nfqso=%d Hz, sample_rate=%d, buffer_size=%zu, callback=%s",
-                   task.params.nsubmodes, task.params.nfa, task.params.nfb, task.params.nfqso,
-                   config_.sample_rate_hz, task.samples.size(),
-                   callbacks_.on_event ? "SET" : "NULL");
-          callbacks_.on_log(LogLevel::Info, log_msg);
+    // Runs the pending decode job on a pool thread. If another job arrived
+    // meanwhile the runner re-posts itself behind other engines' work rather
+    // than keeping the thread, so a shared pool serves receivers in turn.
+    void run_decode(Decoder& decoder) {
+      DecodeState task;
+      std::chrono::steady_clock::time_point queued_at;
+      {
+        std::lock_guard<std::mutex> lock(decode_mutex_);
+        if (decode_stop_ || !decode_pending_) {
+          decode_posted_ = false;
+          decode_cv_.notify_all();
+          return;
         }
+        note_dequeued(decode_stats_, decode_pending_->queued_at);
+        queued_at = decode_pending_->queued_at;
+        task = std::move(decode_pending_->state);
+        decode_pending_.reset();
+      }
 
-        std::size_t decode_count = legacy_decode(task, [this](events::Variant const& ev) {
-          emit_event(ev);
-        });
+      if (callbacks_.on_log) {
+        char log_msg[512];
+        snprintf(log_msg, sizeof(log_msg),
+                 "Calling legacy_decode: nsubmodes=0x%x, freq_range=%d-%d Hz, nfqso=%d Hz, sample_rate=%d, buffer_size=%zu, callback=%s",
+                 task.params.nsubmodes, task.params.nfa, task.params.nfb, task.params.nfqso,
+                 config_.sample_rate_hz, task.samples.size(),
+                 callbacks_.on_event ? "SET" : "NULL");
+        callbacks_.on_log(LogLevel::Info, log_msg);
+      }
 
-        if (callbacks_.on_log) {
-          char log_msg[256];
-          snprintf(log_msg, sizeof(log_msg),
-                   "legacy_decode returned: %zu decodes", decode_count);
-          callbacks_.on_log(LogLevel::Info, log_msg);
+      std::size_t decode_count = decoder.decode(task, [this](events::Variant const& ev) {
+        emit_event(ev);
+      });
+
+      if (callbacks_.on_log) {
+        char log_msg[256];
+        snprintf(log_msg, sizeof(log_msg),
+                 "legacy_decode returned: %zu decodes", decode_count);
+        callbacks_.on_log(LogLevel::Info, log_msg);
+      }
+
+      bool repost = false;
+      {
+        std::lock_guard<std::mutex> lock(decode_mutex_);
+        note_completed(decode_stats_, queued_at);
+        repost = decode_pending_.has_value() && !decode_stop_;
+        if (!repost) {
+          decode_posted_ = false;
+          decode_cv_.notify_all();
         }
       }
+      if (repost) post_decode_runner();
     }
 
     void spectrum_worker_loop() {
+      trace::set_thread_name("js8-spectrum");
       for (;;) {
-        SpectrumTask task;
         {
           std::unique_lock<std::mutex> lock(spectrum_mutex_);
-          spectrum_cv_.wait(lock, [&]() { return spectrum_stop_ || !spectrum_queue_.empty(); });
+          spectrum_cv_.wait(lock, [&]() { return spectrum_stop_ || spectrum_has_pending_; });
           if (spectrum_stop_) return;
-          task = std::move(spectrum_queue_.front());
-          spectrum_queue_.pop_front();
+          std::swap(spectrum_work_, spectrum_pending_);
+          spectrum_has_pending_ = false;
+          note_dequeued(spectrum_stats_, spectrum_work_.queued_at);
         }
+        SpectrumTask const& task = spectrum_work_;
 
         auto& spec = std::get<events::Spectrum>(spectrum_event_);
         if (compute_spectrum(task.samples.data(),
@@ -1101,6 +1427,8 @@ public:
                              spec)) {
           emit_event(spectrum_event_);
         }
+        std::lock_guard<std::mutex> lock(spectrum_mutex_);
+        note_completed(spectrum_stats_, task.queued_at);
       }
     }
   };
@@ -0,0 +1,84 @@
+#include "js8core/receiver_host.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace js8core {
+
+namespace {
+
+DecodePoolConfig pool_config(ReceiverHostConfig const& config) {
+  DecodePoolConfig pool;
+  pool.threads = config.decode_threads;
+  if (pool.threads <= 0) {
+    pool.threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+  }
+  pool.cpu_budget = config.cpu_budget;
+  pool.decoder_memory = config.decoder_memory;
+  return pool;
+}
+
+}  // namespace
+
+ReceiverHost::ReceiverHost(ReceiverHostConfig const& config)
+    : pool_(pool_config(config)) {}
+
+ReceiverHost::~ReceiverHost() {
+  std::map<int, Receiver> receivers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    receivers.swap(receivers_);
+  }
+  receivers.clear();  // engines wait out their decodes before pool_ goes
+}
+
+int ReceiverHost::add_receiver(std::string name,
+                               EngineConfig const& config,
+                               EngineCallbacks callbacks,
+                               EngineDependencies deps) {
+  deps.decode_pool = &pool_;
+  auto engine = make_engine(config, std::move(callbacks), deps);
+  std::lock_guard<std::mutex> lock(mutex_);
+  int const id = next_id_++;
+  receivers_.emplace(id, Receiver{std::move(name), std::move(engine)});
+  return id;
+}
+
+bool ReceiverHost::remove_receiver(int id) {
+  Receiver removed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = receivers_.find(id);
+    if (it == receivers_.end()) return false;
+    removed = std::move(it->second);
+    receivers_.erase(it);
+  }
+  // Destroyed outside the lock: the engine may still be delivering decode
+  // events, and their handlers may call back into the host.
+  removed.engine.reset();
+  return true;
+}
+
+Js8Engine* ReceiverHost::receiver(int id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = receivers_.find(id);
+  return it == receivers_.end() ? nullptr : it->second.engine.get();
+}
+
+std::vector<ReceiverStats> ReceiverHost::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<ReceiverStats> out;
+  out.reserve(receivers_.size());
+  for (auto const& [id, receiver] : receivers_) {
+    ReceiverStats stats;
+    stats.id = id;
+    stats.name = receiver.name;
+    stats.dial_hz = receiver.engine->dial_frequency();
+    stats.decode = receiver.engine->queue_stats().decode;
+    out.push_back(std::move(stats));
+  }
+  return out;
+}
+
+}  // namespace js8core
@@ -0,0 +1,125 @@
+#include "js8core/wideband_receiver.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "js8core/protocol/constants.hpp"
+
+namespace js8core {
+
+WidebandReceiver::WidebandReceiver(ReceiverHost& host) : host_(host) {}
+
+WidebandReceiver::~WidebandReceiver() {
+  stop();
+  clear();
+}
+
+void WidebandReceiver::clear() {
+  for (int id : ids_) host_.remove_receiver(id);
+  ids_.clear();
+  engines_.clear();
+}
+
+bool WidebandReceiver::configure(WidebandConfig const& config,
+                                 CallbackFactory const& callbacks,
+                                 EngineDependencies deps,
+                                 std::string* error) {
+  int const rate = config.receiver.sample_rate_hz > 0 ? config.receiver.sample_rate_hz
+                                                       : protocol::kJs8RxSampleRate;
+  if (!channelizer_.configure(config.sample_rate_hz, config.center_hz, config.dials, rate, error)) {
+    return false;
+  }
+
+  clear();
+  config_ = config;
+  audio_rate_ = rate;
+
+  // Each receiver is fed its channel's audio directly at the decoder rate.
+  EngineConfig receiver = config.receiver;
+  receiver.sample_rate_hz = rate;
+  receiver.capture_rate_hz = rate;
+  receiver.input_sample_type = SampleType::Float32;
+  receiver.input_channels = 1;
+  receiver.input_channel = 0;
+  deps.audio_in = nullptr;
+
+  for (FrequencyHz const dial : config.dials) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%.3f", static_cast<double>(dial) / 1e6);
+    int const id = host_.add_receiver(name, receiver, callbacks ? callbacks(dial) : EngineCallbacks{}, deps);
+    Js8Engine* engine = host_.receiver(id);
+    engine->set_dial_frequency(dial);
+    ids_.push_back(id);
+    engines_.push_back(engine);
+  }
+  return true;
+}
+
+Js8Engine* WidebandReceiver::receiver(std::size_t channel) const {
+  return channel < engines_.size() ? engines_[channel] : nullptr;
+}
+
+bool WidebandReceiver::submit_iq(AudioInputBuffer const& buffer) {
+  if (engines_.empty()) return false;
+  if (buffer.format.channels != 2 || buffer.format.sample_type != config_.sample_type ||
+      (buffer.format.sample_rate != 0 && buffer.format.sample_rate != config_.sample_rate_hz)) {
+    return false;
+  }
+
+  std::size_t const sample_bytes = config_.sample_type == SampleType::Int16 ? sizeof(std::int16_t) : sizeof(float);
+  std::size_t const frames = buffer.data.size() / (2 * sample_bytes);
+  iq_.resize(frames);
+  if (config_.sample_type == SampleType::Int16) {
+    for (std::size_t i = 0; i < frames; ++i) {
+      std::int16_t s[2];
+      std::memcpy(s, buffer.data.data() + i * 2 * sample_bytes, sizeof(s));
+      iq_[i] = {s[0] / 32768.0f, s[1] / 32768.0f};
+    }
+  } else {
+    std::memcpy(iq_.data(), buffer.data.data(), frames * 2 * sample_bytes);
+  }
+
+  captured_at_ = buffer.captured_at;
+  channelizer_.process(iq_, [this](std::size_t channel, std::span<const float> audio) {
+    if (audio.empty()) return;
+    audio_.resize(audio.size());
+    std::transform(audio.begin(), audio.end(), audio_.begin(),
+                   [gain = config_.gain](float s) { return std::clamp(s * gain, -1.0f, 1.0f); });
+    AudioInputBuffer out;
+    out.format.sample_rate = audio_rate_;
+    out.format.channels = 1;
+    out.format.sample_type = SampleType::Float32;
+    out.data = std::as_bytes(std::span<const float>(audio_));
+    out.captured_at = captured_at_;
+    engines_[channel]->submit_capture(out);
+  });
+  return true;
+}
+
+bool WidebandReceiver::start(AudioInput& input, AudioErrorHandler on_error) {
+  stop();
+  if (engines_.empty()) return false;
+  AudioStreamParams params;
+  params.format.sample_rate = config_.sample_rate_hz;
+  params.format.channels = 2;
+  params.format.sample_type = config_.sample_type;
+  channelizer_.reset();
+  if (!input.start(params, [this](AudioInputBuffer const& buffer) { submit_iq(buffer); },
+                   std::move(on_error))) {
+    return false;
+  }
+  input_ = &input;
+  return true;
+}
+
+void WidebandReceiver::stop() {
+  if (input_) {
+    input_->stop();
+    input_ = nullptr;
+  }
+}
+
+}  // namespace js8core
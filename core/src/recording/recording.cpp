@@ -0,0 +1,347 @@
+#include "js8core/recording.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#include "js8core/decoder_state.hpp"
+
+namespace js8core::recording {
+
+namespace {
+
+constexpr auto kDrainInterval = std::chrono::milliseconds(20);
+
+std::int64_t ns_since_epoch(WallTimePoint t) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+}  // namespace
+
+Writer::Writer(std::size_t buffer_samples)
+    : ring_(buffer_samples * sizeof(std::int16_t) + 64 * sizeof(RecordHeader)) {}
+
+Writer::~Writer() {
+  close();
+}
+
+bool Writer::open(std::string const& path, RecordingHeader const& header, std::string* error) {
+  close();
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    if (error) *error = "cannot create " + path;
+    return false;
+  }
+  header_ = header;
+  std::memcpy(header_.magic, kMagic, sizeof(kMagic));
+  header_.version = kVersion;
+  header_written_ = false;
+  begun_ = false;
+  pending_gap_ = 0;
+  head_.store(0, std::memory_order_relaxed);
+  tail_.store(0, std::memory_order_relaxed);
+  samples_.store(0, std::memory_order_relaxed);
+  dropped_.store(0, std::memory_order_relaxed);
+  stop_.store(false, std::memory_order_relaxed);
+  block_samples_.reserve(header_.sample_rate ? header_.sample_rate : 12000);
+  thread_ = std::thread([this]() { drain_loop(); });
+  return true;
+}
+
+void Writer::close() {
+  if (!thread_.joinable()) return;
+  // The producer has stopped by now; account for audio dropped at the end.
+  if (pending_gap_ > 0) {
+    RecordHeader gap{RecordType::Gap, pending_gap_, gap_wall_ns_, 0};
+    while (!push(gap, {}, {}, nullptr)) std::this_thread::sleep_for(kDrainInterval);
+    pending_gap_ = 0;
+  }
+  stop_.store(true, std::memory_order_release);
+  thread_.join();
+  std::fclose(file_);
+  file_ = nullptr;
+}
+
+void Writer::begin(std::int32_t ring_position, std::int64_t wall_ns) {
+  header_.ring_position = ring_position;
+  header_.start_wall_ns = wall_ns;
+  begun_ = true;  // published to the writer thread by the first push
+}
+
+void Writer::append_audio(std::span<const std::int16_t> first,
+                          std::span<const std::int16_t> second,
+                          std::int64_t wall_ns,
+                          std::int64_t steady_ns) {
+  auto const count = static_cast<std::uint32_t>(first.size() + second.size());
+  if (count == 0) return;
+
+  if (pending_gap_ > 0) {
+    RecordHeader gap{RecordType::Gap, pending_gap_, gap_wall_ns_, 0};
+    if (!push(gap, {}, {}, nullptr)) {
+      pending_gap_ += count;
+      dropped_.fetch_add(count, std::memory_order_relaxed);
+      return;
+    }
+    pending_gap_ = 0;
+  }
+
+  RecordHeader record{RecordType::Audio, count, wall_ns, steady_ns};
+  if (!push(record, first, second, nullptr)) {
+    if (pending_gap_ == 0) gap_wall_ns_ = wall_ns;
+    pending_gap_ += count;
+    dropped_.fetch_add(count, std::memory_order_relaxed);
+  }
+}
+
+void Writer::append_dial(std::uint64_t dial_hz, std::int64_t wall_ns) {
+  RecordHeader record{RecordType::Dial, 0, wall_ns, 0};
+  push(record, {}, {}, &dial_hz);
+}
+
+bool Writer::push(RecordHeader const& record,
+                  std::span<const std::int16_t> first,
+                  std::span<const std::int16_t> second,
+                  std::uint64_t const* dial_hz) {
+  std::size_t const bytes = sizeof(RecordHeader) + (first.size() + second.size()) * sizeof(std::int16_t) +
+                            (dial_hz ? sizeof(*dial_hz) : 0);
+  std::size_t const head = head_.load(std::memory_order_relaxed);
+  std::size_t const tail = tail_.load(std::memory_order_acquire);
+  if (ring_.size() - (head - tail) < bytes) return false;
+
+  std::size_t pos = head;
+  copy_in(pos, &record, sizeof(record));
+  pos += sizeof(record);
+  copy_in(pos, first.data(), first.size_bytes());
+  pos += first.size_bytes();
+  copy_in(pos, second.data(), second.size_bytes());
+  pos += second.size_bytes();
+  if (dial_hz) copy_in(pos, dial_hz, sizeof(*dial_hz));
+
+  head_.store(head + bytes, std::memory_order_release);
+  return true;
+}
+
+void Writer::copy_in(std::size_t pos, void const* data, std::size_t bytes) {
+  if (bytes == 0) return;
+  std::size_t const at = pos % ring_.size();
+  std::size_t const first = std::min(bytes, ring_.size() - at);
+  std::memcpy(ring_.data() + at, data, first);
+  std::memcpy(ring_.data(), static_cast<std::byte const*>(data) + first, bytes - first);
+}
+
+void Writer::copy_out(std::size_t pos, void* data, std::size_t bytes) const {
+  if (bytes == 0) return;
+  std::size_t const at = pos % ring_.size();
+  std::size_t const first = std::min(bytes, ring_.size() - at);
+  std::memcpy(data, ring_.data() + at, first);
+  std::memcpy(static_cast<std::byte*>(data) + first, ring_.data(), bytes - first);
+}
+
+void Writer::drain_loop() {
+  for (;;) {
+    bool const stopping = stop_.load(std::memory_order_acquire);
+    while (drain_once()) {
+    }
+    if (stopping) break;
+    // Polling keeps the producer free of any wakeup syscall.
+    std::this_thread::sleep_for(kDrainInterval);
+  }
+  flush_block();
+  write_header();  // for a recording that never received audio
+  std::fflush(file_);
+}
+
+bool Writer::drain_once() {
+  std::size_t const tail = tail_.load(std::memory_order_relaxed);
+  std::size_t const head = head_.load(std::memory_order_acquire);
+  if (head == tail) return false;
+
+  write_header();
+
+  RecordHeader record;
+  copy_out(tail, &record, sizeof(record));
+  std::size_t pos = tail + sizeof(record);
+
+  if (record.type == RecordType::Audio) {
+    // Coalesce audio that continues the current block in time.
+    std::uint32_t const rate = header_.sample_rate ? header_.sample_rate : 12000;
+    std::int64_t const expected =
+        block_.wall_ns + static_cast<std::int64_t>(block_samples_.size()) * 1000000000LL / rate;
+    bool const continues = !block_samples_.empty() &&
+                           std::llabs(record.wall_ns - expected) <= 50000000LL &&
+                           block_samples_.size() + record.count <= rate;
+    if (!continues) {
+      flush_block();
+      block_ = record;
+    }
+    std::size_t const offset = block_samples_.size();
+    block_samples_.resize(offset + record.count);
+    copy_out(pos, block_samples_.data() + offset, record.count * sizeof(std::int16_t));
+    pos += record.count * sizeof(std::int16_t);
+    samples_.fetch_add(record.count, std::memory_order_relaxed);
+  } else {
+    flush_block();
+    std::fwrite(&record, sizeof(record), 1, file_);
+    if (record.type == RecordType::Dial) {
+      std::uint64_t dial_hz = 0;
+      copy_out(pos, &dial_hz, sizeof(dial_hz));
+      pos += sizeof(dial_hz);
+      std::fwrite(&dial_hz, sizeof(dial_hz), 1, file_);
+    }
+  }
+
+  tail_.store(pos, std::memory_order_release);
+  return true;
+}
+
+void Writer::write_header() {
+  if (header_written_) return;
+  std::fwrite(&header_, sizeof(header_), 1, file_);
+  header_written_ = true;
+}
+
+void Writer::flush_block() {
+  if (block_samples_.empty()) return;
+  block_.count = static_cast<std::uint32_t>(block_samples_.size());
+  std::fwrite(&block_, sizeof(block_), 1, file_);
+  std::fwrite(block_samples_.data(), sizeof(std::int16_t), block_samples_.size(), file_);
+  block_samples_.clear();
+}
+
+bool Reader::open(std::string const& path, std::string* error) {
+  file_.reset(std::fopen(path.c_str(), "rb"));
+  if (!file_) {
+    if (error) *error = "cannot open " + path;
+    return false;
+  }
+  if (std::fread(&header_, sizeof(header_), 1, file_.get()) != 1 ||
+      std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0) {
+    if (error) *error = path + " is not a JS8 capture recording";
+    file_.reset();
+    return false;
+  }
+  if (header_.version != kVersion || header_.sample_rate == 0) {
+    if (error) *error = path + ": unsupported recording version";
+    file_.reset();
+    return false;
+  }
+  return true;
+}
+
+bool Reader::next(Record& out) {
+  if (!file_ || std::fread(&out.header, sizeof(out.header), 1, file_.get()) != 1) return false;
+  switch (out.header.type) {
+    case RecordType::Audio:
+      out.samples.resize(out.header.count);
+      return std::fread(out.samples.data(), sizeof(std::int16_t), out.samples.size(), file_.get()) ==
+             out.samples.size();
+    case RecordType::Dial:
+      out.samples.clear();
+      return std::fread(&out.dial_hz, sizeof(out.dial_hz), 1, file_.get()) == 1;
+    case RecordType::Gap:
+      out.samples.clear();
+      return true;
+  }
+  return false;
+}
+
+bool Replay::open(std::string const& path, std::string* error) {
+  if (!reader_.open(path, error)) return false;
+  auto const& h = reader_.header();
+
+  // Start the clock at the point in the minute that puts a fresh engine's
+  // ring where the recorded one was, on the minute nearest the recording.
+  std::int64_t const minute_ns = std::int64_t{kJs8NtMax} * 1000000000LL;
+  std::int64_t const ring_ms = std::int64_t{h.ring_position} * 1000 / h.sample_rate;
+  std::int64_t start = h.start_wall_ns - h.start_wall_ns % minute_ns + ring_ms * 1000000LL;
+  if (start - h.start_wall_ns > minute_ns / 2) start -= minute_ns;
+  if (h.start_wall_ns - start > minute_ns / 2) start += minute_ns;
+  lead_samples_ = h.ring_position - static_cast<std::int32_t>(ring_ms * h.sample_rate / 1000);
+
+  clock_ = std::make_unique<SimulatedClock>(WallTimePoint{} +
+                                            std::chrono::duration_cast<SystemClock::duration>(
+                                                std::chrono::nanoseconds(start)));
+  return true;
+}
+
+EngineConfig Replay::config() const {
+  auto const& h = reader_.header();
+  EngineConfig config;
+  config.sample_rate_hz = static_cast<int>(h.sample_rate);
+  config.capture_rate_hz = static_cast<int>(h.sample_rate);
+  config.submodes = h.submodes;
+  config.input_channels = 1;
+  config.input_channel = 0;
+  return config;
+}
+
+ReplayStats Replay::run(Js8Engine& engine, bool wait_for_decodes) {
+  ReplayStats stats;
+  auto const rate = static_cast<int>(reader_.header().sample_rate);
+  std::size_t const chunk = static_cast<std::size_t>(rate / 50);  // 20 ms, like a capture callback
+
+  auto wait_idle = [&]() {
+    for (;;) {
+      auto const q = engine.queue_stats().decode;
+      if (q.depth == 0 && q.completed == q.processed) return;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+
+  auto feed = [&](std::int16_t const* samples, std::size_t count) {
+    for (std::size_t pos = 0; pos < count; pos += chunk) {
+      std::size_t const n = std::min(chunk, count - pos);
+      AudioInputBuffer buffer;
+      buffer.format.sample_rate = rate;
+      buffer.format.channels = 1;
+      buffer.format.sample_type = SampleType::Int16;
+      buffer.data = std::as_bytes(std::span<const std::int16_t>(samples + pos, n));
+      buffer.captured_at = clock_->steady_now();
+
+      std::uint64_t const enqueued = engine.queue_stats().decode.enqueued;
+      engine.submit_capture(buffer);
+      clock_->advance(std::chrono::nanoseconds(static_cast<std::int64_t>(n) * 1000000000LL / rate));
+      if (wait_for_decodes && engine.queue_stats().decode.enqueued != enqueued) {
+        wait_idle();
+        ++stats.decodes_waited;
+      }
+    }
+  };
+
+  // Follow the recorded wall clock forward, never back.
+  auto catch_up = [&](std::int64_t wall_ns) {
+    std::int64_t const now = ns_since_epoch(clock_->wall_now());
+    if (wall_ns > now) clock_->advance(std::chrono::nanoseconds(wall_ns - now));
+  };
+
+  engine.set_dial_frequency(reader_.header().dial_hz);
+  std::vector<std::int16_t> silence(static_cast<std::size_t>(std::max(lead_samples_, 0)), 0);
+  feed(silence.data(), silence.size());
+
+  Record record;
+  while (reader_.next(record)) {
+    switch (record.header.type) {
+      case RecordType::Audio:
+        catch_up(record.header.wall_ns);
+        feed(record.samples.data(), record.samples.size());
+        stats.samples += record.samples.size();
+        break;
+      case RecordType::Gap:
+        catch_up(record.header.wall_ns);
+        silence.assign(record.header.count, 0);
+        feed(silence.data(), silence.size());
+        stats.gap_samples += record.header.count;
+        break;
+      case RecordType::Dial:
+        engine.set_dial_frequency(record.dial_hz);
+        ++stats.dial_changes;
+        break;
+    }
+  }
+
+  if (wait_for_decodes) wait_idle();
+  return stats;
+}
+
+}  // namespace js8core::recording
@@ -0,0 +1,230 @@
+#include "js8core/trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace js8core::trace {
+
+namespace detail {
+std::atomic<bool> g_enabled{false};
+}  // namespace detail
+
+namespace {
+
+constexpr std::size_t kSpansPerThread = 8192;
+
+// One recorded span. Every field is an atomic and guarded by a per-slot
+// sequence number (odd while the owning thread is writing), so the dumper can
+// read rings that are still being written without tearing.
+struct Slot {
+  std::atomic<std::uint32_t> seq{0};
+  std::atomic<char const*> name{nullptr};
+  std::atomic<char const*> category{nullptr};
+  std::atomic<char const*> arg_name{nullptr};
+  std::atomic<std::int64_t> arg{0};
+  std::atomic<std::int64_t> start_ns{0};
+  std::atomic<std::int64_t> end_ns{0};
+};
+
+struct ThreadRing {
+  int tid = 0;
+  std::atomic<char const*> name{nullptr};
+  std::atomic<std::uint64_t> head{0};   // spans ever written
+  std::atomic<std::uint64_t> floor{0};  // spans before this were cleared
+  std::array<Slot, kSpansPerThread> slots;
+};
+
+// A ring whose thread has exited goes on the free list for the next new
+// thread to take over, so there are never more rings than threads traced at
+// once. Until then the dump still shows what the exited thread recorded.
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadRing>> rings;
+  std::vector<ThreadRing*> free;
+  int next_tid = 1;
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+std::chrono::steady_clock::time_point const g_epoch = std::chrono::steady_clock::now();
+
+// Returns the thread's ring to the free list as the thread exits. Spans
+// recorded by later thread-exit destructors are dropped.
+struct RingOwner {
+  ThreadRing* ring = nullptr;
+  bool exited = false;
+
+  ~RingOwner() {
+    exited = true;
+    if (!ring) return;
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.free.push_back(ring);
+    ring = nullptr;
+  }
+};
+
+thread_local RingOwner t_owner;
+thread_local char const* t_name = nullptr;
+
+ThreadRing* this_thread_ring() {
+  if (t_owner.ring || t_owner.exited) return t_owner.ring;
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  ThreadRing* ring;
+  if (!reg.free.empty()) {
+    // Only the dump reads a free ring, and it holds the lock.
+    ring = reg.free.back();
+    reg.free.pop_back();
+    ring->head.store(0, std::memory_order_relaxed);
+    ring->floor.store(0, std::memory_order_relaxed);
+  } else {
+    reg.rings.push_back(std::make_unique<ThreadRing>());
+    ring = reg.rings.back().get();
+  }
+  ring->tid = reg.next_tid++;
+  ring->name.store(t_name, std::memory_order_relaxed);
+  t_owner.ring = ring;
+  return ring;
+}
+
+void append_escaped(std::string& out, char const* text) {
+  for (char const* p = text ? text : ""; *p; ++p) {
+    char const c = *p;
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out += c;
+    }
+  }
+}
+
+}  // namespace
+
+namespace detail {
+
+std::int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - g_epoch)
+      .count();
+}
+
+void record(char const* name, char const* category, char const* arg_name,
+            std::int64_t arg, std::int64_t start_ns, std::int64_t end_ns) {
+  ThreadRing* ring = this_thread_ring();
+  if (!ring) return;
+  std::uint64_t const index = ring->head.load(std::memory_order_relaxed);
+  Slot& slot = ring->slots[index % kSpansPerThread];
+
+  std::uint32_t const seq = slot.seq.load(std::memory_order_relaxed);
+  slot.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.category.store(category, std::memory_order_relaxed);
+  slot.arg_name.store(arg_name, std::memory_order_relaxed);
+  slot.arg.store(arg, std::memory_order_relaxed);
+  slot.start_ns.store(start_ns, std::memory_order_relaxed);
+  slot.end_ns.store(end_ns, std::memory_order_relaxed);
+  slot.seq.store(seq + 2, std::memory_order_release);
+
+  ring->head.store(index + 1, std::memory_order_release);
+}
+
+}  // namespace detail
+
+void set_enabled(bool enabled) {
+  detail::g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void set_thread_name(char const* name) {
+  t_name = name;
+  if (ThreadRing* ring = t_owner.exited ? nullptr : t_owner.ring) {
+    ring->name.store(name, std::memory_order_relaxed);
+  }
+}
+
+void clear() {
+  // Rings stay registered; the dump only looks at spans written after this.
+  // The slots themselves are left alone, as only their thread writes them.
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (auto& ring : reg.rings) {
+    ring->floor.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
+
+std::string dump_json() {
+  std::string out;
+  out.reserve(64 * 1024);
+  out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  char buf[160];
+
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (auto const& ring : reg.rings) {
+    if (char const* name = ring->name.load(std::memory_order_relaxed)) {
+      if (!first) out += ',';
+      first = false;
+      std::snprintf(buf, sizeof(buf),
+                    "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"",
+                    ring->tid);
+      out += buf;
+      append_escaped(out, name);
+      out += "\"}}";
+    }
+
+    std::uint64_t const head = ring->head.load(std::memory_order_acquire);
+    std::uint64_t const begin = std::max(head > kSpansPerThread ? head - kSpansPerThread : 0,
+                                         ring->floor.load(std::memory_order_relaxed));
+    for (std::uint64_t i = begin; i < head; ++i) {
+      Slot const& slot = ring->slots[i % kSpansPerThread];
+      std::uint32_t const seq = slot.seq.load(std::memory_order_acquire);
+      char const* name = slot.name.load(std::memory_order_relaxed);
+      char const* category = slot.category.load(std::memory_order_relaxed);
+      char const* arg_name = slot.arg_name.load(std::memory_order_relaxed);
+      std::int64_t const arg = slot.arg.load(std::memory_order_relaxed);
+      std::int64_t const start_ns = slot.start_ns.load(std::memory_order_relaxed);
+      std::int64_t const end_ns = slot.end_ns.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if ((seq & 1) != 0 || seq != slot.seq.load(std::memory_order_relaxed)) continue;
+      if (!name || end_ns < start_ns) continue;  // torn or overwritten
+
+      if (!first) out += ',';
+      first = false;
+      out += "{\"ph\":\"X\",\"name\":\"";
+      append_escaped(out, name);
+      out += "\",\"cat\":\"";
+      append_escaped(out, category);
+      std::snprintf(buf, sizeof(buf), "\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                    ring->tid, static_cast<double>(start_ns) / 1000.0,
+                    static_cast<double>(end_ns - start_ns) / 1000.0);
+      out += buf;
+      if (arg_name) {
+        out += ",\"args\":{\"";
+        append_escaped(out, arg_name);
+        std::snprintf(buf, sizeof(buf), "\":%lld}", static_cast<long long>(arg));
+        out += buf;
+      }
+      out += '}';
+    }
+  }
+
+  out += "]}";
+  return out;
+}
+
+}  // namespace js8core::trace
@@ -17,7 +17,8 @@ void Modulator::start(std::array<int, protocol::kJs8NumSymbols> const& tones,
                       int period_ms,
                       double audio_frequency_hz,
                       double tx_delay_s,
-                      bool tuning) {
+                      bool tuning,
+                      bool sync) {
   if (symbol_samples <= 0 || period_ms <= 0) {
     stop();
     return;
@@ -37,8 +38,8 @@ void Modulator::start(std::array<int, protocol::kJs8NumSymbols> const& tones,
   ic_ = 0;
   isym0_ = std::numeric_limits<std::uint64_t>::max();
 
-  if (!tuning_) {
-    auto now = std::chrono::system_clock::now();
+  if (!tuning_ && sync) {
+    auto now = clock_->wall_now();
     auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
     auto period_offset = static_cast<std::int64_t>(now_ms % period_ms);
     auto tx_delay_ms = static_cast<std::int64_t>(tx_delay_s * 1000.0);
@@ -58,6 +59,12 @@ void Modulator::start(std::array<int, protocol::kJs8NumSymbols> const& tones,
   state_.store(silent_frames_ > 0 ? State::Synchronizing : State::Active);
 }
 
+void Modulator::start_now(std::array<int, protocol::kJs8NumSymbols> const& tones,
+                          int symbol_samples,
+                          double audio_frequency_hz) {
+  start(tones, symbol_samples, 0, 1, audio_frequency_hz, 0.0, false, false);
+}
+
 void Modulator::stop() {
   state_.store(State::Idle);
   silent_frames_ = 0;
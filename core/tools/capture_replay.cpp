@@ -0,0 +1,133 @@
+// Replays a capture recording (Js8Engine::start_recording) through a fresh
+// engine on a simulated clock and prints what it decodes.
+//
+//   js8core-replay capture.js8rec
+//   js8core-replay --no-wait capture.js8rec      # let the decode queue merge/drop as live
+//   js8core-replay --wav capture.wav capture.js8rec
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "js8core/engine.hpp"
+#include "js8core/recording.hpp"
+#include "wav_file.hpp"
+
+namespace {
+
+using namespace js8core;
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: js8core-replay [options] RECORDING\n"
+               "  --no-wait     do not wait for each decode before feeding more audio\n"
+               "  --wav PATH    also export the recorded stream (gaps as silence)\n"
+               "  --quiet       print only the summary\n");
+}
+
+// Decoded::mode carries the varicode submode value.
+char submode_letter(int mode) {
+  switch (mode) {
+    case 0: return 'A';
+    case 1: return 'B';
+    case 2: return 'C';
+    case 4: return 'E';
+    case 8: return 'I';
+  }
+  return '?';
+}
+
+bool export_wav(std::string const& recording_path, std::string const& wav_path) {
+  recording::Reader reader;
+  if (!reader.open(recording_path)) return false;
+  std::vector<std::int16_t> samples;
+  recording::Record record;
+  while (reader.next(record)) {
+    if (record.header.type == recording::RecordType::Audio) {
+      samples.insert(samples.end(), record.samples.begin(), record.samples.end());
+    } else if (record.header.type == recording::RecordType::Gap) {
+      samples.insert(samples.end(), record.header.count, 0);
+    }
+  }
+  return tools::write_wav(wav_path, samples, static_cast<int>(reader.header().sample_rate));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool wait = true, quiet = false;
+  std::string path, wav_path;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    if (arg == "--no-wait") {
+      wait = false;
+    } else if (arg == "--quiet") {
+      quiet = true;
+    } else if (arg == "--wav" && i + 1 < argc) {
+      wav_path = argv[++i];
+    } else if (!arg.empty() && arg[0] != '-' && path.empty()) {
+      path = arg;
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (path.empty()) {
+    usage();
+    return 2;
+  }
+
+  recording::Replay replay;
+  std::string error;
+  if (!replay.open(path, &error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+  auto const& header = replay.header();
+  std::printf("recording: %u Hz, submodes 0x%x, ring position %d, dial %llu Hz\n",
+              header.sample_rate, header.submodes, header.ring_position,
+              static_cast<unsigned long long>(header.dial_hz));
+
+  std::mutex mutex;
+  int decodes = 0;
+  EngineCallbacks callbacks;
+  callbacks.on_event = [&](events::Variant const& ev) {
+    if (auto const* d = std::get_if<events::Decoded>(&ev)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++decodes;
+      if (!quiet) {
+        std::printf("%06d %4d %5.1f %6.1f  %c  %s\n", d->utc, d->snr, d->xdt, d->frequency,
+                    submode_letter(d->mode), d->data.c_str());
+      }
+    }
+  };
+
+  EngineDependencies deps;
+  deps.clock = &replay.clock();
+  deps.scheduler = &replay.clock();
+  auto engine = make_engine(replay.config(), std::move(callbacks), deps);
+
+  auto const started = std::chrono::steady_clock::now();
+  auto const stats = replay.run(*engine, wait);
+  double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  auto const queue = engine->queue_stats().decode;
+  engine.reset();
+
+  double const audio_s = static_cast<double>(stats.samples + stats.gap_samples) / header.sample_rate;
+  std::printf("---\n%.1f s of audio (%.1f s gaps), %llu dial changes, %d decodes\n",
+              audio_s, static_cast<double>(stats.gap_samples) / header.sample_rate,
+              static_cast<unsigned long long>(stats.dial_changes), decodes);
+  std::printf("decode jobs %llu (merged %llu, dropped %llu), replayed in %.1f s (%.0fx real time)\n",
+              static_cast<unsigned long long>(queue.enqueued),
+              static_cast<unsigned long long>(queue.merged),
+              static_cast<unsigned long long>(queue.dropped), elapsed,
+              elapsed > 0.0 ? audio_s / elapsed : 0.0);
+
+  if (!wav_path.empty() && !export_wav(path, wav_path)) {
+    std::fprintf(stderr, "failed to write %s\n", wav_path.c_str());
+    return 1;
+  }
+  return 0;
+}
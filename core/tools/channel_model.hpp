@@ -0,0 +1,230 @@
+#pragma once
+
+// Synthetic JS8 channel shared by the js8core tools: random frames encoded
+// with legacy_encode() and rendered by the TX modulator, with per-signal
+// frequency/DT offsets, linear drift, optional Watterson fading and AWGN.
+//
+// Random numbers come from std::mt19937 (whose output the standard fixes)
+// through the helpers below rather than <random> distributions, so a seed
+// produces the same audio with any standard library.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "js8core/compat/numbers.hpp"
+#include "js8core/decoder.hpp"
+#include "js8core/protocol/constants.hpp"
+#include "js8core/protocol/costas.hpp"
+#include "js8core/protocol/submode.hpp"
+#include "js8core/tx/modulator.hpp"
+
+namespace js8core::tools {
+
+inline constexpr int kChannelRate = protocol::kJs8RxSampleRate;
+inline constexpr double kChannelNoiseRms = 800.0;
+
+class ChannelRng {
+public:
+  explicit ChannelRng(unsigned seed) : engine_(seed) {}
+
+  // Uniform in [0, 1).
+  double uniform() { return engine_() / 4294967296.0; }
+  double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+  int below(int n) { return static_cast<int>(uniform() * n); }
+
+  // Standard normal (Box-Muller).
+  double normal() {
+    if (has_spare_) {
+      has_spare_ = false;
+      return spare_;
+    }
+    double const u1 = 1.0 - uniform();
+    double const u2 = uniform();
+    double const r = std::sqrt(-2.0 * std::log(u1));
+    spare_ = r * std::sin(2.0 * std::numbers::pi * u2);
+    has_spare_ = true;
+    return r * std::cos(2.0 * std::numbers::pi * u2);
+  }
+
+private:
+  std::mt19937 engine_;
+  double spare_ = 0.0;
+  bool has_spare_ = false;
+};
+
+struct ChannelParams {
+  protocol::SubmodeId submode = protocol::SubmodeId::A;
+  int signals = 10;
+  double snr_db = -10.0;
+  double snr_spread_db = 0.0;
+  double fmin_hz = 500.0;
+  double fmax_hz = 2400.0;
+  double dt_max_s = 0.5;
+  double drift_hz = 0.0;
+  double doppler_hz = 0.0;  // 0 disables fading
+  double delay_ms = 0.0;    // second Watterson path; 0 = single path
+};
+
+struct ChannelSignal {
+  std::string frame;
+  int type = 0;
+  double frequency_hz = 0.0;
+  double dt_s = 0.0;
+  double snr_db = 0.0;
+  double drift_hz = 0.0;
+};
+
+// One Watterson path: a complex Gaussian tap with a Gaussian Doppler spectrum
+// whose two-sigma width is the Doppler spread, realised as a sum of sinusoids
+// with Gaussian-distributed frequencies. Evaluated every kGainStep samples and
+// interpolated, which is plenty for spreads of a few Hz.
+class FadingPath {
+public:
+  static constexpr int kGainStep = 64;
+
+  FadingPath(double spread_hz, ChannelRng& rng) {
+    for (auto& t : tones_) {
+      double const doppler = rng.normal() * spread_hz / 2.0;
+      t = {2.0 * std::numbers::pi * doppler / kChannelRate, rng.uniform(0.0, 2.0 * std::numbers::pi)};
+    }
+  }
+
+  std::vector<std::complex<double>> gains(std::size_t samples) const {
+    std::size_t const points = samples / kGainStep + 2;
+    std::vector<std::complex<double>> coarse(points);
+    double const norm = 1.0 / std::sqrt(static_cast<double>(tones_.size()));
+    for (std::size_t p = 0; p < points; ++p) {
+      std::complex<double> g{};
+      for (auto const& [w, phi] : tones_) g += std::polar(norm, phi + w * static_cast<double>(p * kGainStep));
+      coarse[p] = g;
+    }
+    std::vector<std::complex<double>> out(samples);
+    for (std::size_t n = 0; n < samples; ++n) {
+      std::size_t const p = n / kGainStep;
+      double const frac = static_cast<double>(n % kGainStep) / kGainStep;
+      out[n] = coarse[p] + frac * (coarse[p + 1] - coarse[p]);
+    }
+    return out;
+  }
+
+private:
+  std::array<std::pair<double, double>, 32> tones_{};
+};
+
+// Analytic signal via a Blackman-windowed Hilbert FIR; the audio band sits
+// well inside its passband at 12 kHz.
+inline std::vector<std::complex<double>> analytic(std::vector<double> const& x) {
+  constexpr int kHalf = 63;
+  static std::array<double, kHalf + 1> const taps = [] {
+    std::array<double, kHalf + 1> h{};
+    for (int k = 1; k <= kHalf; k += 2) {
+      double const w = 0.42 + 0.5 * std::cos(std::numbers::pi * k / (kHalf + 1)) +
+                       0.08 * std::cos(2.0 * std::numbers::pi * k / (kHalf + 1));
+      h[k] = 2.0 / (std::numbers::pi * k) * w;
+    }
+    return h;
+  }();
+
+  std::size_t const n = x.size();
+  std::vector<std::complex<double>> out(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    double q = 0.0;
+    for (int k = 1; k <= kHalf; k += 2) {
+      double const ahead = i >= static_cast<std::size_t>(k) ? x[i - k] : 0.0;
+      double const behind = i + k < n ? x[i + k] : 0.0;
+      q += taps[k] * (ahead - behind);
+    }
+    out[i] = {x[i], q};
+  }
+  return out;
+}
+
+// Random frames spread over [fmin, fmax): one slot per signal with the
+// signal placed at random inside it, so dense runs still overlap.
+inline std::vector<ChannelSignal> make_signals(ChannelParams const& p, ChannelRng& rng) {
+  static constexpr char kAlphabet[] =
+      "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz-+";
+  auto const sm = *protocol::find(p.submode);
+  double const bandwidth = 8.0 * kChannelRate / sm.symbol_samples;
+  double const slot = (p.fmax_hz - p.fmin_hz) / p.signals;
+
+  std::vector<ChannelSignal> signals(static_cast<std::size_t>(p.signals));
+  for (int i = 0; i < p.signals; ++i) {
+    auto& s = signals[static_cast<std::size_t>(i)];
+    s.frame.resize(12);
+    for (auto& c : s.frame) c = kAlphabet[rng.below(64)];
+    s.type = rng.below(8);
+    s.frequency_hz = p.fmin_hz + slot * i + rng.uniform(0.0, std::max(0.0, slot - bandwidth));
+    s.dt_s = p.dt_max_s * rng.uniform(-1.0, 1.0);
+    s.snr_db = p.snr_db + p.snr_spread_db * rng.uniform(-1.0, 1.0);
+    s.drift_hz = p.drift_hz > 0.0 ? p.drift_hz * rng.uniform(-1.0, 1.0) : 0.0;
+  }
+  return signals;
+}
+
+// One period of 12 kHz audio. SNR is relative to the noise in the 2500 Hz
+// reference bandwidth the decoder reports against.
+inline std::vector<std::int16_t> render_period(ChannelParams const& p,
+                                               std::vector<ChannelSignal> const& signals,
+                                               ChannelRng& rng) {
+  auto const sm = *protocol::find(p.submode);
+  auto const& costas = protocol::costas(p.submode == protocol::SubmodeId::A
+                                            ? protocol::CostasType::Original
+                                            : protocol::CostasType::Modified);
+  std::size_t const period = static_cast<std::size_t>(sm.tx_seconds) * kChannelRate;
+  std::size_t const frame_samples = static_cast<std::size_t>(protocol::kJs8NumSymbols) * sm.symbol_samples;
+  std::size_t const delay = static_cast<std::size_t>(p.delay_ms * kChannelRate / 1000.0);
+  double const noise_ref = kChannelNoiseRms * kChannelNoiseRms * 2500.0 / (kChannelRate / 2.0);
+
+  std::vector<double> mix(period, 0.0);
+  std::vector<double> x(frame_samples);
+  for (auto const& s : signals) {
+    std::array<int, protocol::kJs8NumSymbols> tones{};
+    legacy_encode(s.type, costas, s.frame.c_str(), tones.data());
+
+    tx::Modulator mod;
+    mod.start_now(tones, sm.symbol_samples, s.frequency_hz - s.drift_hz / 2.0);
+    for (std::size_t n = 0; n < frame_samples; ++n) {
+      mod.set_audio_frequency(s.frequency_hz + s.drift_hz * (static_cast<double>(n) / frame_samples - 0.5));
+      x[n] = mod.next_sample();
+    }
+
+    if (p.doppler_hz > 0.0) {
+      auto const a = analytic(x);
+      auto const g1 = FadingPath(p.doppler_hz, rng).gains(frame_samples);
+      if (delay == 0) {
+        for (std::size_t n = 0; n < frame_samples; ++n) x[n] = (g1[n] * a[n]).real();
+      } else {
+        auto const g2 = FadingPath(p.doppler_hz, rng).gains(frame_samples);
+        for (std::size_t n = 0; n < frame_samples; ++n) {
+          auto const late = n >= delay ? a[n - delay] : std::complex<double>{};
+          x[n] = ((g1[n] * a[n] + g2[n] * late) / std::sqrt(2.0)).real();
+        }
+      }
+    }
+
+    double const amplitude = std::sqrt(2.0 * noise_ref * std::pow(10.0, s.snr_db / 10.0));
+    long const offset = std::lround((sm.start_delay_ms / 1000.0 + s.dt_s) * kChannelRate);
+    for (std::size_t n = 0; n < frame_samples; ++n) {
+      long const at = offset + static_cast<long>(n);
+      if (at >= 0 && at < static_cast<long>(period)) mix[static_cast<std::size_t>(at)] += amplitude * x[n];
+    }
+  }
+
+  std::vector<std::int16_t> out(period);
+  for (std::size_t n = 0; n < period; ++n) {
+    long const v = std::lround(mix[n] + kChannelNoiseRms * rng.normal());
+    out[n] = static_cast<std::int16_t>(std::clamp(v, -32768L, 32767L));
+  }
+  return out;
+}
+
+}  // namespace js8core::tools
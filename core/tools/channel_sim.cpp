@@ -0,0 +1,284 @@
+// Synthetic JS8 channel simulator.
+//
+// Generates N simultaneous JS8 signals per period with legacy_encode() and
+// the TX modulator, applies per-signal frequency/DT offsets, linear drift and
+// optional Watterson fading, adds AWGN at a given SNR (2500 Hz reference
+// bandwidth, as reported by the decoder), and either writes the result to a
+// WAV file or streams it through a js8core engine and scores the decodes.
+//
+//   js8core-channel-sim --submode A --signals 50 --snr -12 --engine
+//   js8core-channel-sim --signals 20 --sweep -24:-4:2 --doppler 1 --engine
+//   js8core-channel-sim --signals 10 --periods 4 --wav sim.wav
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "channel_model.hpp"
+#include "js8core/engine.hpp"
+#include "js8core/protocol/submode.hpp"
+#include "wav_file.hpp"
+
+namespace {
+
+using namespace js8core;
+
+constexpr int kRate = tools::kChannelRate;
+
+struct Options {
+  tools::ChannelParams channel;
+  int periods = 1;
+  unsigned seed = 1;
+  std::string wav_path;
+  std::string record_path;
+  bool engine = false;
+  std::optional<std::array<double, 3>> sweep;  // from, to, step
+};
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: js8core-channel-sim [options]\n"
+               "  --submode A|B|C|E|I   submode to simulate (A)\n"
+               "  --signals N           signals per period (10)\n"
+               "  --periods N           periods per SNR point (1)\n"
+               "  --snr DB              per-signal SNR in 2500 Hz (-10)\n"
+               "  --snr-spread DB       uniform +/- spread around --snr (0)\n"
+               "  --sweep FROM:TO:STEP  repeat the run for each SNR and print CSV\n"
+               "  --fmin HZ --fmax HZ   audio range for signals (500..2400)\n"
+               "  --dt-max S            random DT within +/- S seconds (0.5)\n"
+               "  --drift HZ            random linear drift within +/- HZ over a frame (0)\n"
+               "  --doppler HZ          Watterson Doppler spread, 0 disables fading (0)\n"
+               "  --delay MS            Watterson second-path delay (0 = single path)\n"
+               "  --seed N              random seed (1)\n"
+               "  --wav PATH            write the generated audio (12 kHz mono)\n"
+               "  --engine              stream into a js8core engine and score decodes\n"
+               "  --record PATH         with --engine, record the capture stream it sees\n");
+}
+
+std::optional<Options> parse(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    auto value = [&]() -> char const* { return i + 1 < argc ? argv[++i] : nullptr; };
+    char const* v = nullptr;
+    if (arg == "--engine") {
+      opt.engine = true;
+      continue;
+    }
+    if (!(v = value())) return std::nullopt;
+    if (arg == "--submode") {
+      auto sm = protocol::find(std::string_view(v));
+      if (!sm) return std::nullopt;
+      opt.channel.submode = sm->id;
+    } else if (arg == "--signals") {
+      opt.channel.signals = std::max(1, std::atoi(v));
+    } else if (arg == "--periods") {
+      opt.periods = std::max(1, std::atoi(v));
+    } else if (arg == "--snr") {
+      opt.channel.snr_db = std::atof(v);
+    } else if (arg == "--snr-spread") {
+      opt.channel.snr_spread_db = std::atof(v);
+    } else if (arg == "--sweep") {
+      std::array<double, 3> s{};
+      if (std::sscanf(v, "%lf:%lf:%lf", &s[0], &s[1], &s[2]) != 3 || s[2] <= 0.0) return std::nullopt;
+      opt.sweep = s;
+    } else if (arg == "--fmin") {
+      opt.channel.fmin_hz = std::atof(v);
+    } else if (arg == "--fmax") {
+      opt.channel.fmax_hz = std::atof(v);
+    } else if (arg == "--dt-max") {
+      opt.channel.dt_max_s = std::atof(v);
+    } else if (arg == "--drift") {
+      opt.channel.drift_hz = std::atof(v);
+    } else if (arg == "--doppler") {
+      opt.channel.doppler_hz = std::atof(v);
+    } else if (arg == "--delay") {
+      opt.channel.delay_ms = std::atof(v);
+    } else if (arg == "--seed") {
+      opt.seed = static_cast<unsigned>(std::strtoul(v, nullptr, 10));
+    } else if (arg == "--wav") {
+      opt.wav_path = v;
+    } else if (arg == "--record") {
+      opt.record_path = v;
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (opt.channel.fmax_hz <= opt.channel.fmin_hz) return std::nullopt;
+  if (!opt.engine && opt.wav_path.empty()) return std::nullopt;
+  if (!opt.engine && !opt.record_path.empty()) return std::nullopt;
+  return opt;
+}
+
+// Streams audio into an engine in 100 ms blocks and collects what it decodes.
+// The engine runs on a simulated clock that starts on a UTC minute and
+// advances with the audio, so generated periods line up with its decode
+// windows and nothing waits on real time.
+class EngineHarness {
+public:
+  explicit EngineHarness(protocol::SubmodeId submode) {
+    EngineConfig config;
+    config.sample_rate_hz = kRate;
+    config.submodes = 1 << static_cast<int>(submode);
+
+    EngineCallbacks callbacks;
+    callbacks.on_event = [this](events::Variant const& ev) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (auto const* d = std::get_if<events::Decoded>(&ev)) {
+        decoded_.insert(d->data);
+      } else if (auto const* m = std::get_if<events::DecodeMetrics>(&ev)) {
+        decode_ms_ += std::chrono::duration<double, std::milli>(m->total.wall).count();
+      } else if (std::holds_alternative<events::DecodeFinished>(ev)) {
+        ++finished_;
+        cv_.notify_all();
+      }
+    };
+
+    EngineDependencies deps;
+    deps.clock = &clock_;
+    deps.scheduler = &clock_;
+    engine_ = make_engine(config, std::move(callbacks), deps);
+  }
+
+  // Decode one period; returns the set of decoded frames.
+  std::set<std::string> run(std::vector<std::int16_t> const& audio) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      decoded_.clear();
+    }
+    submit(audio);
+    wait_idle();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return decoded_;
+  }
+
+  double decode_ms() const { return decode_ms_; }
+  Js8Engine& engine() { return *engine_; }
+
+private:
+  void submit(std::vector<std::int16_t> const& audio) {
+    constexpr std::size_t kBlock = kRate / 10;
+    for (std::size_t pos = 0; pos < audio.size(); pos += kBlock) {
+      std::size_t const n = std::min(kBlock, audio.size() - pos);
+      AudioInputBuffer buffer;
+      buffer.format.sample_rate = kRate;
+      buffer.format.channels = 1;
+      buffer.format.sample_type = SampleType::Int16;
+      buffer.data = std::as_bytes(std::span<const std::int16_t>(audio.data() + pos, n));
+      buffer.captured_at = clock_.steady_now();
+      engine_->submit_capture(buffer);
+      clock_.advance(std::chrono::microseconds(n * 1000000 / kRate));
+    }
+  }
+
+  // Every dequeued decode job has finished and nothing is pending.
+  void wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      auto const stats = engine_->queue_stats().decode;
+      if (stats.depth == 0 && stats.processed == finished_) return;
+      cv_.wait_for(lock, std::chrono::milliseconds(20));
+    }
+  }
+
+  SimulatedClock clock_;
+  std::unique_ptr<Js8Engine> engine_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::set<std::string> decoded_;
+  std::uint64_t finished_ = 0;
+  double decode_ms_ = 0.0;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  auto parsed = parse(argc, argv);
+  if (!parsed) {
+    usage();
+    return 2;
+  }
+  Options const opt = *parsed;
+  tools::ChannelRng rng(opt.seed);
+
+  std::vector<double> snrs;
+  if (opt.sweep) {
+    auto const [from, to, step] = *opt.sweep;
+    for (double snr = from; snr <= to + 1e-9; snr += step) snrs.push_back(snr);
+  } else {
+    snrs.push_back(opt.channel.snr_db);
+  }
+
+  std::optional<EngineHarness> harness;
+  if (opt.engine) harness.emplace(opt.channel.submode);
+  if (harness && !opt.record_path.empty()) {
+    std::string error;
+    if (!harness->engine().start_recording(opt.record_path, &error)) {
+      std::fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+  }
+
+  std::vector<std::int16_t> wav;
+  bool const csv = opt.sweep.has_value();
+  if (csv) std::printf("snr_db,sent,decoded,false_decodes,decode_ms\n");
+
+  for (double const snr : snrs) {
+    int sent = 0, decoded = 0, false_decodes = 0;
+    double const decode_ms_before = harness ? harness->decode_ms() : 0.0;
+
+    for (int p = 0; p < opt.periods; ++p) {
+      auto channel = opt.channel;
+      channel.snr_db = snr;
+      auto const signals = tools::make_signals(channel, rng);
+      auto const audio = tools::render_period(channel, signals, rng);
+      if (!opt.wav_path.empty()) wav.insert(wav.end(), audio.begin(), audio.end());
+
+      if (!csv) {
+        for (auto const& s : signals) {
+          std::printf("period %d: %7.1f Hz  dt %+5.2f s  snr %+5.1f dB  drift %+5.2f Hz  %s\n",
+                      p, s.frequency_hz, s.dt_s, s.snr_db, s.drift_hz, s.frame.c_str());
+        }
+      }
+      if (!harness) continue;
+
+      auto const got = harness->run(audio);
+      std::set<std::string> expected;
+      for (auto const& s : signals) expected.insert(s.frame);
+      sent += static_cast<int>(signals.size());
+      for (auto const& frame : got) {
+        if (expected.count(frame)) ++decoded;
+        else ++false_decodes;
+      }
+    }
+
+    if (harness) {
+      double const ms = harness->decode_ms() - decode_ms_before;
+      if (csv) {
+        std::printf("%.1f,%d,%d,%d,%.1f\n", snr, sent, decoded, false_decodes, ms);
+      } else {
+        std::printf("decoded %d/%d (%.1f%%), %d false, %.1f ms decoding\n",
+                    decoded, sent, sent ? 100.0 * decoded / sent : 0.0, false_decodes, ms);
+      }
+    }
+  }
+
+  if (harness && !opt.record_path.empty()) harness->engine().stop_recording();
+
+  if (!opt.wav_path.empty()) {
+    if (!tools::write_wav(opt.wav_path, wav, kRate)) {
+      std::fprintf(stderr, "failed to write %s\n", opt.wav_path.c_str());
+      return 1;
+    }
+    std::fprintf(stderr, "wrote %zu samples to %s\n", wav.size(), opt.wav_path.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,460 @@
+// Golden-vector decode regression harness.
+//
+// Decodes every media/tests fixture ({MODE}_{DEPTH}_{EXPECTED}.wav) and a
+// fixed, seeded corpus from the channel model, then compares each result with
+// its golden decode list (frame, type, SNR, DT, frequency) and, optionally,
+// with a per-file timing baseline recorded on the same machine. Times are the
+// fastest of --repeat runs of the decoder thread's CPU time, divided by the
+// time of a fixed calibration kernel run alongside each file, so that clock
+// scaling and noisy neighbours move both sides of the ratio together.
+//
+// A file fails when a golden decode goes missing or drifts outside tolerance,
+// or when a generated file produces a frame that was never sent. The run fails
+// when any file does, or when the summed decode time exceeds the baseline sum
+// by more than --max-slowdown; single files over the limit are only flagged,
+// since one file's time is too noisy to gate on.
+//
+// The EXPECTED count in a fixture name is what the desktop decoder finds at
+// that depth; js8core has no depth setting, so a shortfall against it is
+// reported but the golden list is what gates.
+//
+//   js8core-decode-regression media/tests
+//   js8core-decode-regression --timings base.txt --update-timings media/tests
+//   js8core-decode-regression --timings base.txt media/tests
+//   js8core-decode-regression --update-golden media/tests
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "channel_model.hpp"
+#include "js8core/decoder.hpp"
+#include "js8core/protocol/submode.hpp"
+#include "wav_file.hpp"
+
+namespace {
+
+using namespace js8core;
+namespace fs = std::filesystem;
+
+constexpr int kRate = protocol::kJs8RxSampleRate;
+constexpr double kSnrTolerance = 1.0;    // dB
+constexpr double kDtTolerance = 0.05;    // s
+constexpr double kFreqTolerance = 1.0;   // Hz
+constexpr double kTimeSlackMs = 5.0;     // ignore slowdowns smaller than this
+
+struct Options {
+  fs::path media_dir;
+  fs::path golden_dir;
+  std::string timings_path;
+  bool update_golden = false;
+  bool update_timings = false;
+  bool generated = true;
+  int repeat = 5;
+  double max_slowdown = 1.25;
+};
+
+struct Entry {
+  std::string frame;
+  int type = 0;
+  int snr = 0;
+  double dt = 0.0;
+  double freq = 0.0;
+};
+
+// One audio period to decode, from a fixture or the generated corpus.
+struct Case {
+  std::string name;
+  protocol::SubmodeId submode = protocol::SubmodeId::A;
+  std::vector<std::int16_t> audio;
+  int expected = 0;  // desktop decoder count at DEPTH; fixtures only
+  std::vector<std::string> sent;  // generated only
+};
+
+struct GeneratedSpec {
+  char const* name;
+  protocol::SubmodeId submode;
+  int signals;
+  double snr_db;
+  double snr_spread_db;
+  double doppler_hz;
+  double delay_ms;
+  double drift_hz;
+  unsigned seed;
+};
+
+// SNRs sit a few dB above threshold so the corpus stays stable across
+// compilers and libm versions; --update-golden after any intentional change.
+constexpr GeneratedSpec kGenerated[] = {
+    {"gen_A_clean", protocol::SubmodeId::A, 10, -14.0, 4.0, 0.0, 0.0, 0.0, 101},
+    {"gen_A_drift", protocol::SubmodeId::A, 10, -12.0, 4.0, 0.0, 0.0, 2.0, 102},
+    {"gen_A_fading", protocol::SubmodeId::A, 10, -8.0, 4.0, 1.0, 2.0, 0.0, 103},
+    {"gen_A_dense", protocol::SubmodeId::A, 40, -10.0, 6.0, 0.0, 0.0, 0.0, 104},
+    {"gen_B_clean", protocol::SubmodeId::B, 10, -12.0, 4.0, 0.0, 0.0, 0.0, 105},
+    {"gen_C_clean", protocol::SubmodeId::C, 8, -10.0, 4.0, 0.0, 0.0, 0.0, 106},
+    {"gen_E_clean", protocol::SubmodeId::E, 10, -16.0, 4.0, 0.0, 0.0, 0.0, 107},
+    {"gen_I_clean", protocol::SubmodeId::I, 6, -6.0, 4.0, 0.0, 0.0, 0.0, 108},
+};
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: js8core-decode-regression [options] MEDIA_DIR\n"
+               "  --golden DIR          golden decode lists (MEDIA_DIR/golden)\n"
+               "  --update-golden       rewrite the golden lists from this run\n"
+               "  --timings FILE        per-file decode time baseline to compare against\n"
+               "  --update-timings      rewrite --timings from this run\n"
+               "  --max-slowdown X      fail when time > baseline * X (1.25)\n"
+               "  --repeat N            decode each file N times, keep the fastest (5)\n"
+               "  --no-generated        skip the generated corpus\n");
+}
+
+std::optional<Options> parse(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    auto value = [&]() -> char const* { return i + 1 < argc ? argv[++i] : nullptr; };
+    char const* v = nullptr;
+    if (arg == "--update-golden") {
+      opt.update_golden = true;
+    } else if (arg == "--update-timings") {
+      opt.update_timings = true;
+    } else if (arg == "--no-generated") {
+      opt.generated = false;
+    } else if (arg == "--golden") {
+      if (!(v = value())) return std::nullopt;
+      opt.golden_dir = v;
+    } else if (arg == "--timings") {
+      if (!(v = value())) return std::nullopt;
+      opt.timings_path = v;
+    } else if (arg == "--max-slowdown") {
+      if (!(v = value())) return std::nullopt;
+      opt.max_slowdown = std::atof(v);
+    } else if (arg == "--repeat") {
+      if (!(v = value())) return std::nullopt;
+      opt.repeat = std::max(1, std::atoi(v));
+    } else if (!arg.empty() && arg[0] != '-' && opt.media_dir.empty()) {
+      opt.media_dir = arg;
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (opt.media_dir.empty() || opt.max_slowdown < 1.0) return std::nullopt;
+  if (opt.update_timings && opt.timings_path.empty()) return std::nullopt;
+  if (opt.golden_dir.empty()) opt.golden_dir = opt.media_dir / "golden";
+  return opt;
+}
+
+// {MODE}_{DEPTH}_{EXPECTED}.wav
+std::optional<Case> load_fixture(fs::path const& path) {
+  std::string const stem = path.stem().string();
+  auto const first = stem.find('_');
+  auto const second = stem.find('_', first + 1);
+  if (first == std::string::npos || second == std::string::npos) return std::nullopt;
+  auto const sm = protocol::find(std::string_view(stem).substr(0, first));
+  if (!sm) return std::nullopt;
+
+  tools::WavData wav;
+  if (!tools::read_wav(path.string(), wav) || wav.sample_rate != kRate) return std::nullopt;
+
+  Case c;
+  c.name = path.filename().string();
+  c.submode = sm->id;
+  c.audio = std::move(wav.samples);
+  c.expected = std::atoi(stem.c_str() + second + 1);
+  return c;
+}
+
+Case make_generated(GeneratedSpec const& spec) {
+  tools::ChannelParams params;
+  params.submode = spec.submode;
+  params.signals = spec.signals;
+  params.snr_db = spec.snr_db;
+  params.snr_spread_db = spec.snr_spread_db;
+  params.doppler_hz = spec.doppler_hz;
+  params.delay_ms = spec.delay_ms;
+  params.drift_hz = spec.drift_hz;
+
+  tools::ChannelRng rng(spec.seed);
+  auto const signals = tools::make_signals(params, rng);
+
+  Case c;
+  c.name = spec.name;
+  c.submode = spec.submode;
+  c.audio = tools::render_period(params, signals, rng);
+  for (auto const& s : signals) c.sent.push_back(s.frame);
+  return c;
+}
+
+// Decode one period placed at the start of the ring, as the engine would for
+// a window that starts on a period boundary.
+std::vector<Entry> decode(Case const& c, DecodeState& state, double& wall_ms, double& cpu_ms) {
+  auto const sm = *protocol::find(c.submode);
+  int const size = std::min(static_cast<int>(c.audio.size()), sm.tx_seconds * kRate);
+
+  std::fill(state.samples.begin(), state.samples.end(), 0);
+  std::copy_n(c.audio.begin(), size, state.samples.begin());
+
+  DecodeParams& params = state.params;
+  params = DecodeParams{};
+  params.nfa = 200;
+  params.nfb = 3000;
+  params.nfqso = 1500;
+  params.newdat = true;
+  params.kin = size;
+  params.nsubmodes = 1 << static_cast<int>(c.submode);
+  switch (c.submode) {
+    case protocol::SubmodeId::A: params.kszA = size; break;
+    case protocol::SubmodeId::B: params.kszB = size; break;
+    case protocol::SubmodeId::C: params.kszC = size; break;
+    case protocol::SubmodeId::E: params.kszE = size; break;
+    case protocol::SubmodeId::I: params.kszI = size; break;
+  }
+
+  std::vector<Entry> out;
+  legacy_decode(state, [&](events::Variant const& ev) {
+    if (auto const* d = std::get_if<events::Decoded>(&ev)) {
+      out.push_back({d->data, d->type, d->snr, d->xdt, d->frequency});
+    } else if (auto const* m = std::get_if<events::DecodeMetrics>(&ev)) {
+      wall_ms = std::chrono::duration<double, std::milli>(m->total.wall).count();
+      cpu_ms = std::chrono::duration<double, std::milli>(m->total.cpu).count();
+    }
+  });
+  std::sort(out.begin(), out.end(), [](Entry const& a, Entry const& b) {
+    return a.freq != b.freq ? a.freq < b.freq : a.frame < b.frame;
+  });
+  return out;
+}
+
+double thread_cpu_ms() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+#endif
+  return std::clock() * 1e3 / CLOCKS_PER_SEC;
+}
+
+// A few milliseconds of float multiply-add and sqrt over a cache-resident
+// buffer; roughly the mix the decoder's inner loops run.
+double calibrate() {
+  static std::vector<float> buffer(16384, 1.0f);
+  double const start = thread_cpu_ms();
+  float acc = 0.0f;
+  for (int round = 0; round < 200; ++round) {
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+      buffer[i] = buffer[i] * 0.999f + std::sqrt(static_cast<float>(i + round));
+      acc += buffer[i];
+    }
+  }
+  double const ms = thread_cpu_ms() - start;
+  volatile float sink = acc;
+  (void)sink;
+  return std::max(ms, 1e-3);
+}
+
+std::optional<std::vector<Entry>> read_golden(fs::path const& path) {
+  std::ifstream in(path);
+  if (!in) return std::nullopt;
+  std::vector<Entry> out;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    Entry e;
+    if (fields >> e.frame >> e.type >> e.snr >> e.dt >> e.freq) out.push_back(e);
+  }
+  return out;
+}
+
+bool write_golden(fs::path const& path, std::vector<Entry> const& entries) {
+  std::ofstream out(path);
+  if (!out) return false;
+  out << "# frame type snr dt freq\n";
+  char line[96];
+  for (auto const& e : entries) {
+    std::snprintf(line, sizeof(line), "%s %d %d %.2f %.1f\n",
+                  e.frame.c_str(), e.type, e.snr, e.dt, e.freq);
+    out << line;
+  }
+  return static_cast<bool>(out);
+}
+
+std::map<std::string, double> read_timings(std::string const& path) {
+  std::map<std::string, double> out;
+  std::ifstream in(path);
+  std::string name;
+  double score = 0.0;
+  while (in >> name >> score) out[name] = score;
+  return out;
+}
+
+// Golden entries without a matching decode (same frame and type, within
+// tolerance); each decode may satisfy one golden entry.
+int count_missing(std::vector<Entry> const& golden, std::vector<Entry> const& got, int& drifted) {
+  std::vector<bool> used(got.size(), false);
+  int missing = 0;
+  drifted = 0;
+  for (auto const& g : golden) {
+    bool found = false, same_frame = false;
+    for (std::size_t i = 0; i < got.size() && !found; ++i) {
+      auto const& d = got[i];
+      if (used[i] || d.frame != g.frame || d.type != g.type) continue;
+      same_frame = true;
+      if (std::abs(d.snr - g.snr) <= kSnrTolerance && std::abs(d.dt - g.dt) <= kDtTolerance + 0.005 &&
+          std::abs(d.freq - g.freq) <= kFreqTolerance + 0.05) {
+        used[i] = true;
+        found = true;
+      }
+    }
+    if (!found) {
+      ++missing;
+      if (same_frame) ++drifted;
+    }
+  }
+  return missing;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  auto parsed = parse(argc, argv);
+  if (!parsed) {
+    usage();
+    return 2;
+  }
+  Options const opt = *parsed;
+
+  std::vector<Case> cases;
+  std::vector<fs::path> fixtures;
+  std::error_code ec;
+  for (auto const& item : fs::directory_iterator(opt.media_dir, ec)) {
+    if (item.path().extension() == ".wav") fixtures.push_back(item.path());
+  }
+  if (ec) {
+    std::fprintf(stderr, "cannot read %s: %s\n", opt.media_dir.string().c_str(), ec.message().c_str());
+    return 2;
+  }
+  std::sort(fixtures.begin(), fixtures.end());
+  for (auto const& path : fixtures) {
+    if (auto c = load_fixture(path)) {
+      cases.push_back(std::move(*c));
+    } else {
+      std::fprintf(stderr, "skipping %s: not a 12 kHz {MODE}_{DEPTH}_{EXPECTED}.wav\n",
+                   path.filename().string().c_str());
+    }
+  }
+  if (opt.generated) {
+    for (auto const& spec : kGenerated) cases.push_back(make_generated(spec));
+  }
+
+  if (opt.update_golden) fs::create_directories(opt.golden_dir, ec);
+  auto const baseline = opt.timings_path.empty() ? std::map<std::string, double>{}
+                                                 : read_timings(opt.timings_path);
+  std::map<std::string, double> timings;
+
+  DecodeState state;
+  state.samples.assign(static_cast<std::size_t>(kJs8NtMax) * kRate, 0);
+
+  int failures = 0;
+  double total_ms = 0.0, total_score = 0.0, total_base = 0.0;
+  std::printf("%-16s %7s %9s %7s %6s %9s %9s %7s %7s  %s\n",
+              "file", "decoded", "expected", "golden", "extra", "wall_ms", "cpu_ms", "score", "base", "result");
+
+  for (auto const& c : cases) {
+    std::vector<Entry> got;
+    double best_wall = 0.0, best_cpu = 0.0, best_calibration = 0.0;
+    for (int r = 0; r < opt.repeat; ++r) {
+      double const calibration = calibrate();
+      double wall = 0.0, cpu = 0.0;
+      auto run = decode(c, state, wall, cpu);
+      best_wall = r == 0 ? wall : std::min(best_wall, wall);
+      best_cpu = r == 0 ? cpu : std::min(best_cpu, cpu);
+      best_calibration = r == 0 ? calibration : std::min(best_calibration, calibration);
+      if (r == 0) got = std::move(run);
+    }
+    double const score = best_cpu / best_calibration;
+    timings[c.name] = score;
+    total_ms += best_cpu;
+
+    std::string const stem = fs::path(c.name).stem().string();
+    fs::path const golden_path = opt.golden_dir / (stem + ".txt");
+    std::vector<std::string> problems;
+
+    // Generated files know what was sent; anything else is a false decode.
+    int const decoded = static_cast<int>(got.size());
+    int const expected = c.sent.empty() ? c.expected : static_cast<int>(c.sent.size());
+    for (auto const& e : got) {
+      if (!c.sent.empty() && std::find(c.sent.begin(), c.sent.end(), e.frame) == c.sent.end()) {
+        problems.push_back("false decode " + e.frame);
+      }
+    }
+
+    int golden_count = 0, missing = 0, drifted = 0;
+    if (opt.update_golden) {
+      if (!write_golden(golden_path, got)) problems.push_back("cannot write " + golden_path.string());
+      golden_count = decoded;
+    } else if (auto golden = read_golden(golden_path)) {
+      golden_count = static_cast<int>(golden->size());
+      missing = count_missing(*golden, got, drifted);
+      if (missing > 0) {
+        problems.push_back(std::to_string(missing) + " golden decode(s) lost" +
+                           (drifted ? " (" + std::to_string(drifted) + " outside tolerance)" : ""));
+      }
+    } else {
+      problems.push_back("no golden list " + golden_path.string());
+    }
+
+    double base = 0.0;
+    if (auto it = baseline.find(c.name); it != baseline.end() && !opt.update_timings) {
+      base = it->second;
+    }
+    // Only files with a baseline count toward the aggregate comparison.
+    if (base > 0.0) {
+      total_score += score;
+      total_base += base;
+    }
+    bool const slow = base > 0.0 && score > base * opt.max_slowdown &&
+                      best_cpu - base * best_calibration > kTimeSlackMs;
+
+    int const extra = std::max(0, decoded - (golden_count - missing));
+    std::printf("%-16s %7d %9d %4d/%-2d %6d %9.1f %9.1f %7.2f %7.2f  %s\n",
+                c.name.c_str(), decoded, expected, golden_count - missing, golden_count, extra,
+                best_wall, best_cpu, score, base, !problems.empty() ? "FAIL" : slow ? "slow" : "ok");
+    for (auto const& p : problems) std::printf("    %s\n", p.c_str());
+    if (!problems.empty()) ++failures;
+    if (c.sent.empty() && decoded < expected) {
+      std::printf("    note: %d short of the desktop decoder\n", expected - decoded);
+    }
+  }
+
+  if (opt.update_timings) {
+    std::ofstream out(opt.timings_path);
+    char line[96];
+    for (auto const& [name, score] : timings) {
+      std::snprintf(line, sizeof(line), "%s %.4f\n", name.c_str(), score);
+      out << line;
+    }
+    if (!out) {
+      std::fprintf(stderr, "failed to write %s\n", opt.timings_path.c_str());
+      return 1;
+    }
+  }
+
+  std::printf("---\n%zu files, %d failed, %.1f ms decoder CPU\n", cases.size(), failures, total_ms);
+  bool regressed = false;
+  if (total_base > 0.0) {
+    regressed = total_score > total_base * opt.max_slowdown;
+    std::printf("time %.2f vs baseline %.2f (%+.1f%%)%s\n", total_score, total_base,
+                100.0 * (total_score / total_base - 1.0), regressed ? ": FAIL" : "");
+  }
+  return failures == 0 && !regressed ? 0 : 1;
+}
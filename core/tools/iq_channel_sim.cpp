@@ -0,0 +1,304 @@
+// Feeds a synthetic wideband IQ stream through a WidebandReceiver and scores
+// each channel's decodes. Every dial gets its own simulated JS8 channel
+// (channel_model.hpp), which is shifted to its place in the IQ spectrum as
+// a USB signal; with the default 3 kHz spacing each channel's opposite
+// sideband holds its lower neighbour's signals, so a decode of a neighbour's
+// frame means the channelizer let its image through. Decodes should match
+// js8core-receiver-bench with the same --signals, --snr and --seed, which
+// decodes the same channels as plain audio.
+//
+//   js8core-iq-sim --channels 4 --iq-rate 96000 --signals 8
+//   js8core-iq-sim --channels 12 --iq-rate 192000 --spacing 10000 --periods 1
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fftw3.h>
+
+#include "channel_model.hpp"
+#include "js8core/engine.hpp"
+#include "js8core/protocol/submode.hpp"
+#include "js8core/receiver_host.hpp"
+#include "js8core/wideband_receiver.hpp"
+
+namespace {
+
+using namespace js8core;
+
+constexpr int kRate = tools::kChannelRate;
+constexpr FrequencyHz kFirstDial = 7078000;
+
+struct Options {
+  tools::ChannelParams channel;
+  int channels = 4;
+  int iq_rate = 96000;
+  int spacing_hz = 3000;
+  double floor_rms = 100.0;  // wideband noise, int16 units, over the whole span
+  int periods = 2;
+  unsigned seed = 1;
+  ReceiverHostConfig host;
+};
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: js8core-iq-sim [options]\n"
+               "  --channels N          dials in the IQ stream (4)\n"
+               "  --iq-rate HZ          IQ sample rate (96000)\n"
+               "  --spacing HZ          dial spacing (3000)\n"
+               "  --threads N           decode threads, 0 = cores - 1 (0)\n"
+               "  --submode A|B|C|E|I   submode of every channel (A)\n"
+               "  --signals N           signals per channel per period (8)\n"
+               "  --snr DB              per-signal SNR in 2500 Hz (-10)\n"
+               "  --periods N           periods to run (2)\n"
+               "  --seed N              random seed (1)\n");
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+  opt.channel.signals = 8;
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    char const* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) return false;
+    ++i;
+    if (arg == "--channels") {
+      opt.channels = std::atoi(value);
+    } else if (arg == "--iq-rate") {
+      opt.iq_rate = std::atoi(value);
+    } else if (arg == "--spacing") {
+      opt.spacing_hz = std::atoi(value);
+    } else if (arg == "--threads") {
+      opt.host.decode_threads = std::atoi(value);
+    } else if (arg == "--submode") {
+      auto const sm = protocol::find(std::string_view(value));
+      if (!sm) return false;
+      opt.channel.submode = sm->id;
+    } else if (arg == "--signals") {
+      opt.channel.signals = std::atoi(value);
+    } else if (arg == "--snr") {
+      opt.channel.snr_db = std::atof(value);
+    } else if (arg == "--periods") {
+      opt.periods = std::atoi(value);
+    } else if (arg == "--seed") {
+      opt.seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else {
+      return false;
+    }
+  }
+  return opt.channels > 0 && opt.periods > 0 && opt.channel.signals > 0 && opt.spacing_hz > 0 &&
+         opt.iq_rate > kRate;
+}
+
+// One period of IQ: each channel's audio spectrum moved up to its dial's
+// offset from the centre. Both grids have a bin every 1 / period seconds,
+// so whole-hertz offsets land exactly on a bin.
+std::vector<std::complex<float>> render_iq(Options const& opt,
+                                           std::vector<std::vector<std::int16_t>> const& audio,
+                                           std::vector<FrequencyHz> const& dials,
+                                           FrequencyHz center,
+                                           tools::ChannelRng& rng) {
+  std::size_t const period_s = audio[0].size() / kRate;
+  std::size_t const n = audio[0].size();
+  std::size_t const wide = period_s * static_cast<std::size_t>(opt.iq_rate);
+
+  std::vector<float> x(n);
+  std::vector<std::complex<float>> bins(n / 2 + 1);
+  std::vector<std::complex<float>> spectrum(wide);
+  fftwf_plan const forward = fftwf_plan_dft_r2c_1d(static_cast<int>(n), x.data(),
+                                                   reinterpret_cast<fftwf_complex*>(bins.data()), FFTW_ESTIMATE);
+  fftwf_plan const inverse = fftwf_plan_dft_1d(static_cast<int>(wide), reinterpret_cast<fftwf_complex*>(spectrum.data()),
+                                               reinterpret_cast<fftwf_complex*>(spectrum.data()), FFTW_BACKWARD,
+                                               FFTW_ESTIMATE);
+
+  for (std::size_t c = 0; c < audio.size(); ++c) {
+    for (std::size_t i = 0; i < n; ++i) x[i] = audio[c][i] / 32768.0f;
+    fftwf_execute(forward);
+    long long const shift = (static_cast<long long>(dials[c]) - static_cast<long long>(center)) *
+                            static_cast<long long>(period_s);
+    // Positive frequencies only, doubled, so the real part is the audio; and
+    // only up to the next dial, so the channels tile the span with one noise
+    // floor instead of stacking their noise where they overlap.
+    std::size_t const top = std::min(bins.size(), static_cast<std::size_t>(opt.spacing_hz) * period_s);
+    for (std::size_t k = 1; k < top; ++k) {
+      long long const to = ((shift + static_cast<long long>(k)) % static_cast<long long>(wide) +
+                            static_cast<long long>(wide)) % static_cast<long long>(wide);
+      spectrum[static_cast<std::size_t>(to)] += 2.0f * bins[k] / static_cast<float>(n);
+    }
+  }
+  fftwf_execute(inverse);
+  fftwf_destroy_plan(forward);
+  fftwf_destroy_plan(inverse);
+
+  float const floor = static_cast<float>(opt.floor_rms / 32768.0 / std::sqrt(2.0));
+  for (auto& z : spectrum) {
+    z += std::complex<float>(floor * static_cast<float>(rng.normal()), floor * static_cast<float>(rng.normal()));
+  }
+  return spectrum;
+}
+
+struct Tally {
+  std::mutex mutex;
+  std::set<std::string> decoded;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!parse(argc, argv, opt)) {
+    usage();
+    return 2;
+  }
+
+  std::vector<FrequencyHz> dials;
+  for (int c = 0; c < opt.channels; ++c) {
+    dials.push_back(kFirstDial + static_cast<FrequencyHz>(c) * static_cast<FrequencyHz>(opt.spacing_hz));
+  }
+  // Centred on the middle of the occupied span, off any dial.
+  FrequencyHz const center = kFirstDial + (static_cast<FrequencyHz>(opt.channels - 1) * opt.spacing_hz) / 2 +
+                             kRate / 4 + 7;
+
+  // Synthesised up front: the decode threads plan FFTs too, and FFTW's
+  // planner is not thread-safe.
+  std::vector<std::vector<std::set<std::string>>> sent(static_cast<std::size_t>(opt.channels));
+  std::vector<std::vector<std::complex<float>>> periods;
+  for (int p = 0; p < opt.periods; ++p) {
+    std::vector<std::vector<std::int16_t>> audio;
+    for (int c = 0; c < opt.channels; ++c) {
+      tools::ChannelRng rng(opt.seed + static_cast<unsigned>(p * opt.channels + c));
+      auto const signals = tools::make_signals(opt.channel, rng);
+      audio.push_back(tools::render_period(opt.channel, signals, rng));
+      std::set<std::string> frames;
+      for (auto const& s : signals) frames.insert(s.frame);
+      sent[static_cast<std::size_t>(c)].push_back(std::move(frames));
+    }
+    tools::ChannelRng rng(opt.seed + 0x10000u + static_cast<unsigned>(p));
+    periods.push_back(render_iq(opt, audio, dials, center, rng));
+  }
+
+  // Declared before the host so they outlive its receivers' callbacks.
+  SimulatedClock clock;
+  std::condition_variable idle_cv;
+  std::vector<Tally> tallies(static_cast<std::size_t>(opt.channels));
+  ReceiverHost host(opt.host);
+  WidebandReceiver wideband(host);
+
+  WidebandConfig config;
+  config.sample_rate_hz = opt.iq_rate;
+  config.center_hz = center;
+  config.sample_type = SampleType::Float32;
+  config.dials = dials;
+  config.receiver.submodes = 1 << static_cast<int>(opt.channel.submode);
+
+  EngineDependencies deps;
+  deps.clock = &clock;
+  deps.scheduler = &clock;
+  std::string error;
+  bool const ok = wideband.configure(
+      config,
+      [&](FrequencyHz dial) {
+        auto const c = static_cast<std::size_t>(std::find(dials.begin(), dials.end(), dial) - dials.begin());
+        EngineCallbacks callbacks;
+        callbacks.on_event = [&tally = tallies[c], &idle_cv](events::Variant const& ev) {
+          std::lock_guard<std::mutex> lock(tally.mutex);
+          if (auto const* d = std::get_if<events::Decoded>(&ev)) {
+            tally.decoded.insert(d->data);
+          } else if (std::holds_alternative<events::DecodeFinished>(ev)) {
+            idle_cv.notify_all();
+          }
+        };
+        return callbacks;
+      },
+      deps, &error);
+  if (!ok) {
+    std::fprintf(stderr, "configure: %s\n", error.c_str());
+    return 1;
+  }
+
+  // Every receiver's decodes are done once it has completed what it dequeued.
+  auto wait_idle = [&] {
+    for (int c = 0; c < opt.channels; ++c) {
+      auto& tally = tallies[static_cast<std::size_t>(c)];
+      auto* engine = wideband.receiver(static_cast<std::size_t>(c));
+      std::unique_lock<std::mutex> lock(tally.mutex);
+      for (;;) {
+        auto const stats = engine->queue_stats().decode;
+        if (stats.depth == 0 && stats.completed == stats.processed) break;
+        idle_cv.wait_for(lock, std::chrono::milliseconds(20));
+      }
+    }
+  };
+
+  // 100 ms blocks. A period's last samples leave the filter bank a block
+  // later, so each period is waited out a few blocks into the next one, and
+  // the stream ends with that much silence.
+  std::size_t const block = static_cast<std::size_t>(opt.iq_rate) / 10;
+  std::size_t const settle = 3 * block;
+  std::vector<std::complex<float>> stream;
+  for (auto const& period : periods) stream.insert(stream.end(), period.begin(), period.end());
+  stream.resize(stream.size() + settle);
+
+  std::chrono::steady_clock::duration front_end{};
+  std::size_t next_wait = periods[0].size() + settle;
+  for (std::size_t pos = 0; pos < stream.size(); pos += block) {
+    std::size_t const n = std::min(block, stream.size() - pos);
+    AudioInputBuffer buffer;
+    buffer.format.sample_rate = opt.iq_rate;
+    buffer.format.channels = 2;
+    buffer.format.sample_type = SampleType::Float32;
+    buffer.data = std::as_bytes(std::span<const std::complex<float>>(stream.data() + pos, n));
+    buffer.captured_at = clock.steady_now();
+    auto const t0 = std::chrono::steady_clock::now();
+    wideband.submit_iq(buffer);
+    front_end += std::chrono::steady_clock::now() - t0;
+    clock.advance(std::chrono::microseconds(n * 1000000 / static_cast<std::size_t>(opt.iq_rate)));
+    if (pos + n >= next_wait) {
+      wait_idle();
+      next_wait += periods[0].size();
+    }
+  }
+
+  std::printf("%-10s %9s %6s %6s\n", "dial", "decoded", "image", "false");
+  int total_hits = 0;
+  int total_sent = 0;
+  int total_bad = 0;
+  for (int c = 0; c < opt.channels; ++c) {
+    auto& tally = tallies[static_cast<std::size_t>(c)];
+    std::lock_guard<std::mutex> lock(tally.mutex);
+    std::set<std::string> own;
+    std::set<std::string> lower;
+    for (auto const& frames : sent[static_cast<std::size_t>(c)]) own.insert(frames.begin(), frames.end());
+    if (c > 0) {
+      for (auto const& frames : sent[static_cast<std::size_t>(c - 1)]) lower.insert(frames.begin(), frames.end());
+    }
+    int hits = 0;
+    int images = 0;
+    int false_decodes = 0;
+    for (auto const& frame : tally.decoded) {
+      if (own.count(frame)) ++hits;
+      else if (lower.count(frame)) ++images;
+      else ++false_decodes;
+    }
+    std::printf("%-10llu %4d/%-4d %6d %6d\n", static_cast<unsigned long long>(dials[static_cast<std::size_t>(c)]),
+                hits, static_cast<int>(own.size()), images, false_decodes);
+    total_hits += hits;
+    total_sent += static_cast<int>(own.size());
+    total_bad += images + false_decodes;
+  }
+
+  double const iq_s = static_cast<double>(stream.size()) / opt.iq_rate;
+  double const cpu = std::chrono::duration<double>(front_end).count();
+  std::printf("---\n%d channels from %d Hz IQ: decoded %d/%d, %d image or false\n", opt.channels, opt.iq_rate,
+              total_hits, total_sent, total_bad);
+  std::printf("channelizer and capture %.3f s CPU for %.1f s of IQ (%.1f%% of a core)\n", cpu, iq_s,
+              100.0 * cpu / iq_s);
+  return 0;
+}
@@ -0,0 +1,206 @@
+// Runs several simulated receivers through one ReceiverHost and reports each
+// receiver's decodes and decode latency, plus what the shared pool cost.
+// Every receiver hears its own channel (independent signals and noise); all
+// of them share one simulated clock, so their decode windows close together
+// and contend for the pool as SDR slices on one machine would.
+//
+//   js8core-receiver-bench --receivers 4 --threads 2 --signals 10
+//   js8core-receiver-bench --receivers 6 --cpu-budget 1.5 --periods 4
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "channel_model.hpp"
+#include "js8core/engine.hpp"
+#include "js8core/protocol/submode.hpp"
+#include "js8core/receiver_host.hpp"
+
+namespace {
+
+using namespace js8core;
+
+constexpr int kRate = tools::kChannelRate;
+
+struct Options {
+  tools::ChannelParams channel;
+  int receivers = 4;
+  int periods = 2;
+  unsigned seed = 1;
+  ReceiverHostConfig host;
+};
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: js8core-receiver-bench [options]\n"
+               "  --receivers N         receivers in the host (4)\n"
+               "  --threads N           decode threads, 0 = cores - 1 (0)\n"
+               "  --cpu-budget CORES    decode CPU budget, 0 = unlimited (0)\n"
+               "  --submode A|B|C|E|I   submode every receiver decodes (A)\n"
+               "  --signals N           signals per receiver per period (10)\n"
+               "  --snr DB              per-signal SNR in 2500 Hz (-10)\n"
+               "  --periods N           periods to run (2)\n"
+               "  --seed N              random seed (1)\n");
+}
+
+bool parse(int argc, char** argv, Options& opt) {
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg = argv[i];
+    char const* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) return false;
+    ++i;
+    if (arg == "--receivers") {
+      opt.receivers = std::atoi(value);
+    } else if (arg == "--threads") {
+      opt.host.decode_threads = std::atoi(value);
+    } else if (arg == "--cpu-budget") {
+      opt.host.cpu_budget = std::atof(value);
+    } else if (arg == "--submode") {
+      auto const sm = protocol::find(std::string_view(value));
+      if (!sm) return false;
+      opt.channel.submode = sm->id;
+    } else if (arg == "--signals") {
+      opt.channel.signals = std::atoi(value);
+    } else if (arg == "--snr") {
+      opt.channel.snr_db = std::atof(value);
+    } else if (arg == "--periods") {
+      opt.periods = std::atoi(value);
+    } else if (arg == "--seed") {
+      opt.seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else {
+      return false;
+    }
+  }
+  return opt.receivers > 0 && opt.periods > 0 && opt.channel.signals > 0;
+}
+
+struct Tally {
+  std::mutex mutex;
+  std::set<std::string> decoded;  // frames of the current period
+  int sent = 0;
+  int hits = 0;
+  int false_decodes = 0;
+};
+
+double ms(std::chrono::microseconds us) { return us.count() / 1000.0; }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!parse(argc, argv, opt)) {
+    usage();
+    return 2;
+  }
+
+  // Declared before the host so they outlive its receivers' callbacks.
+  SimulatedClock clock;
+  std::condition_variable idle_cv;
+  std::vector<Tally> tallies(static_cast<std::size_t>(opt.receivers));
+  std::vector<int> ids;
+  ReceiverHost host(opt.host);
+
+  for (int r = 0; r < opt.receivers; ++r) {
+    auto& tally = tallies[static_cast<std::size_t>(r)];
+    EngineConfig config;
+    config.sample_rate_hz = kRate;
+    config.submodes = 1 << static_cast<int>(opt.channel.submode);
+
+    EngineCallbacks callbacks;
+    callbacks.on_event = [&tally, &idle_cv](events::Variant const& ev) {
+      std::lock_guard<std::mutex> lock(tally.mutex);
+      if (auto const* d = std::get_if<events::Decoded>(&ev)) {
+        tally.decoded.insert(d->data);
+      } else if (std::holds_alternative<events::DecodeFinished>(ev)) {
+        idle_cv.notify_all();
+      }
+    };
+
+    EngineDependencies deps;
+    deps.clock = &clock;
+    deps.scheduler = &clock;
+    int const id = host.add_receiver("rx" + std::to_string(r + 1), config, std::move(callbacks), deps);
+    host.receiver(id)->set_dial_frequency(7078000 + static_cast<FrequencyHz>(r) * 3000);
+    ids.push_back(id);
+  }
+
+  auto const started = std::chrono::steady_clock::now();
+  for (int p = 0; p < opt.periods; ++p) {
+    std::vector<std::vector<tools::ChannelSignal>> signals;
+    std::vector<std::vector<std::int16_t>> audio;
+    for (int r = 0; r < opt.receivers; ++r) {
+      tools::ChannelRng rng(opt.seed + static_cast<unsigned>(p * opt.receivers + r));
+      signals.push_back(tools::make_signals(opt.channel, rng));
+      audio.push_back(tools::render_period(opt.channel, signals.back(), rng));
+    }
+
+    // Interleave 100 ms blocks across receivers, as parallel capture
+    // threads would deliver them.
+    std::size_t const block = kRate / 10;
+    for (std::size_t pos = 0; pos < audio[0].size(); pos += block) {
+      std::size_t const n = std::min(block, audio[0].size() - pos);
+      for (int r = 0; r < opt.receivers; ++r) {
+        AudioInputBuffer buffer;
+        buffer.format.sample_rate = kRate;
+        buffer.format.channels = 1;
+        buffer.format.sample_type = SampleType::Int16;
+        buffer.data = std::as_bytes(std::span<const std::int16_t>(audio[r].data() + pos, n));
+        buffer.captured_at = clock.steady_now();
+        host.receiver(ids[r])->submit_capture(buffer);
+      }
+      clock.advance(std::chrono::microseconds(n * 1000000 / kRate));
+    }
+
+    // Wait until every receiver has completed what it dequeued.
+    for (int r = 0; r < opt.receivers; ++r) {
+      auto& tally = tallies[static_cast<std::size_t>(r)];
+      std::unique_lock<std::mutex> lock(tally.mutex);
+      for (;;) {
+        auto const stats = host.receiver(ids[r])->queue_stats().decode;
+        if (stats.depth == 0 && stats.completed == stats.processed) break;
+        idle_cv.wait_for(lock, std::chrono::milliseconds(20));
+      }
+      std::set<std::string> expected;
+      for (auto const& s : signals[r]) expected.insert(s.frame);
+      tally.sent += static_cast<int>(expected.size());
+      for (auto const& frame : tally.decoded) {
+        if (expected.count(frame)) ++tally.hits;
+        else ++tally.false_decodes;
+      }
+      tally.decoded.clear();
+    }
+  }
+  double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  std::printf("%-6s %10s %9s %6s %6s %7s %7s %9s %9s\n",
+              "rx", "dial", "decoded", "false", "jobs", "merged", "dropped", "mean ms", "max ms");
+  auto const stats = host.stats();
+  for (std::size_t r = 0; r < stats.size(); ++r) {
+    auto const& s = stats[r];
+    auto const& tally = tallies[r];
+    std::printf("%-6s %10llu %4d/%-4d %6d %6llu %7llu %7llu %9.1f %9.1f\n",
+                s.name.c_str(), static_cast<unsigned long long>(s.dial_hz), tally.hits, tally.sent,
+                tally.false_decodes, static_cast<unsigned long long>(s.decode.completed),
+                static_cast<unsigned long long>(s.decode.merged),
+                static_cast<unsigned long long>(s.decode.dropped),
+                s.decode.completed ? ms(s.decode.total_latency) / s.decode.completed : 0.0,
+                ms(s.decode.max_latency));
+  }
+
+  auto const pool = host.decode_pool_stats();
+  double const audio_s = static_cast<double>(opt.periods) * protocol::find(opt.channel.submode)->tx_seconds;
+  std::printf("---\n%d receivers on %d decode threads (%d decoders built), %llu jobs\n",
+              opt.receivers, pool.threads, pool.decoders, static_cast<unsigned long long>(pool.jobs));
+  std::printf("decode CPU %.2f s (%.2f cores over %.0f s of audio), throttled %.2f s, wall %.2f s\n",
+              std::chrono::duration<double>(pool.cpu).count(),
+              std::chrono::duration<double>(pool.cpu).count() / audio_s, audio_s,
+              std::chrono::duration<double>(pool.throttled).count(), elapsed);
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "js8core/dsp/resampler.hpp"
+
+// Measures throughput and tone response of the capture resampler for the
+// device rates we see in practice, converting to the 12 kHz decoder rate.
+
+namespace {
+
+constexpr int kOutputRate = 12000;
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<std::int16_t> make_tone(int rate, double freq, double seconds, double amplitude) {
+  std::vector<std::int16_t> out(static_cast<std::size_t>(rate * seconds));
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = static_cast<std::int16_t>(amplitude * std::sin(2.0 * kPi * freq * i / rate));
+  }
+  return out;
+}
+
+double rms_db(std::vector<std::int16_t> const& in, std::size_t count, std::size_t skip, double ref) {
+  double sum = 0.0;
+  std::size_t n = 0;
+  for (std::size_t i = skip; i < count; ++i, ++n) {
+    sum += static_cast<double>(in[i]) * static_cast<double>(in[i]);
+  }
+  if (n == 0 || sum == 0.0) return -200.0;
+  return 20.0 * std::log10(std::sqrt(sum / static_cast<double>(n)) / ref);
+}
+
+// Push `input` through a fresh resampler in 480-frame blocks like a capture
+// callback would, returning the number of output samples produced.
+std::size_t run(int rate, std::vector<std::int16_t> const& input, std::vector<std::int16_t>& output) {
+  js8core::dsp::RationalResampler rs;
+  rs.configure(rate, kOutputRate);
+  output.assign(rs.max_output(input.size()) + 16, 0);
+  std::size_t const block = 480;
+  std::size_t produced = 0;
+  for (std::size_t pos = 0; pos < input.size(); pos += block) {
+    std::size_t n = std::min(block, input.size() - pos);
+    produced += rs.process(
+        std::span<const std::int16_t>(input.data() + pos, n),
+        std::span<std::int16_t>(output.data() + produced, output.size() - produced));
+  }
+  return produced;
+}
+
+}  // namespace
+
+int main() {
+  int const rates[] = {8000, 16000, 22050, 44100, 48000, 96000};
+  double const amplitude = 10000.0;
+  double const ref = amplitude / std::sqrt(2.0);
+  bool ok = true;
+
+  std::printf("%8s %6s %10s %10s %10s %12s\n",
+              "rate", "taps", "1500Hz dB", "alias dB", "ratio", "x realtime");
+
+  for (int rate : rates) {
+    js8core::dsp::RationalResampler probe;
+    probe.configure(rate, kOutputRate);
+
+    std::vector<std::int16_t> out;
+    auto pass = make_tone(rate, 1500.0, 5.0, amplitude);
+    std::size_t produced = run(rate, pass, out);
+    double pass_db = rms_db(out, produced, 1000, ref);
+    double ratio = static_cast<double>(produced) / (5.0 * kOutputRate);
+
+    // A tone above the output Nyquist must not fold back into the passband.
+    double alias_db = -200.0;
+    if (rate > kOutputRate) {
+      double alias_freq = std::min(0.5 * rate - 500.0, kOutputRate - 1500.0);
+      auto stop = make_tone(rate, alias_freq, 5.0, amplitude);
+      std::size_t n = run(rate, stop, out);
+      alias_db = rms_db(out, n, 1000, ref);
+    }
+
+    auto long_input = make_tone(rate, 1000.0, 60.0, amplitude);
+    auto start = std::chrono::steady_clock::now();
+    run(rate, long_input, out);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%8d %6d %10.2f %10.1f %10.4f %12.0f\n",
+                rate, probe.taps_per_phase(), pass_db, alias_db, ratio, 60.0 / elapsed);
+
+    if (std::fabs(pass_db) > 0.5 || alias_db > -50.0 || std::fabs(ratio - 1.0) > 0.01) ok = false;
+  }
+
+  std::printf("%s\n", ok ? "ok" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+// Minimal 16-bit PCM WAV reader/writer shared by the js8core tools.
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace js8core::tools {
+
+struct WavData {
+  int sample_rate = 0;
+  int channels = 0;
+  std::vector<std::int16_t> samples;  // first channel only
+};
+
+inline bool read_wav(std::string const& path, WavData& out) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+
+  char riff[12];
+  if (!in.read(riff, sizeof(riff)) || std::memcmp(riff, "RIFF", 4) != 0 ||
+      std::memcmp(riff + 8, "WAVE", 4) != 0) {
+    return false;
+  }
+
+  int bits = 0;
+  for (;;) {
+    char id[4];
+    std::uint32_t size = 0;
+    if (!in.read(id, 4) || !in.read(reinterpret_cast<char*>(&size), 4)) return false;
+
+    if (std::memcmp(id, "fmt ", 4) == 0) {
+      std::vector<char> fmt(size);
+      if (size < 16 || !in.read(fmt.data(), size)) return false;
+      std::uint16_t format = 0, channels = 0, bits_per_sample = 0;
+      std::uint32_t rate = 0;
+      std::memcpy(&format, fmt.data(), 2);
+      std::memcpy(&channels, fmt.data() + 2, 2);
+      std::memcpy(&rate, fmt.data() + 4, 4);
+      std::memcpy(&bits_per_sample, fmt.data() + 14, 2);
+      if (format != 1 || channels == 0) return false;  // PCM only
+      out.sample_rate = static_cast<int>(rate);
+      out.channels = channels;
+      bits = bits_per_sample;
+    } else if (std::memcmp(id, "data", 4) == 0) {
+      if (bits != 16 || out.channels == 0) return false;
+      std::vector<std::int16_t> interleaved(size / 2);
+      in.read(reinterpret_cast<char*>(interleaved.data()),
+              static_cast<std::streamsize>(interleaved.size() * 2));
+      interleaved.resize(static_cast<std::size_t>(in.gcount()) / 2);
+      out.samples.resize(interleaved.size() / static_cast<std::size_t>(out.channels));
+      for (std::size_t i = 0; i < out.samples.size(); ++i) {
+        out.samples[i] = interleaved[i * static_cast<std::size_t>(out.channels)];
+      }
+      return true;
+    } else {
+      in.seekg(size + (size & 1), std::ios::cur);
+    }
+  }
+}
+
+inline bool write_wav(std::string const& path, std::vector<std::int16_t> const& samples,
+                      int sample_rate) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) return false;
+
+  auto put16 = [&out](std::uint16_t v) { out.write(reinterpret_cast<char const*>(&v), 2); };
+  auto put32 = [&out](std::uint32_t v) { out.write(reinterpret_cast<char const*>(&v), 4); };
+
+  auto const data_bytes = static_cast<std::uint32_t>(samples.size() * 2);
+  out.write("RIFF", 4);
+  put32(36 + data_bytes);
+  out.write("WAVEfmt ", 8);
+  put32(16);
+  put16(1);  // PCM
+  put16(1);  // mono
+  put32(static_cast<std::uint32_t>(sample_rate));
+  put32(static_cast<std::uint32_t>(sample_rate) * 2);
+  put16(2);
+  put16(16);
+  out.write("data", 4);
+  put32(data_bytes);
+  out.write(reinterpret_cast<char const*>(samples.data()), data_bytes);
+  return static_cast<bool>(out);
+}
+
+}  // namespace js8core::tools
@@ -8,8 +8,10 @@
 #include <functional>
 #include <mutex>
 #include <iterator>
+#include <optional>
 #include <stdexcept>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <boost/crc.hpp>
 #include <fftw3.h>
@@ -115,6 +117,11 @@ namespace
     constexpr auto TX = 2;
   }
 
+  // Blocks of RX text trimmed from the top of the window, or paged back
+  // into it, at a time.
+
+  constexpr auto RX_TEXT_PAGE = 100;
+
   int ms_minute_error ()
   {
     auto const now    = DriftingDateTime::currentDateTimeLocal();
@@ -136,6 +143,33 @@ namespace
       else                            return QString("now");
   }
 
+  // When what since() has to say about the time will next change.
+
+  QDateTime
+  sinceChanges(QDateTime const & time)
+  {
+      if (!time.isValid()) return {};
+
+      auto const delta = std::max(time.secsTo(DriftingDateTime::currentDateTimeUtc()), qint64{0});
+      auto const step  = delta >= 60 * 60 * 24 ? 60 * 60 * 24
+                       : delta >= 60 * 60      ? 60 * 60
+                       : delta >= 60           ? 60
+                       :                         15;
+
+      return time.addSecs((delta / step + 1) * step);
+  }
+
+  // Words of a set, in order, as a string; sets that are equal give the
+  // same string, regardless of the order in which they hold them.
+
+  QString
+  joinWords(QSet<QString> const & words)
+  {
+      auto list = words.values();
+      list.sort();
+      return list.join(' ');
+  }
+
   namespace State
   {
     constexpr QStringView Ready   = u"Ready";
@@ -229,84 +263,6 @@ namespace
                   array,
                   size) = '\0';
   }
-
-  // Emulation of the Fortran 'flat1' subroutine.
-
-  void
-  flat1(float const * const savg,
-        int           const iz,
-        int           const nsmo,
-        float       * const slin)
-  {
-    constexpr int x_size = 8192;
-    constexpr int nstep  = 20;
-    constexpr int nh     = nstep / 2;
-
-    // Define bounds for smoothing
-    int const ia =      nsmo / 2 + 1;
-    int const ib = iz - nsmo / 2 - 1;
-
-    std::vector<float> x(x_size, 0.0f);
-
-    // Smooth savg using median percentiles
-
-    auto const rank = std::clamp(static_cast<int>(std::round(0.5f * nsmo)), 0, nsmo - 1);
-
-    for (int i = ia; i <= ib; i += nstep)
-    {
-      auto const data = &savg[i - nsmo / 2];
-      auto       temp = std::vector<float>(data, data + nsmo);
-
-      std::nth_element(temp.begin(),
-                       temp.begin() + rank,
-                       temp.end());
-
-      x[i] = temp[rank];
-
-      std::fill(x.begin() + (i - nh),
-                x.begin() + (i + nh), x[i]);
-    }
-
-    // Extend smoothed values to boundaries
-    std::fill(x.begin(),          x.begin() + ia, x[ia]);
-    std::fill(x.begin() + ib + 1, x.begin() + iz, x[ib]);
-
-    // Compute scaling factor
-    float x0 = 0.001f * *std::max_element(x.begin() +      iz  / 10,
-                                          x.begin() + (9 * iz) / 10);
-
-    // Normalize savg to compute slin
-    for (int i = 0; i < iz; ++i) slin[i] = savg[i] / (x[i] + x0);
-  }
-
-  // Emulation of the Fortran 'smo' subroutine. However, doesn't copy the data
-  // back from b to a; rather, a is input and, b is output. Since we invariably
-  // call this twice, we can just swap the order of the arrays to achieve the
-  // same result without the extra two copy operations.
-
-  void
-  smo(float const * const a,
-      float       * const b,
-      int           const npts,
-      int           const nadd)
-  {
-    auto const nh = nadd / 2;
-
-    // Smooth the array
-    for (int i = nh; i < npts - nh; ++i)
-    {
-      float sum = 0.0f;
-      for (int j = -nh; j <= nh; ++j)
-      {
-        sum += a[i + j];
-      }
-      b[i] = sum;
-    }
-
-    // Set edges to zero
-    for (int i = 0;         i < nh;   ++i) b[i] = 0.0f; // Zero out leading edge
-    for (int i = npts - nh; i < npts; ++i) b[i] = 0.0f; // Zero out trailing edge
-  }
 }
 
 //--------------------------------------------------- MainWindow constructor
@@ -343,6 +299,9 @@ MainWindow::MainWindow(QString  const & program_info,
   m_cq_loop {new TxLoop {"CQ calls"}},
   m_hb_loop {new TxLoop {"HB calls"}},
   m_decoder {this},
+  m_spectrum {this},
+  m_allTxt {this},
+  m_directedTxt {this},
   m_secBandChanged {0},
   m_freqNominal {0},
   m_freqTxNominal {0},
@@ -387,6 +346,7 @@ MainWindow::MainWindow(QString  const & program_info,
   m_audioThreadPriority (QThread::HighPriority),
   m_notificationAudioThreadPriority (QThread::LowPriority),
   m_decoderThreadPriority (QThread::HighPriority),
+  m_spectrumThreadPriority (QThread::NormalPriority),
   m_splitMode {false},
   m_monitoring {false},
   m_generateAudioWhenPttConfirmedByTX {false},
@@ -527,6 +487,15 @@ MainWindow::MainWindow(QString  const & program_info,
   //connect (&m_decodeThread, &QThread::finished, m_notification, &QObject::deleteLater);
   //connect(this, &MainWindow::decodedLineReady, this, &MainWindow::processDecodedLine);
   connect(&m_decoder, &JS8::Decoder::decodeEvent, this, &MainWindow::processDecodeEvent);
+  connect(&m_spectrum, &Spectrum::frameReady, this, &MainWindow::spectrumSink);
+
+  for (auto writer : {&m_allTxt, &m_directedTxt})
+  {
+    connect(writer, &LogWriter::error, this, [this](QString const & message)
+    {
+      JS8MessageBox::warning_message(this, tr("Log File Error"), message);
+    });
+  }
 
    m_dateTimeQSOOn = QDateTime{};
 
@@ -719,6 +688,13 @@ MainWindow::MainWindow(QString  const & program_info,
   m_audioThread.start (m_audioThreadPriority);
   m_notificationAudioThread.start(m_notificationAudioThreadPriority);
   m_decoder.start(m_decoderThreadPriority);
+  m_spectrum.start(m_spectrumThreadPriority);
+
+  auto logOptions = m_logOptions;
+  logOptions.path = m_config.writeable_data_dir().absoluteFilePath("ALL.TXT");
+  m_allTxt.start(logOptions, QThread::LowPriority);
+  logOptions.path = m_config.writeable_data_dir().absoluteFilePath("DIRECTED.TXT");
+  m_directedTxt.start(logOptions, QThread::LowPriority);
 
   Q_EMIT startAudioInputStream (m_config.audio_input_device (), m_framesAudioInputBuffered, m_detector, m_config.audio_input_channel ());
   Q_EMIT initializeAudioOutputStream (m_config.audio_output_device (), AudioDevice::Mono == m_config.audio_output_channel () ? 1 : 2, m_msAudioOutputBuffered);
@@ -869,7 +845,11 @@ MainWindow::MainWindow(QString  const & program_info,
         return;
     }
 
-    auto text = ui->textEditRX->toPlainText();
+    QString text;
+    for (auto const & page : m_rxTextPages) {
+        text += QTextDocumentFragment::fromHtml(page).toPlainText();
+    }
+    text += ui->textEditRX->toPlainText();
     QFile f(filename);
     if (f.open(QIODevice::Truncate | QIODevice::WriteOnly | QIODevice::Text)) {
         QTextStream stream(&f);
@@ -877,6 +857,14 @@ MainWindow::MainWindow(QString  const & program_info,
     }
   });
 
+  // page older rx text back into the window when scrolled to the top of it
+  connect(ui->textEditRX->verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int const value){
+      auto const scrollBar = ui->textEditRX->verticalScrollBar();
+      if(value == scrollBar->minimum() && scrollBar->maximum() > scrollBar->minimum()){
+          pageRXActivity();
+      }
+  });
+
   ui->textEditRX->setContextMenuPolicy(Qt::CustomContextMenu);
   connect(ui->textEditRX, &QTableWidget::customContextMenuRequested, this, [this, clearAction1, clearActionAll, saveAction](QPoint const &point){
       QMenu * menu = new QMenu(ui->textEditRX);
@@ -1111,7 +1099,7 @@ MainWindow::MainWindow(QString  const & program_info,
           if(Varicode::isValidCallsign(callsign, nullptr)){
               CallDetail cd = {};
               cd.call = callsign;
-              m_callActivity[callsign] = cd;
+              m_callActivity.set(callsign, cd);
           } else {
               JS8MessageBox::critical_message (this, QString("%1 is not a valid callsign or group").arg(callsign));
           }
@@ -1258,7 +1246,7 @@ MainWindow::MainWindow(QString  const & program_info,
     bool missingCallsign = selectedCall.isEmpty();
 
     if(!missingCallsign && !isAllCall){
-        int selectedOffset = m_callActivity[selectedCall].offset;
+        int selectedOffset = m_callActivity.value(selectedCall).offset;
         if(selectedOffset != -1){
             auto qsyAction = menu->addAction(QString("Jump to %1Hz").arg(selectedOffset));
             connect(qsyAction, &QAction::triggered, this, [this, selectedOffset](){
@@ -1272,7 +1260,7 @@ MainWindow::MainWindow(QString  const & program_info,
                 });
             }
 
-            int submode = m_callActivity[selectedCall].submode;
+            int submode = m_callActivity.value(selectedCall).submode;
             auto speed  = JS8::Submode::name(submode);
             if(submode != m_nSubMode){
                 auto qrqAction = menu->addAction(QString("Jump to %1%2 speed").arg(speed.left(1)).arg(speed.mid(1).toLower()));
@@ -1281,7 +1269,7 @@ MainWindow::MainWindow(QString  const & program_info,
                 });
             }
 
-            int tdrift = -int(m_callActivity[selectedCall].tdrift * 1000);
+            int tdrift = -int(m_callActivity.value(selectedCall).tdrift * 1000);
             auto qtrAction = menu->addAction(QString("Jump to %1 ms time drift").arg(tdrift));
             connect(qtrAction, &QAction::triggered, this, [this, tdrift](){
                 setDrift(tdrift);
@@ -1717,7 +1705,7 @@ void MainWindow::initializeDummyData(){
         ad.text = QString("%1: %2 TEST MESSAGE").arg(call).arg(m_config.my_callsign());
         ad.utcTimestamp = dt;
         ad.submode = cd.submode;
-        m_bandActivity[500+100*i] = { ad };
+        m_bandActivity.set(500+100*i, { ad });
 
         markOffsetDirected(500+100*i, false);
 
@@ -1732,7 +1720,7 @@ void MainWindow::initializeDummyData(){
     adHB1.text = QString("KN4CRD: HB AUTO EM73");
     adHB1.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
     adHB1.submode = Varicode::JS8CallNormal;
-    m_bandActivity[750].append(adHB1);
+    m_bandActivity.update(750, [&](auto & activity){ activity.append(adHB1); });
 
     ActivityDetail adHB2 = {};
     adHB2.bits = Varicode::JS8CallLast;
@@ -1742,7 +1730,7 @@ void MainWindow::initializeDummyData(){
     adHB2.text = QString(" MSG ID 1");
     adHB2.utcTimestamp = DriftingDateTime::currentDateTimeUtc();
     adHB2.submode = Varicode::JS8CallNormal;
-    m_bandActivity[750].append(adHB2);
+    m_bandActivity.update(750, [&](auto & activity){ activity.append(adHB2); });
 
     CommandDetail cmd = {};
     cmd.cmd = ">";
@@ -2094,6 +2082,9 @@ MainWindow::~MainWindow()
   m_notificationAudioThread.wait();
 
   m_decoder.quit();
+  m_spectrum.quit();
+  m_allTxt.quit();
+  m_directedTxt.quit();
 
   remove_child_from_event_filter (this);
 }
@@ -2270,6 +2261,21 @@ void MainWindow::readSettings()
   m_notificationAudioThreadPriority = static_cast<QThread::Priority> (m_settings->value ("Audio/NotificationThreadPriority", QThread::LowPriority).toInt () % 8);
   m_decoderThreadPriority = static_cast<QThread::Priority> (m_settings->value ("Audio/DecoderThreadPriority", QThread::HighPriority).toInt () % 8);
   m_networkThreadPriority = static_cast<QThread::Priority> (m_settings->value ("Network/NetworkThreadPriority", QThread::LowPriority).toInt () % 8);
+
+  // and these to rotate the ALL.TXT and DIRECTED.TXT logs; by default, never
+  m_logOptions.maxBytes = m_settings->value ("Log/RotateMegabytes", 0).toLongLong () * 1024 * 1024;
+  m_logOptions.daily = m_settings->value ("Log/RotateDaily", false).toBool ();
+  m_logOptions.keep = m_settings->value ("Log/RotateKeep", 5).toInt ();
+
+  // and these to tune how much activity is retained; zero is no limit, and
+  // by default nothing is evicted
+  m_callActivity.setLimits ({m_settings->value ("Activity/RetainCalls", 0).toLongLong (),
+                             m_settings->value ("Activity/RetainCallHours", 0).toLongLong () * 3600});
+  m_bandActivity.setLimits ({m_settings->value ("Activity/RetainOffsets", 0).toLongLong (),
+                             m_settings->value ("Activity/RetainOffsetHours", 0).toLongLong () * 3600});
+  m_bandActivityDepth = qMax (1, m_settings->value ("Activity/RetainOffsetEntries", 10).toInt ());
+  m_rxTextWindow = qMax (RX_TEXT_PAGE, m_settings->value ("Activity/RxTextBlocks", 1000).toInt ());
+  m_rxTextPagesKept = qMax (0, m_settings->value ("Activity/RxTextPages", 50).toInt ());
   m_settings->endGroup ();
 
   if(m_config.reset_activity()){
@@ -2336,15 +2342,14 @@ void MainWindow::set_application_font (QFont const& font)
 //-------------------------------------------------------------- dataSink()
 void MainWindow::dataSink(qint64 frames)
 {
-    constexpr int        NMAX  = JS8_NTMAX * 12000;
-    constexpr int        nfft3 = 16384;
-    constexpr std::array nch   = {1, 2, 4, 9, 18, 36, 72};
+    constexpr int NMAX  = JS8_NTMAX * 12000;
+    constexpr int nfft3 = Spectrum::NFFT;
 
-    // symspec global vars
-    static int       ja   = 0;
-    static int       k0   = 999999999;
-    static WF::SPlot ssum = {};
-    static WF::SPlot s    = {};
+    // symspec global vars; the spectrum worker keeps the running sum of
+    // spectra, which we ask it to reset at the start of a new average.
+    static int  ja       = 0;
+    static int  k0       = 999999999;
+    static bool resetSum = false;
 
     int k (frames);
     if(k0 == 999999999)
@@ -2366,7 +2371,7 @@ void MainWindow::dataSink(qint64 frames)
     if (cycle != lastCycle)
     {
         qCDebug(decoder_js8) << "period loop, resetting ssum";
-        ssum.fill(0.0f);
+        resetSum = true;
     }
 
     lastCycle = cycle;
@@ -2383,10 +2388,12 @@ void MainWindow::dataSink(qint64 frames)
       {
         // Start a new data block
         ja = 0;
-        ssum.fill(0.0f);
+        resetSum = true;
         m_ihsym = 0;
-        std::fill(std::begin(dec_data.d2) + k,
-                  std::end  (dec_data.d2),  0);
+        for (int i = k; i < JS8_RX_SAMPLE_SIZE; ++i)
+        {
+          dec_data.d2[js8_ring_index(i, dec_data.params.koff)] = 0;
+        }
       }
 
       float gain  = pow(10.0f, 0.1f * m_inGain);
@@ -2395,7 +2402,7 @@ void MainWindow::dataSink(qint64 frames)
 
       for (int i = k0; i < k; ++i)
       {
-        float x1 = dec_data.d2[i];
+        float x1 = dec_data.d2[js8_ring_index(i, dec_data.params.koff)];
         pxmax    = std::max(pxmax, fabs(x1));
         sq      += x1 * x1;
       }
@@ -2406,118 +2413,29 @@ void MainWindow::dataSink(qint64 frames)
       k0  = k;
       ja += jstep;
 
-      // Perform real to complex FFT; note that the Fortran code performed
-      // this operation in the four2a subroutine, which contains a cache
-      // of plans. However, since the FFTW3 library itself caches, this
-      // resulted in double caching, so as an experiment we're allowing
-      // the library to handle caching.
-      //
-      // Note that the FFTW library requires all calls but for the plan
-      // execution, i.e., fftwf_execute(), to be serialized. The library
-      // doesn't require prescriptive serialization, anything will do so
-      // long as the result is one thread at a time.
-      //
-      // Providing room for an extra complex value, i.e., a pair of floats,
-      // real and imaginary parts, allows us to use the same buffer for the
-      // FFT input and output.
-      //
-      // While the memory for the FFT can come from anywhere, if we ask the
-      // library for it, it'll guarantee that it's aligned for use of SIMD
-      // instructions, which will in turn allow it to use them.
-
-      fftwf_complex * fftw_complex;
-      float         * fftw_real;
-      fftwf_plan      fftw_plan;
-      {
-        std::lock_guard<std::mutex> lock(fftw_mutex);
-
-        fftw_complex = fftwf_alloc_complex(nfft3 / 2 + 1);
-
-        if (!fftw_complex)
-        {
-          throw std::runtime_error("Failed to allocate FFT data");
-        }
+      // Hand the block over to the spectrum worker, which owns the FFT
+      // plan and the running averages, and performs the real to complex
+      // FFT off of this thread; finished frames come back to us through
+      // spectrumSink(). We copy the window of data here, into a buffer from
+      // the worker's pool, zeroing any part of it that falls outside of the
+      // data buffer.
 
-        fftw_real = reinterpret_cast<float *>(fftw_complex);
-        fftw_plan = fftwf_plan_dft_r2c_1d(nfft3,
-                                          fftw_real,
-                                          fftw_complex,
-                                          FFTW_ESTIMATE_PATIENT);
-
-        if (!fftw_plan)
-        {
-          fftwf_free(fftw_complex);
-          throw std::runtime_error("Failed to create FFT plan");
-        }
-      }
-
-      // Copy data and apply the window, then execute the FFT.
+      auto block = m_spectrum.block();
 
       for (int i = 0; i < nfft3; ++i)
       {
-        if (int j  = ja + i - nfft3;
-                j >= 0 &&
-                j < NMAX) fftw_real[i] = 0.1f * dec_data.d2[j];
-      }
-
-      ++m_ihsym;
-
-      fftwf_execute(fftw_plan);
-
-      // Process the resulting spectrum.
-
-      m_df3 = 12000.0f / nfft3;
-
-      auto const iz  = std::min(JS8_NSMAX, static_cast<int>(5000.0f / m_df3));
-      auto const cx  = reinterpret_cast<std::complex<float>*>(fftw_complex);
-      auto const fac = std::pow(1.0f / nfft3, 2.0f);
-
-      for (int i = 0; i < iz; ++i)
-      {
-        auto const sx = fac * std::norm(cx[i]);
-        ssum[i]      += sx;
-        s[i]          = 1000.0f * gain * sx;
-      }
-
-      // We're now done with the plan and the FFT storage. Even though
-      // the plan is being 'destroyed' here, the library will cache it
-      // at its discretion. As above, the calls must be serialized.
-
-      {
-        std::lock_guard<std::mutex> lock(fftw_mutex);
-        fftwf_destroy_plan(fftw_plan);
-        fftwf_free(fftw_complex);
+        int const j   = ja + i - nfft3;
+        block.data[i] = (j >= 0 && j < NMAX) ? 0.1f * dec_data.d2[js8_ring_index(j, dec_data.params.koff)] : 0.0f;
       }
 
-      // Update average spectra.
+      block.gain      = gain;
+      block.count     = ++m_ihsym;
+      block.smoothing = nsmo;
+      block.reset     = std::exchange(resetSum, false);
 
-      for (int i = 0; i < iz; ++i) specData.savg[i] = ssum[i] / m_ihsym;
+      m_spectrum.post(std::move(block));
 
-      if (m_ihsym % 10 == 0)
-      {
-        auto const mode4 = nch[nsmo];
-        auto const nsmo  = 4 * std::min(10 * mode4, 150);
-
-        flat1(specData.savg, iz, nsmo, specData.slin);
-
-        if (mode4 >= 2)
-        {
-          std::array<float, JS8_NSMAX> tmp;
-
-          smo(specData.slin, tmp.data(),    iz, mode4);
-          smo(tmp.data(),    specData.slin, iz, mode4);
-        }
-
-        std::fill(std::begin(specData.slin), std::begin(specData.slin) + 250, 0.0f);
-
-        auto const ia    = static_cast<int>( 500.0 / m_df3);
-        auto const ib    = static_cast<int>(2700.0 / m_df3);
-        auto const smin  = *std::min_element(std::begin(specData.slin) + ia, std::begin(specData.slin) + ib);
-        auto const smax  = *std::max_element(std::begin(specData.slin),      std::begin(specData.slin) + iz);
-        auto const scale = (smax > smin) ? 50.0f / (smax - smin) : 0.0f;
-
-        for (auto & val : specData.slin) val = std::max(0.0f, scale * (val - smin));
-      }
+      m_df3 = Spectrum::BIN_WIDTH;
     }
     else if (k < 2048) m_ihsym = 0;
 
@@ -2528,11 +2446,24 @@ void MainWindow::dataSink(qint64 frames)
 
     if(ui) ui->signal_meter_widget->setValue(m_px, m_pxmax); // Update thermometer
 
-    if(m_monitoring) m_wideGraph->dataSink(s, m_df3);
-
     decode(k);
 }
 
+//---------------------------------------------------------- spectrumSink()
+void MainWindow::spectrumSink()
+{
+    // Take the newest frame the spectrum worker has finished, if any; the
+    // plotter reads the average spectra from specData, which is ours alone
+    // to write to now.
+
+    if (auto const frame = m_spectrum.take())
+    {
+        specData = frame->spec;
+
+        if(m_monitoring) m_wideGraph->dataSink(frame->s, m_df3);
+    }
+}
+
 void MainWindow::showSoundInError(const QString& errorMsg)
 {
   JS8MessageBox::critical_message (this, tr ("Error in Sound Input"), errorMsg);
@@ -4106,8 +4037,7 @@ MainWindow::processDecodeEvent(JS8::Event::Variant const & event)
 
               foreach(int prevOffset, offsets){
                   if(!m_bandActivity.contains(prevOffset)){ continue; }
-                  m_bandActivity[offset] = m_bandActivity[prevOffset];
-                  m_bandActivity.remove(prevOffset);
+                  m_bandActivity.set(offset, m_bandActivity.take(prevOffset));
                   break;
               }
           }
@@ -4142,10 +4072,12 @@ MainWindow::processDecodeEvent(JS8::Event::Variant const & event)
           }
 
           m_rxActivityQueue.append(d);
-          m_bandActivity[offset].append(d);
-          while(m_bandActivity[offset].count() > 10){
-              m_bandActivity[offset].removeFirst();
-          }
+          m_bandActivity.update(offset, [&](auto & activity){
+              activity.append(d);
+              while(activity.count() > m_bandActivityDepth){
+                  activity.removeFirst();
+              }
+          });
         }
       #endif
 
@@ -4378,7 +4310,7 @@ void MainWindow::logCallActivity(CallDetail d, bool spot){
 
     if(m_callActivity.contains(d.call)){
         // update (keep grid)
-        CallDetail old = m_callActivity[d.call];
+        CallDetail old = m_callActivity.value(d.call);
         if(d.grid.isEmpty() && !old.grid.isEmpty()){
             d.grid = old.grid;
         }
@@ -4388,10 +4320,10 @@ void MainWindow::logCallActivity(CallDetail d, bool spot){
         if(!d.cqTimestamp.isValid() && old.cqTimestamp.isValid()){
             d.cqTimestamp = old.cqTimestamp;
         }
-        m_callActivity[d.call] = d;
+        m_callActivity.set(d.call, d);
     } else {
         // create
-        m_callActivity[d.call] = d;
+        m_callActivity.set(d.call, d);
 
         // notification of old and new callsigns
         if(m_logBook.hasWorkedBefore(d.call, "")){
@@ -4410,6 +4342,13 @@ void MainWindow::logCallActivity(CallDetail d, bool spot){
 void MainWindow::logHeardGraph(QString from, QString to){
     auto my_callsign = m_config.my_callsign();
 
+    // the details of these calls, as shown in call activity, will change
+    m_callActivity.touch(my_callsign);
+    m_callActivity.touch(from);
+    if(to != "@ALLCALL"){
+        m_callActivity.touch(to);
+    }
+
     // hearing
     if(m_heardGraphOutgoing.contains(my_callsign)){
         m_heardGraphOutgoing[my_callsign].insert(from);
@@ -4705,7 +4644,7 @@ void MainWindow::prepareSending(qint64 nowMS) {
             m_currentMessageType = -1;
         }
         if(m_restart) {
-            write_transmit_entry ("ALL.TXT");
+            write_transmit_entry ();
         }
 
         auto msg_parts = m_currentMessage.split (' ', Qt::SkipEmptyParts);
@@ -4750,7 +4689,7 @@ void MainWindow::prepareSending(qint64 nowMS) {
         }
 
         if(!m_tune) {
-            write_transmit_entry ("ALL.TXT");
+            write_transmit_entry ();
         }
 
         // TODO: jsherer - perhaps an on_transmitting signal?
@@ -5013,24 +4952,50 @@ void MainWindow::TxAgain()
 }
 
 void MainWindow::cacheActivity(QString key){
-    m_callActivityBandCache[key] = m_callActivity;
-    m_bandActivityBandCache[key] = m_bandActivity;
-    m_rxTextBandCache[key] = ui->textEditRX->toHtml();
+    m_callActivityBandCache[key] = m_callActivity.map();
+    m_bandActivityBandCache[key] = m_bandActivity.map();
+
+    // Hand the rx text over to the cache as it stands, the document itself
+    // rather than a copy, and give the window a new document to fill. The
+    // document is ours while cached; the window would delete its own when
+    // given another. Until we've got a band, the text stays where it is.
+    if(!key.isEmpty()){
+        auto & text = m_rxTextBandCache[key];
+        delete text.document;
+        text.document = ui->textEditRX->document();
+        text.document->setParent(this);
+        text.pages = std::exchange(m_rxTextPages, {});
+        auto const document = new QTextDocument(ui->textEditRX);
+        document->setUndoRedoEnabled(false);
+        ui->textEditRX->setDocument(document);
+        setTextEditFont(ui->textEditRX, m_config.rx_text_font());
+    }
+
     m_heardGraphIncomingBandCache[key] = m_heardGraphIncoming;
     m_heardGraphOutgoingBandCache[key] = m_heardGraphOutgoing;
 }
 
 void MainWindow::restoreActivity(QString key){
     if(m_callActivityBandCache.contains(key)){
-        m_callActivity = m_callActivityBandCache[key];
+        m_callActivity.replace(m_callActivityBandCache[key]);
     }
 
     if(m_bandActivityBandCache.contains(key)){
-        m_bandActivity = m_bandActivityBandCache[key];
+        m_bandActivity.replace(m_bandActivityBandCache[key]);
     }
 
-    if(m_rxTextBandCache.contains(key)){
-        ui->textEditRX->setHtml(m_rxTextBandCache[key]);
+    if(auto const it = m_rxTextBandCache.find(key); it != m_rxTextBandCache.end() && it->document){
+        // The window only deletes a document it created itself; the one we
+        // gave it when caching the last band's is ours to delete.
+        QPointer<QTextDocument> const outgoing = ui->textEditRX->document();
+        ui->textEditRX->setDocument(it->document);
+        it->document->setParent(ui->textEditRX);
+        delete outgoing;
+        m_rxTextPages = std::move(it->pages);
+        m_rxTextBandCache.erase(it);
+        setTextEditFont(ui->textEditRX, m_config.rx_text_font());
+        ui->textEditRX->moveCursor(QTextCursor::End);
+        ui->textEditRX->ensureCursorVisible();
     }
 
     if(m_heardGraphIncomingBandCache.contains(key)){
@@ -5041,6 +5006,9 @@ void MainWindow::restoreActivity(QString key){
         m_heardGraphOutgoing = m_heardGraphOutgoingBandCache[key];
     }
 
+    // the call details shown depend on the heard graph
+    m_callActivityRows.clear();
+
     displayActivity(true);
 }
 
@@ -5082,6 +5050,7 @@ void MainWindow::clearRXActivity(){
     m_rxActivityQueue.clear();
 
     ui->textEditRX->clear();
+    m_rxTextPages.clear();
 
     // make sure to clear the read only and transmitting flags so there's always a "way out"
     ui->extFreeTextMsgEdit->clear();
@@ -5089,6 +5058,82 @@ void MainWindow::clearRXActivity(){
     update_dynamic_property(ui->extFreeTextMsgEdit, "transmitting", false);
 }
 
+void MainWindow::trimRXActivity(){
+    auto const document = ui->textEditRX->document();
+
+    // Trim pages of the oldest blocks from the window, keeping their html
+    // to page back in should the window be scrolled up to them. Blocks
+    // we're still appending frames to move up by as many.
+    while(document->blockCount() >= m_rxTextWindow + RX_TEXT_PAGE){
+        QTextCursor c(document);
+        c.movePosition(QTextCursor::Start);
+        c.movePosition(QTextCursor::NextBlock, QTextCursor::KeepAnchor, RX_TEXT_PAGE);
+        m_rxTextPages.append(c.selection().toHtml());
+        c.removeSelectedText();
+
+        // past the pages we keep, the oldest are gone for good; they're
+        // still in ALL.TXT
+        while(m_rxTextPagesKept && m_rxTextPages.size() > m_rxTextPagesKept){
+            m_rxTextPages.removeFirst();
+        }
+
+        for(auto it = m_rxFrameBlockNumbers.begin(); it != m_rxFrameBlockNumbers.end();){
+            if((*it -= RX_TEXT_PAGE) < 0){
+                it = m_rxFrameBlockNumbers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+// While the view is scrolled up, the window isn't trimmed, but left to run
+// on overnight, it'd grow without bound; past a few windows' worth, trim it
+// anyway, keeping the view where it was relative to the bottom.
+void MainWindow::holdRXActivity(){
+    if(ui->textEditRX->document()->blockCount() < 4 * m_rxTextWindow){
+        return;
+    }
+
+    auto const scrollBar = ui->textEditRX->verticalScrollBar();
+    auto const fromBottom = scrollBar->maximum() - scrollBar->value();
+
+    trimRXActivity();
+
+    scrollBar->setValue(scrollBar->maximum() - fromBottom);
+}
+
+bool MainWindow::isRXActivityAtBottom() const {
+    auto const scrollBar = ui->textEditRX->verticalScrollBar();
+    return scrollBar->value() == scrollBar->maximum();
+}
+
+void MainWindow::pageRXActivity(){
+    if(m_rxTextPages.isEmpty()){
+        return;
+    }
+
+    // Put the most recent page trimmed back at the top of the window, and
+    // keep the view where it was relative to the bottom.
+    auto const document = ui->textEditRX->document();
+    auto const scrollBar = ui->textEditRX->verticalScrollBar();
+    auto const fromBottom = scrollBar->maximum() - scrollBar->value();
+    auto const blocks = document->blockCount();
+
+    QTextCursor c(document);
+    c.movePosition(QTextCursor::Start);
+    c.insertBlock();
+    c.movePosition(QTextCursor::Start);
+    c.insertFragment(QTextDocumentFragment::fromHtml(m_rxTextPages.takeLast()));
+
+    auto const added = document->blockCount() - blocks;
+    for(auto it = m_rxFrameBlockNumbers.begin(); it != m_rxFrameBlockNumbers.end(); ++it){
+        *it += added;
+    }
+
+    scrollBar->setValue(scrollBar->maximum() - fromBottom);
+}
+
 void MainWindow::clearCallActivity(){
     qCDebug(mainwindow_js8) << "clear call activity";
 
@@ -5099,79 +5144,48 @@ void MainWindow::clearCallActivity(){
 
     ui->tableWidgetCalls->setRowCount(0);
 
-	bool showIconColumn = false;
-    createGroupCallsignTableRows(ui->tableWidgetCalls, "", showIconColumn);
-
     resetTimeDeltaAverage();
     displayCallActivity();
 }
 
-void MainWindow::createGroupCallsignTableRows(QTableWidget *table, QString const &selectedCall, bool &showIconColumn){
-    int count = 0;
-    auto now = DriftingDateTime::currentDateTimeUtc();
-    int callsignAging = m_config.callsign_aging();
-
+void MainWindow::createGroupCallsignTableRows(QTableWidget *table, QList<TableRows::Row> &rows, QString const &selectedCall, bool &showIconColumn, qsizetype count){
     int startCol = 1;
 
-    foreach(auto cd, m_callActivity.values()){
-        if (cd.call.trimmed().isEmpty()){
-            continue;
-        }
-        if (callsignAging && cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
-            continue;
-        }
-        count++;
-    }
-
     table->horizontalHeaderItem(startCol)->setText(count == 0 ? columnLabel("Callsigns") : QString(columnLabel("Callsigns (%1)")).arg(count));
 
     if(!m_config.avoid_allcall()){
-        table->insertRow(table->rowCount());
+        TableRows::Row row;
 
-        auto emptyItem = new QTableWidgetItem("");
-        emptyItem->setData(Qt::UserRole, QVariant("@ALLCALL"));
-        table->setItem(table->rowCount() - 1, 0, emptyItem);
+        row.font     = m_config.table_font();
+        row.selected = selectedCall == "@ALLCALL";
+        row.span     = table->columnCount();
 
-        auto item = new QTableWidgetItem(QString("@ALLCALL"));
-        item->setData(Qt::UserRole, QVariant("@ALLCALL"));
+        row.cells.append({"", {}, "@ALLCALL"});
+        row.cells.append({"@ALLCALL", {}, "@ALLCALL"});
 
-        table->setItem(table->rowCount() - 1, startCol, item);
-        table->setSpan(table->rowCount() - 1, startCol, 1, table->columnCount());
-        if(selectedCall == "@ALLCALL"){
-            table->item(table->rowCount()-1, 0)->setSelected(true);
-            table->item(table->rowCount()-1, startCol)->setSelected(true);
-        }
+        rows.append(row);
     }
 
     auto groups = m_config.my_groups().values();
     std::sort(groups.begin(), groups.end());
     foreach(auto group, groups){
-		int col = 0;
-        table->insertRow(table->rowCount());
-
-		bool hasMessage = m_rxInboxCountCache.value(group, 0) > 0;
-
-		auto iconItem = new QTableWidgetItem(hasMessage ? "\u2691" : "");
-		iconItem->setData(Qt::UserRole, QVariant(group));
-		iconItem->setToolTip(
-				hasMessage ? "Message Available" :
-				"");
-		iconItem->setTextAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-		table->setItem(table->rowCount() - 1, col++, iconItem);
-		if(hasMessage){
-			showIconColumn = true;
-		}
+        TableRows::Row row;
 
-        auto item = new QTableWidgetItem(group);
-        item->setData(Qt::UserRole, QVariant(group));
-        item->setToolTip(generateCallDetail(group));
-        table->setItem(table->rowCount() - 1, col, item);
-        table->setSpan(table->rowCount() - 1, col, 1, table->columnCount());
+        bool hasMessage = m_rxInboxCountCache.value(group, 0) > 0;
 
-        if(selectedCall == group){
-            table->item(table->rowCount()-1, 0)->setSelected(true);
-            table->item(table->rowCount()-1, col)->setSelected(true);
+        row.font     = m_config.table_font();
+        row.selected = selectedCall == group;
+        row.span     = table->columnCount();
+
+        if(hasMessage){
+            row.font.setBold(true);
+            showIconColumn = true;
         }
+
+        row.cells.append({hasMessage ? "\u2691" : "", hasMessage ? "Message Available" : "", group, Qt::AlignHCenter | Qt::AlignVCenter});
+        row.cells.append({group, generateCallDetail(group), group});
+
+        rows.append(row);
     }
 }
 
@@ -5214,6 +5228,7 @@ void MainWindow::displayTextForFreq(QString text, int freq, QDateTime date, bool
 }
 
 void MainWindow::writeNoticeTextToUI(QDateTime date, QString text){
+    auto const atBottom = isRXActivityAtBottom();
     auto c = ui->textEditRX->textCursor();
     c.movePosition(QTextCursor::End);
     if(c.block().length() > 1){
@@ -5226,11 +5241,21 @@ void MainWindow::writeNoticeTextToUI(QDateTime date, QString text){
 
     c.movePosition(QTextCursor::End);
 
-    ui->textEditRX->ensureCursorVisible();
-    ui->textEditRX->verticalScrollBar()->setValue(ui->textEditRX->verticalScrollBar()->maximum());
+    // follow the new text only if the view was following it already; if
+    // it's been scrolled up, into older text, possibly paged back in, leave
+    // both the view and the text above it be until it's back at the bottom
+    if(atBottom){
+        trimRXActivity();
+
+        ui->textEditRX->ensureCursorVisible();
+        ui->textEditRX->verticalScrollBar()->setValue(ui->textEditRX->verticalScrollBar()->maximum());
+    } else {
+        holdRXActivity();
+    }
 }
 
 int MainWindow::writeMessageTextToUI(QDateTime date, QString text, int freq, bool isTx, int block){
+    auto const atBottom = isRXActivityAtBottom();
     auto c = ui->textEditRX->textCursor();
 
     // find an existing block (that does not contain an EOT marker)
@@ -5286,8 +5311,17 @@ int MainWindow::writeMessageTextToUI(QDateTime date, QString text, int freq, boo
         highlightBlock(c.block(), m_config.rx_text_font(), m_config.color_rx_foreground(), QColor(Qt::transparent));
     }
 
-    ui->textEditRX->ensureCursorVisible();
-    ui->textEditRX->verticalScrollBar()->setValue(ui->textEditRX->verticalScrollBar()->maximum());
+    // follow the new text only if the view was following it already; if
+    // it's been scrolled up, into older text, possibly paged back in, leave
+    // both the view and the text above it be until it's back at the bottom
+    if(atBottom){
+        trimRXActivity();
+
+        ui->textEditRX->ensureCursorVisible();
+        ui->textEditRX->verticalScrollBar()->setValue(ui->textEditRX->verticalScrollBar()->maximum());
+    } else {
+        holdRXActivity();
+    }
 
     return c.blockNumber();
 }
@@ -5906,7 +5940,7 @@ void MainWindow::on_logQSOButton_clicked()                 //Log QSO button
   }
   QString grid="";
   if(m_callActivity.contains(call)){
-      grid = m_callActivity[call].grid;
+      grid = m_callActivity.value(call).grid;
   }
   QString opCall=m_opCall;
   if(opCall.isEmpty()){
@@ -5936,6 +5970,7 @@ void MainWindow::acceptQSO (QDateTime const& QSO_date_off, QString const& call,
 {
   QString date = QSO_date_on.toString("yyyyMMdd");
   m_logBook.addAsWorked (m_hisCall, m_config.bands ()->find (m_freqNominal), mode, submode, grid, date, name, comments);
+  m_callActivityRows.clear ();             // the call activity shown depends on the log
 
   // Log to JS8Call API
   if(canSendNetworkMessage()){
@@ -6047,6 +6082,7 @@ void MainWindow::acceptQSO (QDateTime const& QSO_date_off, QString const& call,
 
   // reload the logbook data
   m_logBook.init();
+  m_callActivityRows.clear();
 
   clearCallsignSelected();
 
@@ -6218,8 +6254,7 @@ void MainWindow::on_actionErase_ALL_TXT_triggered()          //Erase ALL.TXT
   int ret = JS8MessageBox::query_message (this, tr ("Confirm Erase"),
                                          tr ("Are you sure you want to erase file ALL.TXT?"));
   if(ret==JS8MessageBox::Yes) {
-    QFile f {m_config.writeable_data_dir ().absoluteFilePath ("ALL.TXT")};
-    f.remove();
+    m_allTxt.erase();
     m_RxLog=1;
   }
 }
@@ -6233,6 +6268,7 @@ void MainWindow::on_actionErase_js8call_log_adi_triggered()
     f.remove();
 
     m_logBook.init();
+    m_callActivityRows.clear();
   }
 }
 
@@ -6256,6 +6292,7 @@ void MainWindow::band_changed ()
 void MainWindow::enable_DXCC_entity (bool /*on*/)
 {
   m_logBook.init();                        // re-read the log and cty.dat files
+  m_callActivityRows.clear ();
   updateGeometry ();
 }
 
@@ -6560,7 +6597,7 @@ void MainWindow::on_snrMacroButton_clicked(){
         return;
     }
 
-    auto cd = m_callActivity[call];
+    auto cd = m_callActivity.value(call);
     if (callsignAging && cd.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
         return;
     }
@@ -6811,7 +6848,7 @@ void MainWindow::buildQueryMenu(QMenu * menu, QString call){
             return;
         }
 
-        auto d = m_callActivity[selectedCall];
+        auto d = m_callActivity.value(selectedCall);
         addMessageText(QString("%1 SNR %2").arg(selectedCall).arg(Varicode::formatSNR(d.snr)), true);
 
         if(m_config.transmit_directed()) toggleTx(true);
@@ -7214,7 +7251,7 @@ QMap<QString, QString> MainWindow::buildMacroValues(){
 
     auto selectedCall = callsignSelected();
     if(m_callActivity.contains(selectedCall)){
-        auto cd = m_callActivity[selectedCall];
+        auto cd = m_callActivity.value(selectedCall);
 
         values["<CALL>"] = selectedCall;
         values["<TDELTA>"] = QString("%1 ms").arg((int)(1000*cd.tdrift));
@@ -7403,7 +7440,7 @@ void MainWindow::on_tableWidgetRXAll_cellDoubleClicked(int row, int col){
     QDateTime firstActivity = now;
     QString activityText;
     bool isLast = false;
-    foreach(auto d, m_bandActivity[offset]){
+    foreach(auto d, m_bandActivity.value(offset)){
         if(activityAging && d.utcTimestamp.secsTo(now)/60 >= activityAging){
             continue;
         }
@@ -7675,14 +7712,14 @@ MainWindow::qsy(int const hzDelta)
     bandActivity[newKey].last().offset -= hzDelta;
   }
 
-  m_bandActivity.swap(bandActivity);
+  m_bandActivity.replace(std::move(bandActivity));
 
   // Adjust call activity frequencies.
 
-  for (auto [key, value] : m_callActivity.asKeyValueRange())
+  m_callActivity.updateAll([hzDelta](auto & detail)
   {
-    value.offset -= hzDelta;
-  }
+    detail.offset -= hzDelta;
+  });
 
   displayActivity(true);
 }
@@ -7787,7 +7824,7 @@ void MainWindow::handle_transceiver_update (Transceiver::TransceiverState const&
             }
 
             if(new_rig_state.frequency () < 30000000u) {
-                write_frequency_entry("ALL.TXT");
+                write_frequency_entry();
             }
 
             if (m_config.spot_to_reporting_networks ()) {
@@ -8242,8 +8279,8 @@ QString MainWindow::callsignSelected(bool){
                          [this](QString const & lhs,
                                 QString const & rhs)
         {
-          auto const lhsTS = m_callActivity[lhs].utcTimestamp;
-          auto const rhsTS = m_callActivity[rhs].utcTimestamp;
+          auto const lhsTS = m_callActivity.value(lhs).utcTimestamp;
+          auto const rhsTS = m_callActivity.value(rhs).utcTimestamp;
 
           return lhsTS == rhsTS ? lhs   < rhs
                                 : rhsTS < lhsTS;
@@ -8257,7 +8294,7 @@ QString MainWindow::callsignSelected(bool){
 
         for (auto const & key : keys)
         {
-          if (auto const & d = m_callActivity[key];
+          if (auto const & d = m_callActivity.value(key);
                    offsetLo <= d.offset &&
                    d.offset <= offsetHi)
           {
@@ -8371,11 +8408,21 @@ void MainWindow::markOffsetDirected(int offset, bool isAllCall){
     CachedDirectedType *d2 = new CachedDirectedType{ isAllCall, DriftingDateTime::currentDateTimeUtc() };
     m_rxDirectedCache.insert(offset/10*10,    d1, 10);
     m_rxDirectedCache.insert(offset/10*10+10, d2, 10);
+
+    // band activity at the offsets covered is now shown as directed
+    for(auto it = m_bandActivity.lowerBound(offset/10*10); it != m_bandActivity.cend() && it.key() < offset/10*10+20; ++it){
+        m_bandActivity.touch(it.key());
+    }
 }
 
 void MainWindow::clearOffsetDirected(int offset){
     m_rxDirectedCache.remove(offset/10*10);
     m_rxDirectedCache.remove(offset/10*10+10);
+
+    // band activity at the offsets covered is no longer shown as directed
+    for(auto it = m_bandActivity.lowerBound(offset/10*10); it != m_bandActivity.cend() && it.key() < offset/10*10+20; ++it){
+        m_bandActivity.touch(it.key());
+    }
 }
 
 bool MainWindow::isMyCallIncluded(const QString &text){
@@ -8409,6 +8456,9 @@ void MainWindow::processActivity(bool force) {
     // Recent Rx Activity
     processRxActivity();
 
+    // Evict Stale Activity
+    evictActivity();
+
     // Process Idle Activity
     processIdleActivity();
 
@@ -8436,6 +8486,75 @@ void MainWindow::setDrift(int n) {
     DriftingDateTime::setDrift(n);
 }
 
+void
+MainWindow::evictActivity()
+{
+  auto const now = DriftingDateTime::currentDateTimeUtc();
+
+  // Retain the selected call and offset no matter how old they are, along
+  // with calls we've got unread messages from and offsets that have a
+  // message buffer open.
+
+  QString selectedCall;
+  int     selectedOffset = -1;
+
+  if (auto const selectedItems = ui->tableWidgetCalls->selectedItems(); !selectedItems.isEmpty())
+  {
+    selectedCall = selectedItems.first()->data(Qt::UserRole).toString();
+  }
+
+  if (auto const selectedItems = ui->tableWidgetRXAll->selectedItems(); !selectedItems.isEmpty())
+  {
+    selectedOffset = selectedItems.first()->data(Qt::UserRole).toInt();
+  }
+
+  auto const evictedCalls = m_callActivity.evict(now, [&](QString    const & call,
+                                                          CallDetail const &)
+  {
+    return call == selectedCall || m_rxInboxCountCache.value(call, 0) > 0;
+  });
+
+  auto const evictedOffsets = m_bandActivity.evict(now, [&](int const offset,
+                                                            auto const &)
+  {
+    return offset == selectedOffset || m_messageBuffer.contains(offset);
+  });
+
+  if (evictedCalls.isEmpty() && evictedOffsets.isEmpty()) return;
+
+  // Calls evicted are no longer part of the heard graph; take them out of
+  // the sets of those they heard or were heard by, dropping any set left
+  // empty as a result. The details shown for those calls change.
+
+  for (auto const & call : evictedCalls)
+  {
+    auto const prune = [this, &call](QMap<QString, QSet<QString>> & from,
+                                     QMap<QString, QSet<QString>> & to)
+    {
+      for (auto const & other : from.take(call))
+      {
+        m_callActivity.touch(other);
+
+        if (auto const it = to.find(other); it != to.end())
+        {
+          it->remove(call);
+          if (it->isEmpty()) to.erase(it);
+        }
+      }
+    };
+
+    prune(m_heardGraphOutgoing, m_heardGraphIncoming);
+    prune(m_heardGraphIncoming, m_heardGraphOutgoing);
+  }
+
+  qCDebug(mainwindow_js8) << "evicted" << evictedCalls.size() << "calls and" << evictedOffsets.size() << "offsets;"
+                          << m_callActivity.size() << "calls in" << m_callActivity.memory() << "bytes,"
+                          << m_bandActivity.size() << "offsets in" << m_bandActivity.memory([](auto const & activity)
+                          {
+                            return static_cast<std::size_t>(activity.size()) * sizeof(ActivityDetail);
+                          }) << "bytes";
+}
+
 void
 MainWindow::processIdleActivity()
 {
@@ -8443,7 +8562,9 @@ MainWindow::processIdleActivity()
 
   // if we detect an idle offset, insert an ellipsis into the activity queue and band activity
 
-  for (auto [offset, activity] : m_bandActivity.asKeyValueRange())
+  QList<QPair<int, ActivityDetail>> idle;
+
+  for (auto const [offset, activity] : m_bandActivity.asKeyValueRange())
   {
     if (activity.isEmpty()) continue;
 
@@ -8468,7 +8589,15 @@ MainWindow::processIdleActivity()
     }
 
     m_rxActivityQueue.append(d);
-    activity.append(d);
+    idle.append({offset, d});
+  }
+
+  for (auto const & [offset, d] : idle)
+  {
+    m_bandActivity.update(offset, [&d](auto & activity)
+    {
+      activity.append(d);
+    });
   }
 }
 
@@ -8600,11 +8729,11 @@ void MainWindow::processRxActivity() {
             continue;
         }
 
-        if(m_bandActivity[offset].isEmpty()){
+        if(m_bandActivity.value(offset).isEmpty()){
             continue;
         }
 
-        auto last = m_bandActivity[offset].last();
+        auto last = m_bandActivity.value(offset).last();
         if((last.bits & Varicode::JS8CallLast) == Varicode::JS8CallLast){
             continue;
         }
@@ -8619,7 +8748,7 @@ void MainWindow::processRxActivity() {
         d.utcTimestamp = now;
         d.snr = -99;
 
-        m_bandActivity[offset].append(d);
+        m_bandActivity.update(offset, [&d](auto & activity){ activity.append(d); });
     }
 #endif
 }
@@ -9134,8 +9263,8 @@ void MainWindow::processCommandActivity() {
                              [this](QString const & lhs,
                                     QString const & rhs)
             {
-              return m_callActivity[rhs].utcTimestamp <
-                     m_callActivity[lhs].utcTimestamp;
+              return m_callActivity.value(rhs).utcTimestamp <
+                     m_callActivity.value(lhs).utcTimestamp;
             });
 
             auto const  callsignAging = m_config.callsign_aging();
@@ -9148,7 +9277,7 @@ void MainWindow::processCommandActivity() {
               if (i    >= maxStations) break;
               if (call == d.from)      continue;
 
-              auto const & cd = m_callActivity[call];
+              auto const & cd = m_callActivity.value(call);
 
               if (callsignAging && cd.utcTimestamp.secsTo(now) / 60 >= callsignAging)
               {
@@ -10051,12 +10180,28 @@ void MainWindow::displayBandActivity() {
         // Scroll Position
         auto const currentScrollPos = ui->tableWidgetRXAll->verticalScrollBar()->value();
 
-        // Clear the table
-        ui->tableWidgetRXAll->setRowCount(0);
-
         // Sort!
         auto const sort = getSortByReverse("bandActivity", "offset");
-        auto       keys = m_bandActivity.keys();
+
+        // Everything the rows, or their order, depend on other than the
+        // activity itself; if any of it changes, every row is rebuilt.
+        auto const context = QStringList{
+            sort.by,
+            QString::number(sort.reverse),
+            QString::number(showColumn("all", "minimal_labels", false)),
+            QString::number(ui->actionShow_Band_Heartbeats_and_ACKs->isChecked()),
+            QString::number(m_config.activity_aging()),
+            QString::number(ui->tableWidgetRXAll->columnWidth(3)),
+            m_config.table_font().toString(),
+            m_config.eot(),
+            m_config.my_callsign(),
+            m_config.color_MyCall().name(),
+            m_config.color_CQ().name(),
+            m_config.color_secondary_highlight().name(),
+            m_config.color_primary_highlight().name(),
+            joinWords(m_config.secondary_highlight_words()),
+            joinWords(m_config.primary_highlight_words())
+        }.join('\n');
 
         // Base comparison, called by the detail comparisons. We may not need
         // to proceed to the detail comparison at all here, if at least one of
@@ -10067,8 +10212,8 @@ void MainWindow::displayBandActivity() {
                                     int const rhsKey,
                                     auto   && detail)
         {
-          auto const & lhs = m_bandActivity[lhsKey];
-          auto const & rhs = m_bandActivity[rhsKey];
+          auto const lhs = m_bandActivity.value(lhsKey);
+          auto const rhs = m_bandActivity.value(rhsKey);
 
           if (lhs.isEmpty()) return false;
           if (rhs.isEmpty()) return true;
@@ -10143,27 +10288,49 @@ void MainWindow::displayBandActivity() {
           });
         };
 
-        // Always perform an initial sort by offset.
+        // Order by the field requested, if it's something other than offset,
+        // and then by offset. The comparators leave things in forward order;
+        // if a reverse sort was requested, reverse it.
+
+        std::function<bool(int, int)> by;
 
-        std::stable_sort(keys.begin(), keys.end());
+        if      (sort.by == "timestamp") by = compareTimestamp;
+        else if (sort.by == "snr")       by = compareSNR;
+        else if (sort.by == "submode")   by = compareSubmode;
 
-        // If something other than offset was requested as the sort by, perform an
-        // additional stable sort by the field requested.
+        auto const forward = [&by](int const lhsKey,
+                                   int const rhsKey)
+        {
+          if (by)
+          {
+            if (by(lhsKey, rhsKey)) return true;
+            if (by(rhsKey, lhsKey)) return false;
+          }
 
-        if      (sort.by == "timestamp") std::stable_sort(keys.begin(), keys.end(), compareTimestamp);
-        else if (sort.by == "snr")       std::stable_sort(keys.begin(), keys.end(), compareSNR);
-        else if (sort.by == "submode")   std::stable_sort(keys.begin(), keys.end(), compareSubmode);
+          return lhsKey < rhsKey;
+        };
 
-        // The sort comparators leave things in forward order. If a reverse sort
-        // was requested, reverse the keys.
+        auto const before = [&forward,
+                             reverse = sort.reverse](int const lhsKey,
+                                                     int const rhsKey)
+        {
+          return reverse ? forward(rhsKey, lhsKey)
+                         : forward(lhsKey, rhsKey);
+        };
 
-        if (sort.reverse) std::reverse(keys.begin(), keys.end());
+        // Build the row for an offset
+        auto const build = [&](int const offset) -> std::optional<TableRows::Cache<int>::Entry>
+        {
+            auto const it = m_bandActivity.constFind(offset);
+            if (it == m_bandActivity.cend()) {
+                return std::nullopt;
+            }
+
+            TableRows::Cache<int>::Entry entry;
 
-        // Build the table
-        foreach(int offset, keys) {
             bool isOffsetSelected = (offset == selectedOffset);
 
-            QList < ActivityDetail > items = m_bandActivity[offset];
+            QList < ActivityDetail > items = it.value();
             if (items.length() > 0) {
                 QDateTime timestamp;
                 QStringList text;
@@ -10181,9 +10348,13 @@ void MainWindow::displayBandActivity() {
 
                     bool shouldDisplay = true;
 
-                    // hide aged items
-                    if (!isOffsetSelected && activityAging && item.utcTimestamp.secsTo(now) / 60 >= activityAging) {
-                        shouldDisplay = false;
+                    // hide aged items, and rebuild the row as they age
+                    if (!isOffsetSelected && activityAging) {
+                        if (item.utcTimestamp.secsTo(now) / 60 >= activityAging) {
+                            shouldDisplay = false;
+                        } else {
+                            entry.expireBy(item.utcTimestamp.addSecs(activityAging * 60));
+                        }
                     }
 
                     // hide heartbeat items
@@ -10240,72 +10411,51 @@ void MainWindow::displayBandActivity() {
 
                 auto joined = Varicode::rstrip(text.join(""));
                 if (joined.isEmpty()) {
-                    continue;
+                    return entry;
                 }
 
-                ui->tableWidgetRXAll->insertRow(ui->tableWidgetRXAll->rowCount());
-                int row = ui->tableWidgetRXAll->rowCount() - 1;
-                int col = 0;
+                // rebuild the row as its age changes
+                entry.expireBy(sinceChanges(timestamp));
 
-                auto offsetItem = new QTableWidgetItem(QString(columnLabel("%1 Hz")).arg(offset));
-                offsetItem->setData(Qt::UserRole, QVariant(offset));
-                offsetItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, offsetItem);
+                auto & row = entry.row;
 
-                auto ageItem = new QTableWidgetItem(age);
-                ageItem->setTextAlignment(Qt::AlignCenter);
-                ageItem->setToolTip(timestamp.toString());
-                ui->tableWidgetRXAll->setItem(row, col++, ageItem);
+                row.font     = m_config.table_font();
+                row.selected = isOffsetSelected;
 
-                auto snrText = Varicode::formatSNR(snr);
-                auto snrItem = new QTableWidgetItem(snrText.isEmpty() ? "" : QString(columnLabel("%1 dB")).arg(snrText));
-                snrItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, snrItem);
+                row.cells.append({QString(columnLabel("%1 Hz")).arg(offset), {}, offset, Qt::AlignRight | Qt::AlignVCenter});
+                row.cells.append({age, timestamp.toString(), {}, Qt::AlignCenter});
 
-                auto tdriftItem = new QTableWidgetItem(QString(columnLabel("%1 ms")).arg((int)(1000*tdrift)));
-                tdriftItem->setData(Qt::UserRole, QVariant(tdrift));
-                tdriftItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, tdriftItem);
+                auto snrText = Varicode::formatSNR(snr);
+                row.cells.append({snrText.isEmpty() ? "" : QString(columnLabel("%1 dB")).arg(snrText), {}, {}, Qt::AlignRight | Qt::AlignVCenter});
+                row.cells.append({QString(columnLabel("%1 ms")).arg((int)(1000*tdrift)), {}, tdrift, Qt::AlignRight | Qt::AlignVCenter});
 
                 auto name = JS8::Submode::name(submode);
-                auto submodeItem = new QTableWidgetItem(name.left(1).replace("H", "N"));
-                submodeItem->setToolTip(name);
-                submodeItem->setData(Qt::UserRole, QVariant(name));
-                submodeItem->setTextAlignment(Qt::AlignCenter);
-                ui->tableWidgetRXAll->setItem(row, col++, submodeItem);
+                row.cells.append({name.left(1).replace("H", "N"), name, name, Qt::AlignCenter});
 
                 // align right if eliding...
                 int colWidth = ui->tableWidgetRXAll->columnWidth(3);
-                auto textItem = new QTableWidgetItem(joined);
                 auto html = QString("<qt/>%1").arg(joined.toHtmlEscaped());
                 html = html.replace(m_config.eot(), m_config.eot() + "<br/><br/>");
                 html = html.replace(QRegularExpression("([<]br[/][>])+$"), "");
-                textItem->setToolTip(html);
 
-                QFontMetrics fm(textItem->font());
+                QFontMetrics fm{QFont{}};
                 auto elidedText = fm.elidedText(joined, Qt::ElideLeft, colWidth);
                 auto flag = Qt::AlignLeft | Qt::AlignVCenter;
                 if (elidedText != joined) {
                     flag = Qt::AlignRight | Qt::AlignVCenter;
-                    textItem->setText(joined);
-                }
-                textItem->setTextAlignment(flag);
-
-                ui->tableWidgetRXAll->setItem(row, col++, textItem);
-
-                if (isOffsetSelected) {
-                    for(int i = 0; i < ui->tableWidgetRXAll->columnCount(); i++){
-                        ui->tableWidgetRXAll->item(row, i)->setSelected(true);
-                    }
                 }
+                row.cells.append({joined, html, {}, flag});
 
                 bool isDirectedAllCall = false;
+                bool isDirected = isDirectedOffset(offset, &isDirectedAllCall);
+                if (isDirected) {
+                    // rebuild the row once it's no longer directed
+                    entry.expireBy(m_rxDirectedCache[offset/10*10]->date.addSecs(120));
+                }
                 if(
-                    (isDirectedOffset(offset, &isDirectedAllCall) && !isDirectedAllCall) || isMyCallIncluded(text.last())
+                    (isDirected && !isDirectedAllCall) || isMyCallIncluded(text.last())
                 ){
-                    for(int i = 0; i < ui->tableWidgetRXAll->columnCount(); i++){
-                        ui->tableWidgetRXAll->item(row, i)->setBackground(QBrush(m_config.color_MyCall()));
-                    }
+                    row.background = QBrush(m_config.color_MyCall());
                 }
 
                 if(!text.isEmpty()){
@@ -10313,27 +10463,39 @@ void MainWindow::displayBandActivity() {
                     QSet<QString> words(list.begin(), list.end());
 
                     if(words.contains("CQ")){
-                        for(int i = 0; i < ui->tableWidgetRXAll->columnCount(); i++){
-                            ui->tableWidgetRXAll->item(row, i)->setBackground(QBrush(m_config.color_CQ()));
-                        }
+                        row.background = QBrush(m_config.color_CQ());
                     }
 
                     auto matchingSecondaryWords = m_config.secondary_highlight_words() & words;
                     if (!matchingSecondaryWords.isEmpty()){
-                        for(int i = 0; i < ui->tableWidgetRXAll->columnCount(); i++){
-                            ui->tableWidgetRXAll->item(row, i)->setBackground(QBrush(m_config.color_secondary_highlight()));
-                        }
+                        row.background = QBrush(m_config.color_secondary_highlight());
                     }
 
                     auto matchingPrimaryWords = m_config.primary_highlight_words() & words;
                     if (!matchingPrimaryWords.isEmpty()){
-                        for(int i = 0; i < ui->tableWidgetRXAll->columnCount(); i++){
-                            ui->tableWidgetRXAll->item(row, i)->setBackground(QBrush(m_config.color_primary_highlight()));
-                        }
+                        row.background = QBrush(m_config.color_primary_highlight());
                     }
                 }
             }
-        }
+
+            return entry;
+        };
+
+        // Rows, as we'd like them to be, rebuilt only for the offsets whose
+        // activity has changed, or whose age has, since the last refresh
+        QSet<int> changed;
+        bool const all = !m_bandActivity.takeChanged(changed);
+
+        auto const rows = m_bandActivityRows.refresh(context, selectedOffset, now, all, changed, [this]{
+            return m_bandActivity.keys();
+        }, build, before);
+
+        auto const refreshed = rows.size() != ui->tableWidgetRXAll->rowCount() || std::any_of(rows.begin(), rows.end(), [](auto const & row){
+            return row.changed;
+        });
+
+        // Bring the table up to date
+        TableRows::update(ui->tableWidgetRXAll, rows);
 
         // Set table color
         auto style = QString("QTableWidget { background:%1; selection-background-color:%2; alternate-background-color:%1; color:%3; } "
@@ -10341,7 +10503,9 @@ void MainWindow::displayBandActivity() {
         style = style.arg(m_config.color_table_background().name());
         style = style.arg(m_config.color_table_highlight().name());
         style = style.arg(m_config.color_table_foreground().name());
-        ui->tableWidgetRXAll->setStyleSheet(style);
+        if (ui->tableWidgetRXAll->styleSheet() != style) {
+            ui->tableWidgetRXAll->setStyleSheet(style);
+        }
 
         // Set the table palette for inactive selected row
         auto p = ui->tableWidgetRXAll->palette();
@@ -10349,16 +10513,8 @@ void MainWindow::displayBandActivity() {
         p.setColor(QPalette::Highlight, m_config.color_table_highlight());
         p.setColor(QPalette::HighlightedText, m_config.color_table_foreground());
         p.setColor(QPalette::Inactive, QPalette::Highlight, p.color(QPalette::Active, QPalette::Highlight));
-        ui->tableWidgetRXAll->setPalette(p);
-
-        // Set item fonts
-        for(int row = 0; row < ui->tableWidgetRXAll->rowCount(); row++){
-            for(int col = 0; col < ui->tableWidgetRXAll->columnCount(); col++){
-                auto item = ui->tableWidgetRXAll->item(row, col);
-                if(item){
-                    item->setFont(m_config.table_font());
-                }
-            }
+        if (p != ui->tableWidgetRXAll->palette()) {
+            ui->tableWidgetRXAll->setPalette(p);
         }
 
         // Column labels
@@ -10371,12 +10527,14 @@ void MainWindow::displayBandActivity() {
         ui->tableWidgetRXAll->setColumnHidden(3, !showColumn("band", "tdrift", false));
         ui->tableWidgetRXAll->setColumnHidden(4, !showColumn("band", "submode", false));
 
-        // Resize the table columns
-        ui->tableWidgetRXAll->resizeColumnToContents(0);
-        ui->tableWidgetRXAll->resizeColumnToContents(1);
-        ui->tableWidgetRXAll->resizeColumnToContents(2);
-        ui->tableWidgetRXAll->resizeColumnToContents(3);
-        ui->tableWidgetRXAll->resizeColumnToContents(4);
+        // Resize the table columns, if their contents might have changed
+        if (refreshed) {
+            ui->tableWidgetRXAll->resizeColumnToContents(0);
+            ui->tableWidgetRXAll->resizeColumnToContents(1);
+            ui->tableWidgetRXAll->resizeColumnToContents(2);
+            ui->tableWidgetRXAll->resizeColumnToContents(3);
+            ui->tableWidgetRXAll->resizeColumnToContents(4);
+        }
 
         // Reset the scroll position
         ui->tableWidgetRXAll->verticalScrollBar()->setValue(currentScrollPos);
@@ -10404,23 +10562,37 @@ void MainWindow::displayCallActivity() {
 
     ui->tableWidgetCalls->setUpdatesEnabled(false);
     {
-        // Clear the table
-        ui->tableWidgetCalls->setRowCount(0);
         ui->tableWidgetCalls->horizontalHeaderItem(8)->setText(m_config.miles() ? "mi" : "km");
 
-		bool showIconColumn = false;
-        createGroupCallsignTableRows(ui->tableWidgetCalls, selectedCall, showIconColumn); // isAllCallIncluded(selectedCall)); // || isGroupCallIncluded(selectedCall));
-
-        // Build the table
-
         auto const sort = getSortByReverse("callActivity", "callsign");
-        auto       keys = m_callActivity.keys();
+
+        // Everything the rows, or their order, depend on other than the
+        // activity itself; if any of it changes, every row is rebuilt.
+        auto const context = QStringList{
+            sort.by,
+            QString::number(sort.reverse),
+            QString::number(showColumn("all", "minimal_labels", false)),
+            QString::number(showColumn("call", "grid")),
+            QString::number(showColumn("call", "log")),
+            QString::number(showColumn("call", "logName")),
+            QString::number(showColumn("call", "logComment")),
+            QString::number(showColumn("call", "labels")),
+            QString::number(m_config.callsign_aging()),
+            QString::number(m_config.miles()),
+            m_config.my_grid(),
+            m_config.table_font().toString(),
+            m_config.color_CQ().name(),
+            m_config.color_secondary_highlight().name(),
+            m_config.color_primary_highlight().name(),
+            joinWords(m_config.secondary_highlight_words()),
+            joinWords(m_config.primary_highlight_words())
+        }.join('\n');
 
         auto const compareOffset = [this](QString const & lhsKey,
                                           QString const & rhsKey)
         {
-            return m_callActivity[lhsKey].offset <
-                   m_callActivity[rhsKey].offset;
+            return m_callActivity.value(lhsKey).offset <
+                   m_callActivity.value(rhsKey).offset;
         };
 
         auto const compareAzimuth = [this,
@@ -10428,8 +10600,8 @@ void MainWindow::displayCallActivity() {
                                      my_grid = m_config.my_grid()](QString const & lhsKey,
                                                                    QString const & rhsKey)
         {
-          auto const lhs = Geodesic::vector(my_grid, m_callActivity[lhsKey].grid).azimuth();
-          auto const rhs = Geodesic::vector(my_grid, m_callActivity[rhsKey].grid).azimuth();
+          auto const lhs = Geodesic::vector(my_grid, m_callActivity.value(lhsKey).grid).azimuth();
+          auto const rhs = Geodesic::vector(my_grid, m_callActivity.value(rhsKey).grid).azimuth();
 
           // We always want invalid azimuths to be at the end of the list,
           // and the list is going to be reversed if reverse is set, so we
@@ -10447,8 +10619,8 @@ void MainWindow::displayCallActivity() {
                                       my_grid = m_config.my_grid()](QString const & lhsKey,
                                                                     QString const & rhsKey)
         {
-          auto const lhs = Geodesic::vector(my_grid, m_callActivity[lhsKey].grid).distance();
-          auto const rhs = Geodesic::vector(my_grid, m_callActivity[rhsKey].grid).distance();
+          auto const lhs = Geodesic::vector(my_grid, m_callActivity.value(lhsKey).grid).distance();
+          auto const rhs = Geodesic::vector(my_grid, m_callActivity.value(rhsKey).grid).distance();
 
           // We always want invalid distances to be at the end of the list,
           // and the list is going to be reversed if reverse is set, so we
@@ -10464,23 +10636,23 @@ void MainWindow::displayCallActivity() {
         auto const compareTimestamp = [this](QString const & lhsKey,
                                              QString const & rhsKey)
         {
-          return m_callActivity[lhsKey].utcTimestamp <
-                 m_callActivity[rhsKey].utcTimestamp;
+          return m_callActivity.value(lhsKey).utcTimestamp <
+                 m_callActivity.value(rhsKey).utcTimestamp;
         };
 
         auto const compareAckTimestamp = [this](QString const & lhsKey,
                                                 QString const & rhsKey)
         {
-          return m_callActivity[rhsKey].ackTimestamp <
-                 m_callActivity[lhsKey].ackTimestamp;
+          return m_callActivity.value(rhsKey).ackTimestamp <
+                 m_callActivity.value(lhsKey).ackTimestamp;
         };
 
         auto const compareSNR = [this,
                                  reverse = sort.reverse](QString const & lhsKey,
                                                          QString const & rhsKey)
         {
-          auto lhs = m_callActivity[lhsKey].snr;
-          auto rhs = m_callActivity[rhsKey].snr;
+          auto lhs = m_callActivity.value(lhsKey).snr;
+          auto rhs = m_callActivity.value(rhsKey).snr;
 
           // We always want insane SNR values to be at the end of the list,
           // and the list is going to be reversed if reverse is set, so we
@@ -10501,8 +10673,8 @@ void MainWindow::displayCallActivity() {
         auto const compareSubmode = [this](QString const & lhsKey,
                                            QString const & rhsKey)
         {
-          auto lhs = m_callActivity[lhsKey].submode;
-          auto rhs = m_callActivity[rhsKey].submode;
+          auto lhs = m_callActivity.value(lhsKey).submode;
+          auto rhs = m_callActivity.value(rhsKey).submode;
 
           // Slow mode isn't at the start of the enumeration; it's in the
           // middle of it. All the other modes are in the expected order.
@@ -10513,45 +10685,73 @@ void MainWindow::displayCallActivity() {
           return lhs < rhs;
         };
 
-        // Always perform an initial sort by callsign.
+        // Order by the field requested, if it's something other than callsign,
+        // and then by callsign. The comparators leave things in forward order;
+        // if a reverse sort was requested, reverse it. Either way, calls with
+        // messages are pinned to the top.
 
-        std::stable_sort(keys.begin(), keys.end());
+        std::function<bool(QString const &, QString const &)> by;
 
-        // If something other than callsign was requested as the sort by, perform an
-        // additional stable sort by the field requested.
+        if      (sort.by == "offset")       by = compareOffset;
+        else if (sort.by == "distance")     by = compareDistance;
+        else if (sort.by == "azimuth")      by = compareAzimuth;
+        else if (sort.by == "timestamp")    by = compareTimestamp;
+        else if (sort.by == "ackTimestamp") by = compareAckTimestamp;
+        else if (sort.by == "snr")          by = compareSNR;
+        else if (sort.by == "submode")      by = compareSubmode;
 
-        if      (sort.by == "offset")       std::stable_sort(keys.begin(), keys.end(), compareOffset);
-        else if (sort.by == "distance")     std::stable_sort(keys.begin(), keys.end(), compareDistance);
-        else if (sort.by == "azimuth")      std::stable_sort(keys.begin(), keys.end(), compareAzimuth);
-        else if (sort.by == "timestamp")    std::stable_sort(keys.begin(), keys.end(), compareTimestamp);
-        else if (sort.by == "ackTimestamp") std::stable_sort(keys.begin(), keys.end(), compareAckTimestamp);
-        else if (sort.by == "snr")          std::stable_sort(keys.begin(), keys.end(), compareSNR);
-        else if (sort.by == "submode")      std::stable_sort(keys.begin(), keys.end(), compareSubmode);
-
-        // The sort comparators leave things in forward order. If a reverse sort
-        // was requested, reverse the keys.
+        auto const forward = [&by](QString const & lhsKey,
+                                   QString const & rhsKey)
+        {
+          if (by)
+          {
+            if (by(lhsKey, rhsKey)) return true;
+            if (by(rhsKey, lhsKey)) return false;
+          }
 
-        if (sort.reverse) std::reverse(keys.begin(), keys.end());
+          return lhsKey < rhsKey;
+        };
 
-        // pin messages to the top
-        std::stable_sort(keys.begin(), keys.end(), [this](QString const & lhsKey,
-                                                          QString const & rhsKey)
+        auto const before = [this,
+                             &forward,
+                             reverse = sort.reverse](QString const & lhsKey,
+                                                     QString const & rhsKey)
         {
-          auto const lhs = (int)!(m_rxInboxCountCache.value(lhsKey, 0) > 0);
-          auto const rhs = (int)!(m_rxInboxCountCache.value(rhsKey, 0) > 0);
+          auto const lhsPinned = m_rxInboxCountCache.value(lhsKey, 0) > 0;
+          auto const rhsPinned = m_rxInboxCountCache.value(rhsKey, 0) > 0;
 
-          return lhs < rhs;
-        });
+          if (lhsPinned != rhsPinned) return lhsPinned;
+
+          return reverse ? forward(rhsKey, lhsKey)
+                         : forward(lhsKey, rhsKey);
+        };
 
+        // Build the row for a call
         int callsignAging = m_config.callsign_aging();
-        foreach(QString call, keys) {
-            if(call.trimmed().isEmpty()){
-                continue;
+        auto const build = [&](QString const & call) -> std::optional<TableRows::Cache<QString>::Entry>
+        {
+            if(!m_callActivity.contains(call)){
+                return std::nullopt;
             }
 
-            CallDetail d = m_callActivity[call];
+            TableRows::Cache<QString>::Entry entry;
+
+            CallDetail d = m_callActivity.value(call);
             if(d.call.trimmed().isEmpty()){
-                continue;
+                entry.counted = false;
+                return entry;
+            }
+
+            // aged calls aren't counted, and are hidden unless they're selected
+            // or have messages; rebuild the row as the call ages
+            bool isAged = callsignAging && d.utcTimestamp.secsTo(now) / 60 >= callsignAging;
+            if (callsignAging && !isAged) {
+                entry.expireBy(d.utcTimestamp.addSecs(callsignAging * 60));
+            }
+            entry.counted = !isAged;
+
+            if(call.trimmed().isEmpty()){
+                return entry;
             }
 
             bool isCallSelected = (call == selectedCall);
@@ -10561,17 +10761,21 @@ void MainWindow::displayCallActivity() {
 
             // display telephone icon if called cq in the past 5 minutes
             bool hasCQ = d.cqTimestamp.isValid() && d.cqTimestamp.secsTo(now) / 60 < 5;
+            if (hasCQ) {
+                entry.expireBy(d.cqTimestamp.addSecs(5 * 60));
+            }
 
             // display star if they've acked a message from us
             bool hasACK = d.ackTimestamp.isValid();
 
-            if (!isCallSelected && !hasMessage && callsignAging && d.utcTimestamp.secsTo(now) / 60 >= callsignAging) {
-                continue;
+            if (!isCallSelected && !hasMessage && isAged) {
+                return entry;
             }
 
-            ui->tableWidgetCalls->insertRow(ui->tableWidgetCalls->rowCount());
-            int row = ui->tableWidgetCalls->rowCount() - 1;
-            int col = 0;
+            auto & row = entry.row;
+
+            row.font     = m_config.table_font();
+            row.selected = isCallSelected;
 
 #if SHOW_THROUGH_CALLS
             QString displayCall = d.through.isEmpty() ? d.call : QString("%1>%2").arg(d.through).arg(d.call);
@@ -10580,191 +10784,167 @@ void MainWindow::displayCallActivity() {
 #endif
             bool hasThrough = !d.through.isEmpty();
 
-            auto iconItem = new QTableWidgetItem(hasMessage ? "\u2691" : hasACK ? "\u2605" : hasCQ ? "\u260E" : hasThrough ? "\u269F" : "");
-            iconItem->setData(Qt::UserRole, QVariant(d.call));
-            iconItem->setToolTip(
+            if (!hasMessage) {
+                // rebuild the row as the age in the icon's tool tip changes
+                entry.expireBy(sinceChanges(hasACK ? d.ackTimestamp : hasCQ ? d.cqTimestamp : QDateTime{}));
+            }
+
+            row.cells.append({
+                hasMessage ? "\u2691" : hasACK ? "\u2605" : hasCQ ? "\u260E" : hasThrough ? "\u269F" : "",
                 hasMessage ? "Message Available" :
                 hasACK ? QString("Hearing Your Station (%1)").arg(since(d.ackTimestamp)) :
                 hasCQ ? QString("Calling CQ (%1)").arg(since(d.cqTimestamp)) :
                 hasThrough ? QString("Heard Through Relay (%1)").arg(d.through) :
-                "");
-            iconItem->setTextAlignment(Qt::AlignCenter);
-            ui->tableWidgetCalls->setItem(row, col++, iconItem);
-            if(hasMessage || hasACK || hasCQ || hasThrough){
-                showIconColumn = true;
+                "",
+                d.call,
+                Qt::AlignCenter
+            });
+            if(hasMessage){
+                row.font.setBold(true);
             }
 
-            auto displayItem = new QTableWidgetItem(displayCall);
-            displayItem->setData(Qt::UserRole, QVariant(d.call));
-            displayItem->setToolTip(generateCallDetail(displayCall));
-            ui->tableWidgetCalls->setItem(row, col++, displayItem);
+            row.cells.append({displayCall, generateCallDetail(displayCall), d.call});
 
 #if ONLY_SHOW_HEARD_CALLSIGNS
             if(d.utcTimestamp.isValid()){
 #else
             if(true){
 #endif
-                auto ageItem = new QTableWidgetItem(since(d.utcTimestamp));
-                ageItem->setTextAlignment(Qt::AlignCenter);
-                ageItem->setToolTip(d.utcTimestamp.toString());
-                ui->tableWidgetCalls->setItem(row, col++, ageItem);
-
-                auto snrText = Varicode::formatSNR(d.snr);
-                auto snrItem = new QTableWidgetItem(snrText.isEmpty() ? "" : QString(columnLabel("%1 dB")).arg(snrText));
-                snrItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, snrItem);
+                // rebuild the row as its age changes
+                entry.expireBy(sinceChanges(d.utcTimestamp));
 
-                auto offsetItem = new QTableWidgetItem(QString(columnLabel("%1 Hz")).arg(d.offset));
-                offsetItem->setData(Qt::UserRole, QVariant(d.offset));
-                offsetItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, offsetItem);
+                row.cells.append({since(d.utcTimestamp), d.utcTimestamp.toString(), {}, Qt::AlignCenter});
 
-                auto tdriftItem = new QTableWidgetItem(QString(columnLabel("%1 ms")).arg((int)(1000*d.tdrift)));
-                tdriftItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, tdriftItem);
+                auto snrText = Varicode::formatSNR(d.snr);
+                row.cells.append({snrText.isEmpty() ? "" : QString(columnLabel("%1 dB")).arg(snrText), {}, {}, Qt::AlignRight | Qt::AlignVCenter});
+                row.cells.append({QString(columnLabel("%1 Hz")).arg(d.offset), {}, d.offset, Qt::AlignRight | Qt::AlignVCenter});
+                row.cells.append({QString(columnLabel("%1 ms")).arg((int)(1000*d.tdrift)), {}, {}, Qt::AlignRight | Qt::AlignVCenter});
 
                 auto name = JS8::Submode::name(d.submode);
-                auto modeItem = new QTableWidgetItem(name.left(1).replace("H", "N"));
-                modeItem->setToolTip(name);
-                modeItem->setData(Qt::UserRole, QVariant(name));
-                modeItem->setTextAlignment(Qt::AlignCenter);
-                ui->tableWidgetCalls->setItem(row, col++, modeItem);
-
-                auto gridItem = new QTableWidgetItem(QString("%1").arg(d.grid.trimmed().left(4)));
-                gridItem->setToolTip(d.grid.trimmed());
-                ui->tableWidgetCalls->setItem(row, col++, gridItem);
-
-                auto const vector = Geodesic::vector(m_config.my_grid(), d.grid);
-                auto const units  = !showColumn("call", "labels");
-
-                auto distanceItem = new QTableWidgetItem(vector.distance().toString(m_config.miles(), units));
-                distanceItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, distanceItem);
-
-                auto azimuthItem = new QTableWidgetItem(vector.azimuth().toString(units));
-                if (auto const azimuth = vector.azimuth()) azimuthItem->setToolTip(azimuth.compass().toString());
-                azimuthItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-                ui->tableWidgetCalls->setItem(row, col++, azimuthItem);
-
-                QString flag;
-                if(m_logBook.hasWorkedBefore(d.call, "")){
-                    // unicode checkmark
-                    flag = "\u2713";
-                }
-                auto workedBeforeItem = new QTableWidgetItem(flag);
-                workedBeforeItem->setTextAlignment(Qt::AlignCenter);
-                ui->tableWidgetCalls->setItem(row, col++, workedBeforeItem);
+                row.cells.append({name.left(1).replace("H", "N"), name, name, Qt::AlignCenter});
 
                 QString logDetailGrid;
                 QString logDetailDate;
                 QString logDetailName;
                 QString logDetailComment;
-                bool gridItemEmpty = gridItem->text().isEmpty();
+                auto grid = d.grid.trimmed();
 
-                if((gridItemEmpty && showColumn("call", "grid")) || showColumn("call", "log") || showColumn("call", "logName") || showColumn("call", "logComment")){
+                if((grid.isEmpty() && showColumn("call", "grid")) || showColumn("call", "log") || showColumn("call", "logName") || showColumn("call", "logComment")){
                     m_logBook.findCallDetails(d.call, logDetailGrid, logDetailDate, logDetailName, logDetailComment);
                 }
 
-                if(gridItemEmpty && !logDetailGrid.isEmpty()){
-                    gridItem->setText(logDetailGrid.trimmed().left(4));
-                    gridItem->setToolTip(logDetailGrid.trimmed());
-
-                    auto const vector = Geodesic::vector(m_config.my_grid(), d.grid);
-                    auto const units  = !showColumn("call", "labels");
+                auto const vector = Geodesic::vector(m_config.my_grid(), d.grid);
+                auto const units  = !showColumn("call", "labels");
 
-                    distanceItem->setText(vector.distance().toString(m_config.miles(), units));
-                    azimuthItem->setText(vector.azimuth().toString(units));
-                    if (auto const azimuth = vector.azimuth()) azimuthItem->setToolTip(azimuth.compass().toString());
+                if(grid.isEmpty() && !logDetailGrid.isEmpty()){
+                    grid = logDetailGrid.trimmed();
 
                     // update the call activity cache with the loaded grid
                     if(m_callActivity.contains(d.call)){
-                        m_callActivity[call].grid = logDetailGrid.trimmed();
+                        m_callActivity.update(call, [&grid](auto & detail){ detail.grid = grid; });
                     }
                 }
 
-                if(!logDetailDate.isEmpty()){
-                    auto lastLogged = QDate::fromString(logDetailDate, "yyyyMMdd");
+                row.cells.append({grid.left(4), grid});
+                row.cells.append({vector.distance().toString(m_config.miles(), units), {}, {}, Qt::AlignRight | Qt::AlignVCenter});
 
-                    workedBeforeItem->setToolTip(QString("Last Logged: %1").arg(lastLogged.toString()));
-                }
+                auto const azimuth = vector.azimuth();
+                row.cells.append({azimuth.toString(units), azimuth ? azimuth.compass().toString() : QString(), {}, Qt::AlignRight | Qt::AlignVCenter});
 
-                auto logNameItem = new QTableWidgetItem(logDetailName);
-                logNameItem->setTextAlignment(Qt::AlignCenter);
-                logNameItem->setToolTip(logDetailName);
-                ui->tableWidgetCalls->setItem(row, col++, logNameItem);
+                QString flag;
+                if(m_logBook.hasWorkedBefore(d.call, "")){
+                    // unicode checkmark
+                    flag = "\u2713";
+                }
+                QString lastLogged;
+                if(!logDetailDate.isEmpty()){
+                    lastLogged = QString("Last Logged: %1").arg(QDate::fromString(logDetailDate, "yyyyMMdd").toString());
+                }
+                row.cells.append({flag, lastLogged, {}, Qt::AlignCenter});
 
-                auto logCommentItem = new QTableWidgetItem(logDetailComment);
-                logCommentItem->setTextAlignment(Qt::AlignCenter);
-                logCommentItem->setToolTip(logDetailComment);
-                ui->tableWidgetCalls->setItem(row, col++, logCommentItem);
+                row.cells.append({logDetailName, logDetailName, {}, Qt::AlignCenter});
+                row.cells.append({logDetailComment, logDetailComment, {}, Qt::AlignCenter});
 
             } else {
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // age
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // snr
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // freq
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // tdrift
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // mode
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // grid
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // distance
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // azimuth
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // worked before
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // log name
-                ui->tableWidgetCalls->setItem(row, col++, new QTableWidgetItem("")); // log comment
-            }
-
-            if (isCallSelected) {
-                for(int i = 0; i < ui->tableWidgetCalls->columnCount(); i++){
-                    ui->tableWidgetCalls->item(row, i)->setSelected(true);
+                // age, snr, freq, tdrift, mode, grid, distance, azimuth,
+                // worked before, log name, log comment
+                for(int i = 0; i < 11; i++){
+                    row.cells.append({});
                 }
             }
 
             if(hasCQ){
-                for(int i = 0; i < ui->tableWidgetCalls->columnCount(); i++){
-                    ui->tableWidgetCalls->item(row, i)->setBackground(QBrush(m_config.color_CQ()));
-                }
+                row.background = QBrush(m_config.color_CQ());
             }
 
             if (m_config.secondary_highlight_words().contains(call)){
-                for(int i = 0; i < ui->tableWidgetCalls->columnCount(); i++){
-                    ui->tableWidgetCalls->item(row, i)->setBackground(QBrush(m_config.color_secondary_highlight()));
-                }
+                row.background = QBrush(m_config.color_secondary_highlight());
             }
 
             if (m_config.primary_highlight_words().contains(call)){
-                for(int i = 0; i < ui->tableWidgetCalls->columnCount(); i++){
-                    ui->tableWidgetCalls->item(row, i)->setBackground(QBrush(m_config.color_primary_highlight()));
-                }
+                row.background = QBrush(m_config.color_primary_highlight());
             }
+
+            return entry;
+        };
+
+        // Rows of calls, rebuilt only for the calls whose activity has
+        // changed, or whose age or messages have, since the last refresh
+        QSet<QString> changed;
+        bool const all = !m_callActivity.takeChanged(changed);
+
+        if (m_rxInboxCountCache != m_callActivityInbox) {
+            auto const inboxChanged = [&changed](QMap<QString, int> const & lhs, QMap<QString, int> const & rhs){
+                for (auto const [call, count] : lhs.asKeyValueRange()) {
+                    if ((count > 0) != (rhs.value(call, 0) > 0)) {
+                        changed.insert(call);
+                    }
+                }
+            };
+            inboxChanged(m_rxInboxCountCache, m_callActivityInbox);
+            inboxChanged(m_callActivityInbox, m_rxInboxCountCache);
+            m_callActivityInbox = m_rxInboxCountCache;
         }
 
+        auto const callRows = m_callActivityRows.refresh(context, selectedCall, now, all, changed, [this]{
+            return m_callActivity.keys();
+        }, build, before);
+
+        bool showIconColumn = std::any_of(callRows.begin(), callRows.end(), [](auto const & row){
+            return !row.cells.first().text.isEmpty();
+        });
+
+        // Rows, as we'd like them to be; the groups ahead of the calls
+        QList<TableRows::Row> rows;
+
+        createGroupCallsignTableRows(ui->tableWidgetCalls, rows, selectedCall, showIconColumn, m_callActivityRows.counted()); // isAllCallIncluded(selectedCall)); // || isGroupCallIncluded(selectedCall));
+
+        auto const refreshed = rows.size() + callRows.size() != ui->tableWidgetCalls->rowCount() || ui->tableWidgetCalls->isColumnHidden(0) == showIconColumn || std::any_of(callRows.begin(), callRows.end(), [](auto const & row){
+            return row.changed;
+        });
+
+        rows.append(callRows);
+
+        // Bring the table up to date
+        TableRows::update(ui->tableWidgetCalls, rows);
+
         // Set table color
         auto style = QString("QTableWidget { background:%1; selection-background-color:%2; alternate-background-color:%1; color:%3; } "
                              "QTableWidget::item:selected { background-color: %2; color: %3; }");
         style = style.arg(m_config.color_table_background().name());
         style = style.arg(m_config.color_table_highlight().name());
         style = style.arg(m_config.color_table_foreground().name());
-        ui->tableWidgetCalls->setStyleSheet(style);
+        if (ui->tableWidgetCalls->styleSheet() != style) {
+            ui->tableWidgetCalls->setStyleSheet(style);
+        }
 
         // Set the table palette for inactive selected row
         auto p = ui->tableWidgetCalls->palette();
         p.setColor(QPalette::Highlight, m_config.color_table_highlight());
         p.setColor(QPalette::HighlightedText, m_config.color_table_foreground());
         p.setColor(QPalette::Inactive, QPalette::Highlight, p.color(QPalette::Active, QPalette::Highlight));
-        ui->tableWidgetCalls->setPalette(p);
-
-        // Set item fonts
-        for(int row = 0; row < ui->tableWidgetCalls->rowCount(); row++){
-            auto bold = ui->tableWidgetCalls->item(row,  0)->text() == "\u2691";
-            for(int col = 0; col < ui->tableWidgetCalls->columnCount(); col++){
-                auto item = ui->tableWidgetCalls->item(row, col);
-                if(item){
-                    auto f = m_config.table_font();
-                    if(bold){
-                        f.setBold(true);
-                    }
-                    item->setFont(f);
-                }
-            }
+        if (p != ui->tableWidgetCalls->palette()) {
+            ui->tableWidgetCalls->setPalette(p);
         }
 
         // Column labels
@@ -10785,19 +10965,21 @@ void MainWindow::displayCallActivity() {
         ui->tableWidgetCalls->setColumnHidden(11, !showColumn("call", "logName"));
         ui->tableWidgetCalls->setColumnHidden(12, !showColumn("call", "logComment"));
 
-        // Resize the table columns
-        ui->tableWidgetCalls->resizeColumnToContents(0);
-        ui->tableWidgetCalls->resizeColumnToContents(1);
-        ui->tableWidgetCalls->resizeColumnToContents(2);
-        ui->tableWidgetCalls->resizeColumnToContents(3);
-        ui->tableWidgetCalls->resizeColumnToContents(4);
-        ui->tableWidgetCalls->resizeColumnToContents(5);
-        ui->tableWidgetCalls->resizeColumnToContents(6);
-        ui->tableWidgetCalls->resizeColumnToContents(7);
-        ui->tableWidgetCalls->resizeColumnToContents(8);
-        ui->tableWidgetCalls->resizeColumnToContents(9);
-        ui->tableWidgetCalls->resizeColumnToContents(10);
-        ui->tableWidgetCalls->resizeColumnToContents(11);
+        // Resize the table columns, if their contents might have changed
+        if (refreshed) {
+            ui->tableWidgetCalls->resizeColumnToContents(0);
+            ui->tableWidgetCalls->resizeColumnToContents(1);
+            ui->tableWidgetCalls->resizeColumnToContents(2);
+            ui->tableWidgetCalls->resizeColumnToContents(3);
+            ui->tableWidgetCalls->resizeColumnToContents(4);
+            ui->tableWidgetCalls->resizeColumnToContents(5);
+            ui->tableWidgetCalls->resizeColumnToContents(6);
+            ui->tableWidgetCalls->resizeColumnToContents(7);
+            ui->tableWidgetCalls->resizeColumnToContents(8);
+            ui->tableWidgetCalls->resizeColumnToContents(9);
+            ui->tableWidgetCalls->resizeColumnToContents(10);
+            ui->tableWidgetCalls->resizeColumnToContents(11);
+        }
 
         // Reset the scroll position
         ui->tableWidgetCalls->verticalScrollBar()->setValue(currentScrollPos);
@@ -11351,57 +11533,38 @@ void MainWindow::tx_watchdog (bool triggered)
   if (prior != triggered) statusUpdate ();
 }
 
-void MainWindow::write_frequency_entry (QString const& file_name){
+void MainWindow::write_frequency_entry (){
   if(!m_config.write_logs()){
       return;
   }
 
   // Write freq changes to ALL.TXT only below 30 MHz.
-  QFile f2 {m_config.writeable_data_dir ().absoluteFilePath (file_name)};
-  if (f2.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-    QTextStream out(&f2);
-    out << DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss")
-        << "  " << qSetRealNumberPrecision (12) << (m_freqNominal / 1.e6) << " MHz  "
-        << "JS8" << Qt::endl;
-    f2.close();
-  } else {
-    QTimer::singleShot(0, [
-      this,
-      message = tr("Cannot open \"%1\" for append: %2").arg(f2.fileName()).arg(f2.errorString())
-    ]{
-      JS8MessageBox::warning_message(this, tr("Log File Error"), message);
-    });
-  }
+  QString line;
+  QTextStream out(&line);
+  out << DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss")
+      << "  " << qSetRealNumberPrecision (12) << (m_freqNominal / 1.e6) << " MHz  "
+      << "JS8";
+  out.flush();
+  m_allTxt.write(line);
 }
 
-void MainWindow::write_transmit_entry (QString const& file_name)
+void MainWindow::write_transmit_entry ()
 {
   if(!m_config.write_logs()){
       return;
   }
 
-  QFile f {m_config.writeable_data_dir ().absoluteFilePath (file_name)};
-  if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append))
-    {
-      QTextStream out(&f);
-      auto time = DriftingDateTime::currentDateTimeUtc ();
-      time = time.addSecs (-(time.time ().second () % m_TRperiod));
-      auto dt = DecodedText(m_currentMessage, m_currentMessageBits, m_nSubMode);
-      out << time.toString("yyyy-MM-dd hh:mm:ss")
-          << "  Transmitting " << qSetRealNumberPrecision (12) << (m_freqNominal / 1.e6)
-          << " MHz  " << "JS8"
-          << ":  " << dt.message() << Qt::endl;
-      f.close();
-    }
-  else
-    {
-      QTimer::singleShot(0, [
-        this,
-        message = tr("Cannot open \"%1\" for append: %2").arg(f.fileName()).arg(f.errorString())
-      ] {
-        JS8MessageBox::warning_message(this, tr("Log File Error"), message);
-      });
-    }
+  QString line;
+  QTextStream out(&line);
+  auto time = DriftingDateTime::currentDateTimeUtc ();
+  time = time.addSecs (-(time.time ().second () % m_TRperiod));
+  auto dt = DecodedText(m_currentMessage, m_currentMessageBits, m_nSubMode);
+  out << time.toString("yyyy-MM-dd hh:mm:ss")
+      << "  Transmitting " << qSetRealNumberPrecision (12) << (m_freqNominal / 1.e6)
+      << " MHz  " << "JS8"
+      << ":  " << dt.message();
+  out.flush();
+  m_allTxt.write(line);
 }
 
 
@@ -11412,36 +11575,24 @@ MainWindow::writeAllTxt(QStringView message)
 
   // Write decoded text to file "ALL.TXT".
 
-  QFile f {m_config.writeable_data_dir().absoluteFilePath("ALL.TXT")};
-
-  if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append))
+  if (m_RxLog == 1)
   {
-    QTextStream out(&f);
-
-    if (m_RxLog == 1)
-    {
-      out << DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss")
-          << "  "
-          << qSetRealNumberPrecision(12)
-          << (m_freqNominal / 1.e6)
-          << " MHz  JS8"
-          << Qt::endl;
+    QString     line;
+    QTextStream out(&line);
 
-      m_RxLog = 0;
-    }
+    out << DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss")
+        << "  "
+        << qSetRealNumberPrecision(12)
+        << (m_freqNominal / 1.e6)
+        << " MHz  JS8";
+    out.flush();
 
-    out << message << Qt::endl;
+    m_allTxt.write(line);
 
-    f.close();
-  }
-  else
-  {
-    JS8MessageBox::warning_message(this,
-                               tr("File Open Error"),
-                               tr("Cannot open \"%1\" for append: %2")
-                               .arg(f.fileName())
-                               .arg(f.errorString()));
+    m_RxLog = 0;
   }
+
+  m_allTxt.write(message.toString());
 }
 
 void
@@ -11452,29 +11603,11 @@ MainWindow::writeMsgTxt(QStringView message,
 
   // Write decoded text to file "DIRECTED.TXT".
 
-  QFile f {m_config.writeable_data_dir().absoluteFilePath("DIRECTED.TXT")};
-
-  if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append))
-  {
-      QTextStream out(&f);
-      QString     output = DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss")
-                  % "\t" % Radio::frequency_MHz_string(m_freqNominal)
-                  % "\t" % QString::number(freq())
-                  % "\t" % Varicode::formatSNR(snr)
-                  % "\t" % message;
-
-      out << output << Qt::endl;
-
-      f.close();
-    }
-    else
-    {
-      JS8MessageBox::warning_message(this,
-                                  tr("File Open Error"),
-                                  tr("Cannot open \"%1\" for append: %2")
-                                  .arg(f.fileName())
-                                  .arg(f.errorString()));
-    }
+  m_directedTxt.write(DriftingDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss")
+                      % "\t" % Radio::frequency_MHz_string(m_freqNominal)
+                      % "\t" % QString::number(freq())
+                      % "\t" % Varicode::formatSNR(snr)
+                      % "\t" % message);
 }
 
 QByteArray
@@ -56,7 +56,11 @@
 #include "NotificationAudio.h"
 #include "ProcessThread.h"
 #include "JS8.hpp"
+#include "Spectrum.hpp"
+#include "LogWriter.hpp"
 #include "StationList.hpp"
+#include "TableRows.hpp"
+#include "ActivityStore.hpp"
 
 extern int volatile itone[JS8_NUM_SYMBOLS];   //Audio tones for all Tx symbols
 
@@ -132,6 +136,7 @@ public slots:
   void showSoundOutError(const QString& errorMsg);
   void showStatusMessage(const QString& statusMsg);
   void dataSink(qint64 frames);
+  void spectrumSink();
   /**
    * The name `guiUpdate` suggests updating of the views from the models
    * (in MVC terms, but we don't do MVC in this project), animations and stuff.
@@ -156,8 +161,12 @@ public slots:
   void clearActivity();
   void clearBandActivity();
   void clearRXActivity();
+  void trimRXActivity();
+  void pageRXActivity();
+  void holdRXActivity();
+  bool isRXActivityAtBottom() const;
   void clearCallActivity();
-  void createGroupCallsignTableRows(QTableWidget *table, const QString &selectedCall, bool &showIconColumn);
+  void createGroupCallsignTableRows(QTableWidget *table, QList<TableRows::Row> &rows, const QString &selectedCall, bool &showIconColumn, qsizetype count);
   void displayTextForFreq(QString text, int freq, QDateTime date, bool isTx, bool isNewLine, bool isLast);
   void writeNoticeTextToUI(QDateTime date, QString text);
   int writeMessageTextToUI(QDateTime date, QString text, int freq, bool isTx, int block=-1);
@@ -465,6 +474,9 @@ private:
   QThread m_audioThread;
   QThread m_notificationAudioThread;
   JS8::Decoder m_decoder;
+  Spectrum m_spectrum;
+  LogWriter m_allTxt;
+  LogWriter m_directedTxt;
 
   qint64  m_secBandChanged;
 
@@ -596,6 +608,11 @@ private:
     int submode;
   };
 
+  struct RxText {
+    QTextDocument * document; // the window, as it was last shown
+    QStringList pages; // html of rx text trimmed from the window, oldest first
+  };
+
   struct MessageBuffer {
     CommandDetail cmd;
     QQueue<CallDetail> compound;
@@ -699,10 +716,20 @@ private:
   QCache<int, CachedDirectedType> m_rxDirectedCache; // freq -> last directed rx
   QCache<QString, int> m_rxCallCache; // call -> last freq seen
   QMap<int, int> m_rxFrameBlockNumbers; // freq -> block
-  BandActivity m_bandActivity; // freq -> [(text, last timestamp), ...]
+  ActivityStore<int, QList<ActivityDetail>> m_bandActivity {[](auto const & activity) // freq -> [(text, last timestamp), ...]
+  {
+    return activity.isEmpty() ? QDateTime() : activity.last().utcTimestamp;
+  }};
+  qsizetype m_bandActivityDepth; // entries retained per freq
   QMap<int, MessageBuffer> m_messageBuffer; // freq -> (cmd, [frames, ...])
   int m_lastClosedMessageBufferOffset;
-  QMap<QString, CallDetail> m_callActivity; // call -> (last freq, last timestamp)
+  ActivityStore<QString, CallDetail> m_callActivity {[](auto const & detail) // call -> (last freq, last timestamp)
+  {
+    return detail.utcTimestamp;
+  }};
+  TableRows::Cache<int> m_bandActivityRows; // freq -> row, as last displayed
+  TableRows::Cache<QString> m_callActivityRows; // call -> row, as last displayed
+  QMap<QString, int> m_callActivityInbox; // call -> count, as last displayed
 
   QMap<int, QString> m_origRxHeaderLabelMap; // colIndex, label
   QMap<int, QString> m_origCallActivityHeaderLabelMap; // colIndex, label
@@ -715,7 +742,10 @@ private:
 
   QMap<QString, QMap<QString, CallDetail>> m_callActivityBandCache; // band -> call activity
   QMap<QString, QMap<int, QList<ActivityDetail>>> m_bandActivityBandCache; // band -> band activity
-  QMap<QString, QString> m_rxTextBandCache; // band -> rx text
+  QMap<QString, RxText> m_rxTextBandCache; // band -> rx text
+  QStringList m_rxTextPages; // html of rx text trimmed from the window, oldest first
+  int m_rxTextWindow; // blocks of rx text in the window
+  int m_rxTextPagesKept; // pages of rx text kept once trimmed from the window
   QMap<QString, QMap<QString, QSet<QString>>> m_heardGraphOutgoingBandCache; // band -> heard in
   QMap<QString, QMap<QString, QSet<QString>>> m_heardGraphIncomingBandCache; // band -> heard out
 
@@ -743,6 +773,8 @@ private:
   QThread::Priority m_audioThreadPriority;
   QThread::Priority m_notificationAudioThreadPriority;
   QThread::Priority m_decoderThreadPriority;
+  QThread::Priority m_spectrumThreadPriority;
+  LogWriter::Options m_logOptions;
   QThread::Priority m_networkThreadPriority;
   bool m_splitMode;
   bool m_monitoring;
@@ -806,6 +838,7 @@ private:
   void resetTimeDeltaAverage();
   void processRxActivity();
   void processIdleActivity();
+  void evictActivity();
   void processCompoundActivity();
   void processBufferedActivity();
   void processCommandActivity();
@@ -840,8 +873,8 @@ private:
   void resetIdleTimer();
   void incrementIdleTimer();
   void tx_watchdog (bool triggered);
-  void write_frequency_entry (QString const& file_name);
-  void write_transmit_entry (QString const& file_name);
+  void write_frequency_entry ();
+  void write_transmit_entry ();
 };
 
 #endif // MAINWINDOW_H
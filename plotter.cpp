@@ -5,6 +5,8 @@
 #include <type_traits>
 #include <utility>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QFontMetrics>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPen>
@@ -35,6 +37,24 @@ namespace
 
   constexpr std::size_t VERT_DIVS = 7;
 
+  // Number of waterfall lines over which the debug overlay averages the
+  // time taken to draw a line.
+
+  constexpr int FRAME_LINES = 64;
+
+  // Waterfall history quantisation; levels are stored in steps of 1/256th
+  // of a unit of flattened spectrum value, centered on LEVEL_ZERO, for a
+  // range of +/-128 units, much finer than a palette step at any gain we
+  // offer. Level 0 is reserved for NaN values.
+
+  constexpr float LEVEL_STEPS = 256.0f;
+  constexpr int   LEVEL_ZERO  = 32768;
+  constexpr int   LEVEL_NAN   = 0;
+
+  // Green line drawn across the waterfall at a transmit period start.
+
+  constexpr QRgb PERIOD_LINE = qRgb(0, 255, 0);
+
   // FFT bin width, as with NSPS, a constant; see the JT9 documentation
   // for the reasoning behind the values used here, but in short, since
   // NSPS is always 6912, 1500 for nsps2 and 2048 for nfft3 are optimal.
@@ -90,6 +110,25 @@ namespace
     if (fSpan >  100) { return  20; }
                         return  10;
   }
+
+  // Convert a flattened spectrum value to a waterfall history level, and
+  // a level back to the value it represents.
+
+  std::uint16_t
+  quantise(float const value)
+  {
+    if (std::isnan(value)) return LEVEL_NAN;
+
+    auto const steps = std::clamp(value * LEVEL_STEPS, 1.0f - LEVEL_ZERO, LEVEL_ZERO - 1.0f);
+
+    return static_cast<std::uint16_t>(std::lround(steps) + LEVEL_ZERO);
+  }
+
+  constexpr float
+  dequantise(std::size_t const level)
+  {
+    return (static_cast<int>(level) - LEVEL_ZERO) / LEVEL_STEPS;
+  }
 }
 
 /******************************************************************************/
@@ -101,7 +140,6 @@ CPlotter::CPlotter(QWidget * parent)
   , m_freqPerPixel {m_binsPerPixel * FFT_BIN_WIDTH}
   , m_scaler1D     {m_waterfallAvg, m_binsPerPixel}
   , m_scaler2D     {m_h2}
-  , m_replotTimer  {new QTimer(this)}
   , m_resizeTimer  {new QTimer(this)}
 {
   setFocusPolicy(Qt::StrongFocus);
@@ -109,16 +147,15 @@ CPlotter::CPlotter(QWidget * parent)
 
   // Debounce resize events such that resize() doesn't actually get called
   // until the debounce time has elapsed without any further resize events.
-  // Likewise, for control-initiated changes that would cause a replot.
+  // Control-initiated changes that would cause a replot don't need this;
+  // recoloring the waterfall history is cheap enough to do immediately.
 
-  m_replotTimer->setSingleShot(true);
   m_resizeTimer->setSingleShot(true);
-
-  m_replotTimer->setInterval(DEBOUNCE_INTERVAL);
   m_resizeTimer->setInterval(DEBOUNCE_INTERVAL);
 
-  connect(m_replotTimer, &QTimer::timeout, this, &CPlotter::replot);
   connect(m_resizeTimer, &QTimer::timeout, this, &CPlotter::resize);
+
+  recolor();
 }
 
 CPlotter::~CPlotter() = default;
@@ -140,8 +177,28 @@ CPlotter::paintEvent(QPaintEvent *)
 {
   QPainter p(this);
 
-  p.drawPixmap(0, 0,    m_ScalePixmap);
-  p.drawPixmap(0, 30,   m_WaterfallPixmap);
+  p.drawPixmap(0, 0, m_ScalePixmap);
+
+  // The waterfall image is a circular buffer; draw the span running from
+  // the newest line to the bottom of the image, then the older span that
+  // wrapped around to its top. Note that an empty source rectangle means
+  // the whole image to drawImage(), so the second span must be skipped
+  // if there's nothing in it.
+
+  if (!m_WaterfallImage.isNull())
+  {
+    auto const dpr    = m_WaterfallImage.devicePixelRatio();
+    auto const width  = m_WaterfallImage.width();
+    auto const height = m_WaterfallImage.height();
+
+    p.drawImage(QPointF(0, 30), m_WaterfallImage, QRect(0, m_top, width, height - m_top));
+
+    if (m_top > 0)
+    {
+      p.drawImage(QPointF(0, 30 + (height - m_top) / dpr), m_WaterfallImage, QRect(0, 0, width, m_top));
+    }
+  }
+
   p.drawPixmap(0, m_h1, m_SpectrumPixmap);
 
   p.drawPixmap(xFromFreq(m_freq), 30, m_DialPixmap[0]);
@@ -156,6 +213,20 @@ CPlotter::paintEvent(QPaintEvent *)
     p.drawPixmap(                                                      0, 0, m_FilterPixmap[0]);
     p.drawPixmap(m_w - m_FilterPixmap[1].deviceIndependentSize().width(), 0, m_FilterPixmap[1]);
   }
+
+  if (m_debugOverlay)
+  {
+    auto const text = QString("%1 us/line avg, %2 us peak")
+                        .arg(m_frameAvgUs,  0, 'f', 1)
+                        .arg(m_framePeakUs, 0, 'f', 1);
+    auto       rect = p.fontMetrics().boundingRect(text).adjusted(-4, -2, 4, 2);
+
+    rect.moveTopRight(QPoint(m_w - 5, 35));
+
+    p.fillRect(rect, QColor(0, 0, 0, 160));
+    p.setPen(Qt::yellow);
+    p.drawText(rect, Qt::AlignCenter, text);
+  }
 }
 
 void
@@ -167,22 +238,25 @@ CPlotter::resizeEvent(QResizeEvent *)
 void
 CPlotter::drawLine(QString const & text)
 {
-  m_WaterfallPixmap.scroll(0, 1, m_WaterfallPixmap.rect());
+  // Move to the next row of the waterfall and draw a green line across
+  // the complete span, saving the text against a potential replot.
 
-  QPainter p(&m_WaterfallPixmap);
+  if (!m_WaterfallImage.isNull())
+  {
+    auto const row = nextRow();
 
-  // Draw a green line across the complete span.
+    m_rows  [row] = Row::Label;
+    m_labels[row] = text;
 
-  p.setPen(Qt::green);
-  p.drawLine(0, 0, m_w, 0);
+    fillRow(row, PERIOD_LINE);
+  }
 
   // Compute the number of lines required before we need to draw the
-  // text, and note the text to draw, saving it against a potential
-  // replot request.
+  // text, and note the text to draw. A painter on an image uses the
+  // application font, so that's the one that we measure.
 
   m_text = text;
-  m_line = p.fontMetrics().height() * devicePixelRatio();
-  m_replot.push_front(m_text);
+  m_line = QFontMetrics(QFont()).height() * devicePixelRatio();
 
   update();
 }
@@ -191,21 +265,30 @@ void
 CPlotter::drawData(WF::SWide       swide,
                    WF::State const state)
 {
-  m_WaterfallPixmap.scroll(0, 1, m_WaterfallPixmap.rect());
+  QElapsedTimer timer;
+  timer.start();
 
   // Flattening, we just process the visible width; tends to be the best
   // approach in terms of what happens when resizing to a larger size.
 
   m_flatten(swide.data(), m_w);
 
-  // Display the data in the waterfall, drawing only the displayed range.
-
-  QPainter p(&m_WaterfallPixmap);
+  // Save the displayed range in the waterfall history, quantised, and
+  // draw it into the next row; nothing else in the waterfall has to move.
 
-  for (auto x = 0; x < m_w; ++x)
+  if (!m_WaterfallImage.isNull())
   {
-    p.setPen(m_colors[m_scaler1D(swide[x])]);
-    p.drawPoint(x, 0);
+    auto const row = nextRow();
+
+    std::transform(swide.begin(),
+                   swide.begin() + m_w,
+                   m_levels.begin() + static_cast<std::size_t>(row) * m_w,
+                   quantise);
+
+    m_rows  [row] = Row::Data;
+    m_labels[row] = QString();
+
+    drawRow(row);
   }
 
   // See if we've reached the point where we should draw previously computed
@@ -215,8 +298,11 @@ CPlotter::drawData(WF::SWide       swide,
   {
     m_line = std::numeric_limits<int>::max();
 
-    p.setPen(Qt::white);
-    p.drawText(5, p.fontMetrics().ascent(), m_text);
+    paintWaterfall([this](QPainter & p)
+    {
+      p.setPen(Qt::white);
+      p.drawText(5, p.fontMetrics().ascent(), m_text);
+    });
   }
 
   // A number of factors determine whether or not we should draw the spectrum.
@@ -332,9 +418,22 @@ CPlotter::drawData(WF::SWide       swide,
     }
   }
 
-  // Save the data against a potential replot requirement.
+  // Account for the time taken; every block of lines, publish the average
+  // and peak for the debug overlay.
 
-  m_replot.push_front(std::move(swide));
+  auto const elapsed = timer.nsecsElapsed();
+
+  m_frameNs   += elapsed;
+  m_frameMaxNs = std::max(m_frameMaxNs, elapsed);
+
+  if (++m_frameLines == FRAME_LINES)
+  {
+    m_frameAvgUs  = m_frameNs    / 1000.0 / FRAME_LINES;
+    m_framePeakUs = m_frameMaxNs / 1000.0;
+    m_frameNs     = 0;
+    m_frameMaxNs  = 0;
+    m_frameLines  = 0;
+  }
 
   update();
 }
@@ -347,12 +446,13 @@ CPlotter::drawDecodeLine(QColor const & color,
   auto const x1 = xFromFreq(ia);
   auto const x2 = xFromFreq(ib);
 
-  QPainter p(&m_WaterfallPixmap);
-
-  p.setPen(color);
-  p.drawLine(qMin(x1, x2), 4, qMax(x1, x2), 4);
-  p.drawLine(qMin(x1, x2), 0, qMin(x1, x2), 9);
-  p.drawLine(qMax(x1, x2), 0, qMax(x1, x2), 9);
+  paintWaterfall([&](QPainter & p)
+  {
+    p.setPen(color);
+    p.drawLine(qMin(x1, x2), 4, qMax(x1, x2), 4);
+    p.drawLine(qMin(x1, x2), 0, qMin(x1, x2), 9);
+    p.drawLine(qMax(x1, x2), 0, qMax(x1, x2), 9);
+  });
 }
 
 void
@@ -360,10 +460,9 @@ CPlotter::drawHorizontalLine(QColor const & color,
                              int    const   x,
                              int    const   width)
 {
-  QPainter p(&m_WaterfallPixmap);
+  if (m_WaterfallImage.isNull()) return;
 
-  p.setPen(color);
-  p.drawLine(x, 0, width <= 0 ? m_w : x + width, 0);
+  fillRow(m_top, color.rgb(), x, width <= 0 ? m_w : x + width);
 }
 
 void
@@ -598,83 +697,140 @@ CPlotter::drawDials()
   }
 }
 
-// Replot the waterfall display, using the data present in the replot
-// buffer, if any.
+// Draw a row of waterfall history into the same row of the waterfall image,
+// writing colors directly into the scanline. Each logical x covers the
+// device pixel columns noted for it in the column map.
 
 void
-CPlotter::replot()
+CPlotter::drawRow(int const row)
 {
-  if (m_WaterfallPixmap.isNull()) return;
+  auto const line   = reinterpret_cast<QRgb *>(m_WaterfallImage.scanLine(row));
+  auto const levels = m_levels.data() + static_cast<std::size_t>(row) * m_w;
 
-  // Whack anything currently in the waterfall pixmap; we must do this
-  // before attaching a painter.
+  for (auto x = 0; x < m_w; ++x)
+  {
+    std::fill(line + m_columns[x],
+              line + m_columns[x + 1],
+              m_levelColors[levels[x]]);
+  }
+}
 
-  m_WaterfallPixmap.fill(Qt::black);
+// Fill the logical range [x1, x2) of a row of the waterfall image with a
+// single color.
 
-  // We need to consider that entries have been added to the replot
-  // buffer at a rate proportional to the display pixel ratio, i.e.,
-  // it deals in device pixels, not logical pixels, so we must deal
-  // with scaling in the y dimension for this to work out.
+void
+CPlotter::fillRow(int  const row,
+                  QRgb const rgb,
+                  int  const x1,
+                  int  const x2)
+{
+  auto const line = reinterpret_cast<QRgb *>(m_WaterfallImage.scanLine(row));
 
-  QPainter p(&m_WaterfallPixmap);
+  std::fill(line + m_columns[std::clamp(x1, 0, m_w)],
+            line + m_columns[std::clamp(x2, 0, m_w)],
+            rgb);
+}
 
-  p.scale(1, 1 / m_WaterfallPixmap.devicePixelRatio());
+// Paint into the waterfall image with the origin at the newest line, as if
+// it were an ordinary top-down image, clipped to the image height. Anything
+// painted may run past the bottom of the image and need to wrap around to
+// the top, so we paint a second time with the origin a full image height
+// higher; whatever doesn't wrap is clipped away in that pass.
 
-  // Our draw routine pushed entries to the front of the buffer, so we
-  // can iterate in forward order here, the Qt coordinate system having
-  // (0, 0) as the upper-left point.
+void
+CPlotter::paintWaterfall(std::function<void(QPainter &)> const & paint)
+{
+  if (m_WaterfallImage.isNull()) return;
 
-  auto y = 0;
+  QPainter p(&m_WaterfallImage);
 
-  for (auto && v : m_replot)
+  auto const size = m_WaterfallImage.deviceIndependentSize();
+  auto const dpr  = m_WaterfallImage.devicePixelRatio();
+
+  for (auto const top : {m_top, m_top - m_WaterfallImage.height()})
   {
-    std::visit([ratio   = m_WaterfallPixmap.devicePixelRatio(),
-                width   = m_WaterfallPixmap.size().width(),
-                extra   = p.fontMetrics().descent(),
-                &y      = std::as_const(y),
-                &colors = std::as_const(m_colors),
-                &scaler = std::as_const(m_scaler1D),
-                &p](auto const & v)
-    {
-      // Note that a monostate is constructed as the default when we
-      // resize but have no backing data. There is nothing to in that
-      // case; just data that we didn't have when we were resized.
+    p.save();
+    p.translate(0, top / dpr);
+    p.setClipRect(QRectF(QPointF(0, 0), size));
+    paint(p);
+    p.restore();
+  }
+}
 
-      using T = std::decay_t<decltype(v)>;
+// Move the newest line of the waterfall on to the next row of the image,
+// i.e., the one above it, wrapping around to the bottom, and return it.
 
-      // Line drawing; draw the usual green line across the width of the
-      // pixmap, annotated by the text provided.
+int
+CPlotter::nextRow()
+{
+  return m_top = (m_top ? m_top : m_WaterfallImage.height()) - 1;
+}
 
-      if constexpr (std::is_same_v<T, QString>)
-      {
-        p.setPen(Qt::white);
-        p.save();
-        p.scale(1, ratio);
-        p.drawText(5, y / ratio - extra, v);
-        p.restore();
-        p.setPen(Qt::green);
-        p.drawLine(0, y, width, y);
-      }
+// Map every possible level through the 1D scaler and the palette; needed
+// whenever either of them changes.
 
-      // Standard waterfall data display; run through the vector of data
-      // and color each corresponding point in the pixmap appropriately.
+void
+CPlotter::recolor()
+{
+  m_levelColors.resize(std::numeric_limits<Level>::max() + 1);
 
-      else if constexpr (std::is_same_v<T, WF::SWide>)
-      {
-        auto const end = std::min(width, static_cast<int>(v.size()));
+  m_levelColors[LEVEL_NAN] = m_palette[m_scaler1D(std::numeric_limits<float>::quiet_NaN())];
 
-        for (auto x = 0; x < end; ++x)
-        {
-          p.setPen(colors[scaler(v[x])]);
-          p.drawPoint(x, y);
-        }
-      }
-    }, v);
+  for (std::size_t level = LEVEL_NAN + 1; level < m_levelColors.size(); ++level)
+  {
+    m_levelColors[level] = m_palette[m_scaler1D(dequantise(level))];
+  }
+}
+
+// Replot the waterfall display from the waterfall history, applying the
+// current zero, gain, and color palette.
+
+void
+CPlotter::replot()
+{
+  if (m_WaterfallImage.isNull()) return;
 
-    y++;
+  // Waterfall data and the green transmit period lines go directly into
+  // the scanlines; rows for which we have no data, e.g., those we gained
+  // on being resized, are left black.
+
+  auto const height = m_WaterfallImage.height();
+
+  for (auto row = 0; row < height; ++row)
+  {
+    switch (m_rows[row])
+    {
+      case Row::Empty: fillRow(row, qRgb(0, 0, 0)); break;
+      case Row::Label: fillRow(row, PERIOD_LINE);   break;
+      case Row::Data:  drawRow(row);                break;
+    }
   }
 
-  // The waterfall pixmap should now look as it did before, but with the
+  // Text annotations need a painter, so we make a second pass for them
+  // once we're done with the scanlines. We need to consider that rows
+  // deal in device pixels, not logical pixels, so we must deal with
+  // scaling in the y dimension for this to work out; each label sits
+  // just above the period line that it annotates.
+
+  paintWaterfall([this, height](QPainter & p)
+  {
+    auto const ratio = m_WaterfallImage.devicePixelRatio();
+    auto const extra = p.fontMetrics().descent();
+
+    p.setPen(Qt::white);
+
+    for (auto row = 0; row < height; ++row)
+    {
+      if (m_rows[row] == Row::Label)
+      {
+        auto const y = (row - m_top + height) % height;
+
+        p.drawText(5, y / ratio - extra, m_labels[row]);
+      }
+    }
+  });
+
+  // The waterfall image should now look as it did before, but with the
   // current zero, gain, and color palette applied; schedule a repaint.
 
   update();
@@ -699,27 +855,68 @@ CPlotter::resize()
       return pixmap;
     };
 
+    auto const w = m_w;
+
     m_w  = size().width();
     m_h2 = m_percent2D * (size().height() - 30) / 100.0;
     m_h1 =                size().height() - m_h2;
 
-    // We want our 3 main pixmaps sized to occupy our entire height,
-    // and to be completely filled with an opaque color, since we're
-    // going to take the opaque paint even optimization path. If this
-    // is a high-DPI display, scale the pixmaps to avoid text looking
-    // pixelated.
+    // We want our 3 main pixmaps, and the waterfall image, sized to
+    // occupy our entire height, and to be completely filled with an
+    // opaque color, since we're going to take the opaque paint event
+    // optimization path. If this is a high-DPI display, scale them to
+    // avoid text looking pixelated.
 
     m_ScalePixmap     = makePixmap({m_w,   30}, Qt::white);
-    m_WaterfallPixmap = makePixmap({m_w, m_h1}, Qt::black);
     m_OverlayPixmap   = makePixmap({m_w, m_h2}, Qt::black);
+    m_WaterfallImage  = QImage(QSize(m_w, m_h1) * devicePixelRatio(), QImage::Format_RGB32);
+
+    m_WaterfallImage.setDevicePixelRatio(devicePixelRatio());
+    m_WaterfallImage.fill(Qt::black);
+
+    // Map each logical x to the device pixel columns it covers in the
+    // waterfall image.
+
+    m_columns.resize(m_w + 1);
+
+    for (auto x = 0; x <= m_w; ++x)
+    {
+      m_columns[x] = std::min(static_cast<int>(std::lround(x * devicePixelRatio())),
+                              m_WaterfallImage.width());
+    }
 
-    // The replot circular buffer should have capacity to hold the full
-    // height of the waterfall pixmap, in device, not logical, pixels.
-    // Since our variant lists std::monostate as the first alternative,
-    // if we get larger here, the added items will be constructed using
-    // std::monostate as the alternative.
+    m_columns[m_w] = m_WaterfallImage.width();
 
-    m_replot.resize(m_WaterfallPixmap.size().height());
+    // Carry the waterfall history over to the new size, in device, not
+    // logical, rows, newest first, such that the image starts out not
+    // wrapped. Rows and columns we gain are empty; we only have history
+    // for what was visible.
+
+    {
+      auto const height = static_cast<std::size_t>(m_WaterfallImage.height());
+      auto const rows   = std::min(height, m_rows.size());
+      auto const cols   = std::min(w, m_w);
+
+      std::vector<Row>     newRows  (height, Row::Empty);
+      std::vector<QString> newLabels(height);
+      std::vector<Level>   newLevels(height * m_w, LEVEL_NAN);
+
+      for (std::size_t y = 0; y < rows; ++y)
+      {
+        auto const from = (m_top + y) % m_rows.size();
+
+        newRows  [y] = m_rows[from];
+        newLabels[y] = std::move(m_labels[from]);
+
+        std::copy_n(m_levels.begin()  + from * w, cols,
+                    newLevels.begin() + y    * m_w);
+      }
+
+      m_rows   = std::move(newRows);
+      m_labels = std::move(newLabels);
+      m_levels = std::move(newLevels);
+      m_top    = 0;
+    }
 
     // Ensure the 2D scaler is working with the current spectrum height.
 
@@ -832,6 +1029,7 @@ CPlotter::setBinsPerPixel(int const binsPerPixel)
     m_binsPerPixel = std::max(1, binsPerPixel);
     m_freqPerPixel = m_binsPerPixel * FFT_BIN_WIDTH;
     m_scaler1D.rescale();
+    recolor();
     drawMetrics();
     drawFilter();
     drawDials();
@@ -845,10 +1043,32 @@ CPlotter::setColors(Colors const & colors)
   if (m_colors != colors)
   {
     m_colors = colors;
+
+    // Build the palette lookup table; any indices beyond the end of the
+    // colors provided are drawn in black.
+
+    m_palette.fill(qRgb(0, 0, 0));
+
+    std::transform(m_colors.begin(),
+                   m_colors.begin() + std::min<qsizetype>(m_colors.size(), m_palette.size()),
+                   m_palette.begin(),
+                   [](QColor const & color) { return color.rgb(); });
+
+    recolor();
     replot();
   }
 }
 
+void
+CPlotter::setDebugOverlay(bool const debugOverlay)
+{
+  if (m_debugOverlay != debugOverlay)
+  {
+    m_debugOverlay = debugOverlay;
+    update();
+  }
+}
+
 void
 CPlotter::setDialFreq(float const dialFreq)
 {
@@ -924,7 +1144,8 @@ CPlotter::setPlotGain(int const plotGain)
   if (m_scaler1D.gain() != plotGain)
   {
     m_scaler1D.setGain(plotGain);
-    m_replotTimer->start();
+    recolor();
+    replot();
   }
 }
 
@@ -934,7 +1155,8 @@ CPlotter::setPlotZero(int const plotZero)
   if (m_scaler1D.zero() != plotZero)
   {
     m_scaler1D.setZero(plotZero);
-    m_replotTimer->start();
+    recolor();
+    replot();
   }
 }
 
@@ -968,6 +1190,7 @@ CPlotter::setWaterfallAvg(int const waterfallAvg)
   {
     m_waterfallAvg = waterfallAvg;
     m_scaler1D.rescale();
+    recolor();
   }
 }
 
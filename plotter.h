@@ -11,9 +11,12 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
-#include <variant>
+#include <vector>
 #include <QColor>
+#include <QImage>
 #include <QPixmap>
 #include <QPolygonF>
 #include <QSize>
@@ -21,11 +24,12 @@
 #include <QTimer>
 #include <QVector>
 #include <QWidget>
-#include <boost/circular_buffer.hpp>
 #include "Flatten.hpp"
 #include "RDP.hpp"
 #include "WF.hpp"
 
+class QPainter;
+
 class CPlotter final : public QWidget
 {
   Q_OBJECT
@@ -128,6 +132,7 @@ public:
   // Inline accessors
 
   int      binsPerPixel() const { return m_binsPerPixel;    }
+  bool     debugOverlay() const { return m_debugOverlay;    }
   int      flatten()      const { return m_flatten.live();  }
   int      freq()         const { return m_freq;            }
   int      percent2D()    const { return m_percent2D;       }
@@ -159,6 +164,7 @@ public:
   void drawHorizontalLine(const QColor &, int, int);
   void setBinsPerPixel(int);
   void setColors(Colors const &);
+  void setDebugOverlay(bool);
   void setDialFreq(float);
   void setFilter(int, int);
   void setFilterEnabled(bool);
@@ -188,16 +194,25 @@ protected:
 
 private:
 
-  // Replot data storage; alternatives of nothing at all, a
-  // string denoting the label of a transmit period interval
-  // start, and waterfall display data, flattened. Important
-  // that the monostate alternative is first in the list.
+  // Waterfall palette, as a lookup table from the index returned by the
+  // 1D scaler to the pixel value written into the waterfall image.
+
+  using Palette = std::array<QRgb, 256>;
+
+  // Waterfall history storage. Each row of the waterfall image has a row
+  // of history behind it, so that we can recolor the waterfall when the
+  // palette, gain or zero change. Rows hold nothing at all, the label of
+  // a transmit period interval start, or waterfall display data, stored
+  // as one quantised Level per logical pixel; see quantise().
 
-  using Replot = boost::circular_buffer<std::variant<
-    std::monostate,
-    QString,
-    WF::SWide
-  >>;
+  using Level = std::uint16_t;
+
+  enum class Row : std::uint8_t
+  {
+    Empty,
+    Label,
+    Data
+  };
 
   // Accessors
 
@@ -211,6 +226,11 @@ private:
   void drawMetrics();
   void drawFilter();
   void drawDials();
+  void drawRow(int);
+  void fillRow(int, QRgb, int = 0, int = std::numeric_limits<int>::max());
+  void paintWaterfall(std::function<void(QPainter &)> const &);
+  int  nextRow();
+  void recolor();
   void replot();
   void resize();
 
@@ -231,22 +251,49 @@ private:
   int    m_w             =  0;
   int    m_h1            =  0;
   int    m_h2            =  0;
+  int    m_top           =  0;
   bool   m_filterEnabled = false;
+  bool   m_debugOverlay  = false;
   float  m_freqPerPixel;
 
   RDP       m_rdp;
   Scaler1D  m_scaler1D;
   Scaler2D  m_scaler2D;
   Colors    m_colors;
-  Replot    m_replot;
+  Palette   m_palette = {};
   QPolygonF m_points;
   Flatten   m_flatten;
   Spectrum  m_spectrum = Spectrum::Current;
-  QTimer  * m_replotTimer;
   QTimer  * m_resizeTimer;
 
+  // The waterfall is a circular buffer of device pixel rows; m_top is the
+  // row holding the newest line, with older lines following it, wrapping
+  // around from the bottom of the image to the top. m_columns maps each
+  // logical x to its first device pixel column, with one extra entry for
+  // the image width.
+
+  QImage             m_WaterfallImage;
+  std::vector<int>   m_columns;
+
+  // History for each row of the waterfall image, laid out in the same
+  // circular fashion; m_levels holds m_w levels per row. m_levelColors
+  // maps every possible level through the 1D scaler and the palette.
+
+  std::vector<Row>     m_rows;
+  std::vector<QString> m_labels;
+  std::vector<Level>   m_levels;
+  std::vector<QRgb>    m_levelColors;
+
+  // Time taken by drawData() per waterfall line, averaged over a block
+  // of lines and shown by the debug overlay.
+
+  qint64 m_frameNs      = 0;
+  qint64 m_frameMaxNs   = 0;
+  int    m_frameLines   = 0;
+  double m_frameAvgUs   = 0.0;
+  double m_framePeakUs  = 0.0;
+
   QPixmap m_ScalePixmap;
-  QPixmap m_WaterfallPixmap;
   QPixmap m_OverlayPixmap;
   QPixmap m_SpectrumPixmap;
 
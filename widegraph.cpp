@@ -173,6 +173,13 @@ WideGraph::WideGraph(QSettings * settings,
         });
       }
 
+      menu->addSeparator();
+
+      auto overlayAction = menu->addAction(QString("Show &Frame Timing"));
+      overlayAction->setCheckable(true);
+      overlayAction->setChecked(ui->widePlot->debugOverlay());
+      connect(overlayAction, &QAction::toggled, ui->widePlot, &CPlotter::setDebugOverlay);
+
       menu->popup(ui->widePlot->mapToGlobal(pos));
   });
 